@@ -0,0 +1,473 @@
+/**
+ * @file fake_bus.c
+ * @brief Host test doubles for the ssd1306 driver, see fake_bus.h.
+ */
+#include "fake_bus.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <time.h>
+#include <errno.h>
+#include <esp_timer.h>
+#include <driver/gpio.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+#define I2C_START_STOP_BITS     2       // start and stop conditions
+#define I2C_BITS_PER_BYTE       9       // 8 data bits and an acknowledge bit
+#define SPI_SETUP_US            2       // chip select and queueing per transaction
+
+int64_t fake_now_us;
+
+/**
+ * @brief Fake I2C device handle, one panel at one SCL clock.
+ */
+struct i2c_master_dev_t {
+	fake_bus_t      *bus;
+	fake_panel_t    *panel;
+	uint32_t        scl_hz;
+};
+
+/**
+ * @brief Fake SPI device handle with an in-order transaction queue.
+ */
+struct spi_device_t {
+	fake_panel_t        *panel;
+	int                 dc_io_num;
+	uint32_t            clock_hz;
+	uint32_t            *trans_count;
+	transaction_cb_t    pre_cb;
+	spi_transaction_t   *queue[FAKE_SPI_MAX_QUEUE];
+	uint8_t             head, count;
+};
+
+/**
+ * @brief FreeRTOS mutex over a pthread mutex and condition, give by a task that does not hold it fails.
+ */
+struct fake_mutex_s {
+	pthread_mutex_t lock;
+	pthread_cond_t  released;
+	TaskHandle_t    owner;
+	bool            held;
+};
+
+static struct {
+	fake_panel_t    *panel;
+	int             dc_io_num;
+	uint32_t        *trans_count;
+} fake_spi_hosts[SPI3_HOST + 1];
+
+static uint32_t fake_gpio_levels[64];
+
+int64_t esp_timer_get_time(void) {
+	return __atomic_load_n(&fake_now_us, __ATOMIC_RELAXED);
+}
+
+int64_t fake_i2c_wire_us(uint32_t scl_hz, size_t len) {
+	return ((int64_t)(I2C_START_STOP_BITS + ((1 + len) * I2C_BITS_PER_BYTE)) * 1000000) / scl_hz;
+}
+
+int64_t fake_spi_wire_us(uint32_t clock_hz, size_t len) {
+	return SPI_SETUP_US + ((int64_t)len * 8 * 1000000) / clock_hz;
+}
+
+void fake_bus_init(fake_bus_t *bus) {
+	memset(bus, 0, sizeof(*bus));
+	pthread_mutex_init(&bus->lock, NULL);
+}
+
+void fake_panel_init(fake_panel_t *panel, uint16_t address, bool gray) {
+	memset(panel, 0, sizeof(*panel));
+	panel->address = address;
+	panel->gray    = gray;
+	panel->height  = 64;
+	panel->mode    = 0x02;
+	panel->col_hi  = 127;
+	panel->page_hi = 7;
+	panel->row_hi  = 127;
+}
+
+void fake_bus_attach(fake_bus_t *bus, fake_panel_t *panel) {
+	bus->panel[bus->panel_count++] = panel;
+}
+
+void fake_spi_attach(spi_host_device_t host, fake_panel_t *panel, int dc_io_num, uint32_t *trans_count) {
+	fake_spi_hosts[host].panel       = panel;
+	fake_spi_hosts[host].dc_io_num   = dc_io_num;
+	fake_spi_hosts[host].trans_count = trans_count;
+}
+
+bool fake_panel_pixel(const fake_panel_t *panel, uint8_t x, uint8_t y) {
+	/* A1 and C8 show column 0 and page 0 at the top left of the glass */
+	uint8_t col = panel->seg_remap ? x : (uint8_t)(127 - x);
+	uint8_t row = panel->com_remap ? y : (uint8_t)(panel->height - 1 - y);
+
+	return (panel->gram[row / 8][col] >> (row % 8)) & 0x01;
+}
+
+/**
+ * @brief Parameter bytes that follow a command opcode.
+ */
+static uint8_t fake_panel_cmd_args(const fake_panel_t *panel, uint8_t cmd) {
+	if (panel->gray) {
+		switch (cmd) {
+			case 0x15: case 0x75:
+				return 2;
+			case 0x81: case 0xA0: case 0xA1: case 0xA2: case 0xA8: case 0xAB:
+			case 0xB1: case 0xB3: case 0xB6: case 0xBC: case 0xBE: case 0xD5: case 0xFD:
+				return 1;
+			default:
+				return 0;
+		}
+	}
+
+	switch (cmd) {
+		case 0x26: case 0x27:
+			return 6;
+		case 0x29: case 0x2A:
+			return 5;
+		case 0x21: case 0x22: case 0xA3:
+			return 2;
+		case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+			return 1;
+		default:
+			return 0;
+	}
+}
+
+static void fake_panel_exec(fake_panel_t *panel) {
+	const uint8_t cmd = panel->cmd;
+	const uint8_t *args = panel->args;
+
+	if (panel->gray) {
+		if (cmd == 0x15) { panel->col_lo = args[0]; panel->col_hi = args[1]; panel->col = args[0]; }
+		if (cmd == 0x75) { panel->row_lo = args[0]; panel->row_hi = args[1]; panel->row = args[0]; }
+		return;
+	}
+
+	if (cmd <= 0x0F) {
+		panel->col = (uint8_t)((panel->col & 0xF0) | cmd);
+	} else if (cmd <= 0x1F) {
+		panel->col = (uint8_t)((panel->col & 0x0F) | ((cmd & 0x0F) << 4));
+	} else if (cmd >= 0xB0 && cmd <= 0xB7) {
+		panel->page = cmd & 0x07;
+	} else if (cmd == 0x20) {
+		panel->mode = args[0] & 0x03;
+	} else if (cmd == 0x21) {
+		panel->col_lo = args[0]; panel->col_hi = args[1]; panel->col = args[0];
+	} else if (cmd == 0x22) {
+		panel->page_lo = args[0]; panel->page_hi = args[1]; panel->page = args[0];
+	} else if (cmd == 0xA0 || cmd == 0xA1) {
+		panel->seg_remap = (cmd == 0xA1);
+	} else if (cmd == 0xC0 || cmd == 0xC8) {
+		panel->com_remap = (cmd == 0xC8);
+	} else if (cmd == 0xA8) {
+		panel->height = (uint8_t)(args[0] + 1);
+	}
+}
+
+static void fake_panel_command(fake_panel_t *panel, uint8_t byte) {
+	if (panel->need) {
+		panel->args[panel->nargs++] = byte;
+		if (--panel->need == 0) fake_panel_exec(panel);
+		return;
+	}
+
+	panel->cmd   = byte;
+	panel->nargs = 0;
+	panel->need  = fake_panel_cmd_args(panel, byte);
+	if (panel->need == 0) fake_panel_exec(panel);
+}
+
+static void fake_panel_data(fake_panel_t *panel, uint8_t byte) {
+	if (panel->gray) {
+		panel->gray_ram[panel->row & 0x7F][panel->col & 0x3F] = byte;
+		if (++panel->col > panel->col_hi) {
+			panel->col = panel->col_lo;
+			if (++panel->row > panel->row_hi) panel->row = panel->row_lo;
+		}
+		return;
+	}
+
+	if (panel->col < 128) panel->gram[panel->page & 0x0F][panel->col] = byte;
+
+	if (panel->mode == 0x02) {
+		panel->col++;
+		return;
+	}
+
+	if (++panel->col > panel->col_hi) {
+		panel->col = panel->col_lo;
+		if (++panel->page > panel->page_hi) panel->page = panel->page_lo;
+	}
+}
+
+/**
+ * @brief Decodes an I2C write, each control byte selects commands or data and whether one byte or the rest follows.
+ */
+static void fake_panel_write(fake_panel_t *panel, const uint8_t *buffer, size_t size) {
+	size_t i = 0;
+
+	while (i < size) {
+		const uint8_t control = buffer[i++];
+		const bool data = control & 0x40;
+		const size_t len = (control & 0x80) ? 1 : size - i;
+
+		for (size_t n = 0; n < len && i < size; n++) {
+			if (data) fake_panel_data(panel, buffer[i++]);
+			else fake_panel_command(panel, buffer[i++]);
+		}
+	}
+}
+
+esp_err_t i2c_master_probe(i2c_master_bus_handle_t bus_handle, uint16_t address, int xfer_timeout_ms) {
+	(void)xfer_timeout_ms;
+
+	for (uint8_t i = 0; i < bus_handle->panel_count; i++) {
+		if (bus_handle->panel[i]->address == address) return ESP_OK;
+	}
+
+	return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t bus_handle, const i2c_device_config_t *dev_config, i2c_master_dev_handle_t *ret_handle) {
+	if (bus_handle->add_fail_any) return ESP_FAIL;
+	if (bus_handle->add_fail_hz && dev_config->scl_speed_hz == bus_handle->add_fail_hz) return ESP_FAIL;
+
+	for (uint8_t i = 0; i < bus_handle->panel_count; i++) {
+		if (bus_handle->panel[i]->address != dev_config->device_address) continue;
+
+		i2c_master_dev_handle_t dev = calloc(1, sizeof(*dev));
+		if (dev == NULL) return ESP_ERR_NO_MEM;
+		dev->bus    = bus_handle;
+		dev->panel  = bus_handle->panel[i];
+		dev->scl_hz = dev_config->scl_speed_hz;
+		bus_handle->adds++;
+		*ret_handle = dev;
+		return ESP_OK;
+	}
+
+	return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t handle) {
+	if (handle == NULL) return ESP_ERR_INVALID_ARG;
+
+	handle->bus->removes++;
+	free(handle);
+
+	return ESP_OK;
+}
+
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t i2c_dev, const uint8_t *write_buffer, size_t write_size, int xfer_timeout_ms) {
+	(void)xfer_timeout_ms;
+
+	if (i2c_dev == NULL || write_buffer == NULL || write_size == 0) return ESP_ERR_INVALID_ARG;
+
+	fake_bus_t *bus = i2c_dev->bus;
+	fake_panel_t *panel = i2c_dev->panel;
+	bool ok = true;
+
+	pthread_mutex_lock(&bus->lock);
+
+	if (panel->fail_next > 0) {
+		panel->fail_next--;
+		ok = false;
+	} else if (panel->max_scl_hz && i2c_dev->scl_hz > panel->max_scl_hz) {
+		ok = false;
+	} else if (panel->nack && panel->nack(panel, i2c_dev->scl_hz)) {
+		ok = false;
+	}
+
+	/* a refused address byte ends the transaction */
+	int64_t wire_us = fake_i2c_wire_us(i2c_dev->scl_hz, ok ? write_size : 0);
+	__atomic_fetch_add(&fake_now_us, wire_us, __ATOMIC_RELAXED);
+	bus->busy_us += wire_us;
+
+	if (bus->log_count < FAKE_BUS_LOG_SIZE) {
+		bus->log[bus->log_count].address = panel->address;
+		bus->log[bus->log_count].len     = (uint16_t)write_size;
+		bus->log[bus->log_count].ok      = ok;
+	}
+	bus->log_count++;
+
+	if (ok) {
+		fake_panel_write(panel, write_buffer, write_size);
+		panel->xfers++;
+		panel->bytes += write_size;
+	} else {
+		panel->failures++;
+	}
+
+	pthread_mutex_unlock(&bus->lock);
+
+	return ok ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host_id, const spi_device_interface_config_t *dev_config, spi_device_handle_t *handle) {
+	if (fake_spi_hosts[host_id].panel == NULL) return ESP_ERR_INVALID_STATE;
+
+	spi_device_handle_t dev = calloc(1, sizeof(*dev));
+	if (dev == NULL) return ESP_ERR_NO_MEM;
+	dev->panel       = fake_spi_hosts[host_id].panel;
+	dev->dc_io_num   = fake_spi_hosts[host_id].dc_io_num;
+	dev->trans_count = fake_spi_hosts[host_id].trans_count;
+	dev->clock_hz    = (uint32_t)dev_config->clock_speed_hz;
+	dev->pre_cb      = dev_config->pre_cb;
+	*handle = dev;
+
+	return ESP_OK;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle) {
+	free(handle);
+
+	return ESP_OK;
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans_desc, uint32_t ticks_to_wait) {
+	(void)ticks_to_wait;
+
+	if (handle->count >= FAKE_SPI_MAX_QUEUE) return ESP_ERR_TIMEOUT;
+
+	/* the pre-transfer callback drives d/c before the first clock edge */
+	if (handle->pre_cb) handle->pre_cb(trans_desc);
+
+	const bool data = fake_gpio_levels[handle->dc_io_num] != 0;
+	const uint8_t *bytes = trans_desc->tx_buffer;
+	const size_t len = trans_desc->length / 8;
+
+	for (size_t i = 0; i < len; i++) {
+		if (data) fake_panel_data(handle->panel, bytes[i]);
+		else fake_panel_command(handle->panel, bytes[i]);
+	}
+	handle->panel->xfers++;
+	handle->panel->bytes += len;
+	if (handle->trans_count) (*handle->trans_count)++;
+	__atomic_fetch_add(&fake_now_us, fake_spi_wire_us(handle->clock_hz, len), __ATOMIC_RELAXED);
+
+	handle->queue[(handle->head + handle->count++) % FAKE_SPI_MAX_QUEUE] = trans_desc;
+
+	return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans_desc, uint32_t ticks_to_wait) {
+	(void)ticks_to_wait;
+
+	if (handle->count == 0) return ESP_ERR_TIMEOUT;
+
+	*trans_desc = handle->queue[handle->head];
+	handle->head = (handle->head + 1) % FAKE_SPI_MAX_QUEUE;
+	handle->count--;
+
+	return ESP_OK;
+}
+
+esp_err_t gpio_config(const gpio_config_t *config) {
+	(void)config;
+
+	return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level) {
+	if (gpio_num < 0 || gpio_num >= 64) return ESP_ERR_INVALID_ARG;
+
+	fake_gpio_levels[gpio_num] = level;
+
+	return ESP_OK;
+}
+
+void vTaskDelay(const TickType_t ticks_to_delay) {
+	(void)ticks_to_delay;
+
+	sched_yield();
+}
+
+/* every thread is a task, its handle is the address of a thread local */
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+	static __thread char task;
+
+	return (TaskHandle_t)&task;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+	SemaphoreHandle_t mutex = calloc(1, sizeof(*mutex));
+	if (mutex == NULL) return NULL;
+
+	pthread_mutex_init(&mutex->lock, NULL);
+	pthread_cond_init(&mutex->released, NULL);
+
+	return mutex;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks_to_wait) {
+	struct timespec deadline;
+	BaseType_t taken = pdTRUE;
+
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_sec  += ticks_to_wait / 1000;
+	deadline.tv_nsec += (long)(ticks_to_wait % 1000) * 1000000L;
+	if (deadline.tv_nsec >= 1000000000L) {
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000L;
+	}
+
+	pthread_mutex_lock(&semaphore->lock);
+	while (semaphore->held) {
+		if (ticks_to_wait == 0) {
+			taken = pdFALSE;
+			break;
+		}
+		if (ticks_to_wait == portMAX_DELAY) {
+			pthread_cond_wait(&semaphore->released, &semaphore->lock);
+		} else if (pthread_cond_timedwait(&semaphore->released, &semaphore->lock, &deadline) == ETIMEDOUT) {
+			taken = semaphore->held ? pdFALSE : pdTRUE;
+			break;
+		}
+	}
+	if (taken == pdTRUE) {
+		semaphore->held  = true;
+		semaphore->owner = xTaskGetCurrentTaskHandle();
+	}
+	pthread_mutex_unlock(&semaphore->lock);
+
+	return taken;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+	BaseType_t given = pdFALSE;
+
+	pthread_mutex_lock(&semaphore->lock);
+	if (semaphore->held) {
+		/* FreeRTOS reaches configASSERT(pxTCB == pxCurrentTCB) in xTaskPriorityDisinherit */
+		if (semaphore->owner != xTaskGetCurrentTaskHandle()) {
+			fprintf(stderr, "xSemaphoreGive: mutex held by another task\n");
+			abort();
+		}
+		semaphore->held = false;
+		pthread_cond_signal(&semaphore->released);
+		given = pdTRUE;
+	}
+	pthread_mutex_unlock(&semaphore->lock);
+
+	return given;
+}
+
+TaskHandle_t xSemaphoreGetMutexHolder(SemaphoreHandle_t semaphore) {
+	TaskHandle_t holder;
+
+	pthread_mutex_lock(&semaphore->lock);
+	holder = semaphore->held ? semaphore->owner : NULL;
+	pthread_mutex_unlock(&semaphore->lock);
+
+	return holder;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+	pthread_cond_destroy(&semaphore->released);
+	pthread_mutex_destroy(&semaphore->lock);
+	free(semaphore);
+}
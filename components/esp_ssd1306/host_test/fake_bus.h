@@ -0,0 +1,118 @@
+/**
+ * @file fake_bus.h
+ * @brief Host test doubles for the ssd1306 driver: an I2C bus and SPI hosts with a wire-time model,
+ * error injection, and panels that decode the command stream into display RAM.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <driver/i2c_master.h>
+#include <driver/spi_master.h>
+
+#define FAKE_BUS_MAX_PANELS     4       //!< panels attached to one fake i2c bus
+#define FAKE_BUS_LOG_SIZE       4096    //!< transactions kept in the bus log
+#define FAKE_SPI_MAX_QUEUE      8       //!< queued transactions per fake spi device
+
+typedef struct fake_panel_s fake_panel_t;
+
+/**
+ * @brief Decides whether a transaction is not acknowledged, used for scripted error injection.
+ *
+ * @param panel Panel addressed by the transaction.
+ * @param scl_hz SCL clock of the device handle.
+ * @return bool True to fail the transaction.
+ */
+typedef bool (*fake_nack_fn_t)(fake_panel_t *panel, uint32_t scl_hz);
+
+/**
+ * @brief Emulated SSD1306 or SSD1327 controller, display RAM follows the decoded command stream.
+ */
+struct fake_panel_s {
+	uint16_t        address;            /*!< i2c address the panel answers on */
+	bool            gray;               /*!< ssd1327 window addressing and 4-bit ram when true */
+	uint8_t         gram[16][128];      /*!< ssd1306 ram by page and column */
+	uint8_t         gray_ram[128][64];  /*!< ssd1327 ram by row and column pair */
+	bool            seg_remap;          /*!< ssd1306 column 127 drives SEG0 (A1) when true */
+	bool            com_remap;          /*!< ssd1306 COM scan runs from COM[N-1] (C8) when true */
+	uint8_t         height;             /*!< rows driven, from the multiplex ratio */
+	/* error injection */
+	uint32_t        max_scl_hz;         /*!< faster transactions are not acknowledged, 0 for no limit */
+	int             fail_next;          /*!< transactions left to fail */
+	fake_nack_fn_t  nack;               /*!< scripted failures, NULL for none */
+	/* counters */
+	uint32_t        xfers;              /*!< acknowledged transactions */
+	uint32_t        failures;           /*!< failed transactions */
+	size_t          bytes;              /*!< acknowledged bytes including control bytes */
+	/* decoder state */
+	uint8_t         mode;               /*!< ssd1306 memory addressing mode */
+	uint8_t         col, col_lo, col_hi;
+	uint8_t         page, page_lo, page_hi;
+	uint8_t         row, row_lo, row_hi;
+	uint8_t         cmd, args[8], nargs, need;
+};
+
+/**
+ * @brief One acknowledged or failed transaction in the bus log.
+ */
+typedef struct fake_xfer_s {
+	uint16_t        address;            /*!< panel address */
+	uint16_t        len;                /*!< bytes including the control byte */
+	bool            ok;                 /*!< acknowledged when true */
+} fake_xfer_t;
+
+/**
+ * @brief Fake I2C master bus, devices added with `i2c_master_bus_add_device` address its panels.
+ */
+struct i2c_master_bus_t {
+	fake_panel_t    *panel[FAKE_BUS_MAX_PANELS];
+	uint8_t         panel_count;
+	uint32_t        add_fail_hz;        /*!< adding a device at this SCL clock fails, 0 for none */
+	bool            add_fail_any;       /*!< adding a device at any SCL clock fails when true */
+	uint32_t        adds;               /*!< devices added */
+	uint32_t        removes;            /*!< devices removed */
+	int64_t         busy_us;            /*!< wire time of every transaction */
+	fake_xfer_t     log[FAKE_BUS_LOG_SIZE];
+	uint32_t        log_count;
+	pthread_mutex_t lock;
+};
+typedef struct i2c_master_bus_t fake_bus_t;
+
+/**
+ * @brief Virtual clock in microseconds, advanced by the wire time of every transaction.
+ */
+extern int64_t fake_now_us;
+
+/**
+ * @brief Wire time of an I2C write, start, address byte, payload bytes with acknowledge bits and stop.
+ *
+ * @param scl_hz SCL clock in Hz.
+ * @param len Payload bytes.
+ * @return int64_t Wire time in microseconds.
+ */
+int64_t fake_i2c_wire_us(uint32_t scl_hz, size_t len);
+
+/**
+ * @brief Wire time of an SPI write, payload bits plus a fixed transaction setup time.
+ *
+ * @param clock_hz SCLK clock in Hz.
+ * @param len Payload bytes.
+ * @return int64_t Wire time in microseconds.
+ */
+int64_t fake_spi_wire_us(uint32_t clock_hz, size_t len);
+
+void fake_bus_init(fake_bus_t *bus);
+void fake_panel_init(fake_panel_t *panel, uint16_t address, bool gray);
+void fake_bus_attach(fake_bus_t *bus, fake_panel_t *panel);
+
+/**
+ * @brief Attaches a panel to an SPI host, its D/C line is read from the fake gpio level of `dc_io_num`.
+ */
+void fake_spi_attach(spi_host_device_t host, fake_panel_t *panel, int dc_io_num, uint32_t *trans_count);
+
+/**
+ * @brief Pixel as seen on the glass of an ssd1306 panel, after segment and COM re-map.
+ */
+bool fake_panel_pixel(const fake_panel_t *panel, uint8_t x, uint8_t y);
@@ -0,0 +1,26 @@
+/**
+ * @file host_test.h
+ * @brief Minimal check macros for the ssd1306 host tests, a failed check is reported and counted.
+ */
+#pragma once
+
+#include <stdio.h>
+
+static int host_test_failures;
+
+#define CHECK(cond) do {                                                        \
+        if (!(cond)) {                                                          \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            host_test_failures++;                                               \
+        }                                                                       \
+    } while (0)
+
+#define CHECK_OK(expr) do {                                                     \
+        int check_ret_ = (int)(expr);                                           \
+        if (check_ret_ != 0) {                                                  \
+            fprintf(stderr, "%s:%d: CHECK_OK failed: %s returned 0x%x\n", __FILE__, __LINE__, #expr, check_ret_); \
+            host_test_failures++;                                               \
+        }                                                                       \
+    } while (0)
+
+#define HOST_TEST_RESULT(name) (printf("%s: %s\n", (name), host_test_failures ? "FAIL" : "PASS"), host_test_failures ? 1 : 0)
@@ -0,0 +1,4 @@
+/* host test stub, code placement attributes are ignored */
+#pragma once
+
+#define IRAM_ATTR
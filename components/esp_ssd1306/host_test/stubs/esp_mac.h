@@ -0,0 +1,2 @@
+/* host test stub, no MAC address functions are used */
+#pragma once
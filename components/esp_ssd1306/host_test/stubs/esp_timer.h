@@ -0,0 +1,6 @@
+/* host test stub, time comes from the fake bus virtual clock */
+#pragma once
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void);
@@ -0,0 +1,13 @@
+/* host test stub of FreeRTOS mutexes, implemented by fake_bus.c over pthreads */
+#pragma once
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+typedef struct fake_mutex_s *SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks_to_wait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+TaskHandle_t xSemaphoreGetMutexHolder(SemaphoreHandle_t semaphore);
+void vSemaphoreDelete(SemaphoreHandle_t semaphore);
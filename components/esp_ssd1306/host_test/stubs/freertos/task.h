@@ -0,0 +1,9 @@
+/* host test stub of the FreeRTOS task functions, implemented by fake_bus.c */
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef struct fake_task_s *TaskHandle_t;
+
+void vTaskDelay(const TickType_t ticks_to_delay);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
@@ -0,0 +1,2 @@
+/* host test stub, Kconfig options keep their defaults unless set on the compiler command line */
+#pragma once
@@ -0,0 +1,170 @@
+/**
+ * @file test_clock.c
+ * @brief I2C clock negotiation, fallback and transaction retries against a bus that refuses
+ * transactions above a clock, fails device adds, or fails scripted transactions.
+ */
+#include <string.h>
+#include <ssd1306.h>
+#include "fake_bus.h"
+#include "host_test.h"
+
+static int g_slow_failures;
+
+static bool panel_matches(ssd1306_handle_t handle, const fake_panel_t *panel) {
+	static uint8_t pages[8 * 128];
+
+	ssd1306_get_pages(handle, pages);
+
+	return memcmp(pages, panel->gram, sizeof(pages)) == 0;
+}
+
+static uint32_t clock_speed(ssd1306_handle_t handle) {
+	uint32_t speed = 0;
+
+	CHECK_OK(ssd1306_get_i2c_clock_speed(handle, &speed));
+
+	return speed;
+}
+
+/* fast mode plus is never acknowledged, fast mode fails its first transactions */
+static bool nack_fast_plus_then_fast(fake_panel_t *panel, uint32_t scl_hz) {
+	(void)panel;
+
+	if (scl_hz > I2C_SSD1306_DEV_CLK_SPD_FAST) return true;
+	if (scl_hz == I2C_SSD1306_DEV_CLK_SPD_FAST && g_slow_failures > 0) {
+		g_slow_failures--;
+		return true;
+	}
+
+	return false;
+}
+
+static ssd1306_handle_t init_panel(fake_bus_t *bus, fake_panel_t *panel, uint16_t address, bool negotiate) {
+	ssd1306_handle_t handle = NULL;
+	ssd1306_config_t cfg = I2C_SSD1306_128x64_CONFIG_DEFAULT;
+
+	cfg.i2c_address = address;
+	cfg.clock_negotiation_enabled = negotiate;
+	fake_bus_attach(bus, panel);
+	CHECK_OK(ssd1306_init(bus, &cfg, &handle));
+
+	return handle;
+}
+
+int main(void) {
+	fake_bus_t bus;
+	fake_panel_t panel[5];
+	ssd1306_handle_t handle;
+
+	fake_bus_init(&bus);
+
+	/* negotiation settles on the fastest acknowledged clock and restores the verify pattern */
+	fake_panel_init(&panel[0], 0x3C, false);
+	panel[0].max_scl_hz = I2C_SSD1306_DEV_CLK_SPD_FAST;
+	handle = init_panel(&bus, &panel[0], 0x3C, true);
+	CHECK(handle != NULL);
+	CHECK(clock_speed(handle) == I2C_SSD1306_DEV_CLK_SPD_FAST);
+	CHECK(panel[0].failures == 1);
+	CHECK(panel_matches(handle, &panel[0]));
+
+	/* errors rising at runtime step the clock down, the failed write goes out at the slower clock */
+	panel[0].max_scl_hz = I2C_SSD1306_DEV_CLK_SPD;
+	uint32_t failures = panel[0].failures;
+	CHECK_OK(ssd1306_set_text(handle, 2, "fallback", false));
+	CHECK_OK(ssd1306_flush(handle));
+	CHECK(panel[0].failures - failures == I2C_CLK_FALLBACK_ERRORS);
+	CHECK(clock_speed(handle) == I2C_SSD1306_DEV_CLK_SPD);
+	CHECK(handle->i2c_clock_fallbacks == 1);
+	CHECK(handle->dirty_pages == 0);
+	CHECK(panel_matches(handle, &panel[0]));
+	CHECK_OK(ssd1306_delete(handle));
+
+	/* a clock the bus can not add a device at ends negotiation at the previous clock */
+	fake_panel_init(&panel[1], 0x3D, false);
+	bus.add_fail_hz = I2C_SSD1306_DEV_CLK_SPD_FAST_PLUS;
+	handle = init_panel(&bus, &panel[1], 0x3D, true);
+	CHECK(handle != NULL && handle->i2c_handle != NULL);
+	CHECK(clock_speed(handle) == I2C_SSD1306_DEV_CLK_SPD_FAST);
+	CHECK_OK(ssd1306_set_text(handle, 0, "re-added", false));
+	CHECK_OK(ssd1306_flush(handle));
+	CHECK(panel_matches(handle, &panel[1]));
+	bus.add_fail_hz = 0;
+
+	/* a failed add during fallback keeps the device on the bus at its old clock */
+	panel[1].max_scl_hz = I2C_SSD1306_DEV_CLK_SPD;
+	bus.add_fail_hz = I2C_SSD1306_DEV_CLK_SPD;
+	CHECK_OK(ssd1306_set_text(handle, 4, "add fails", false));
+	CHECK(ssd1306_flush(handle) != ESP_OK);
+	CHECK(handle->i2c_handle != NULL);
+	CHECK(clock_speed(handle) == I2C_SSD1306_DEV_CLK_SPD_FAST);
+	CHECK(handle->dirty_pages == (1U << 4));
+
+	/* the failed change starts a fresh error window, a clean write does not retry it */
+	uint32_t adds = bus.adds;
+	panel[1].max_scl_hz = I2C_SSD1306_DEV_CLK_SPD_FAST;
+	CHECK_OK(ssd1306_flush(handle));
+	CHECK(bus.adds == adds);
+	CHECK(clock_speed(handle) == I2C_SSD1306_DEV_CLK_SPD_FAST);
+	panel[1].max_scl_hz = I2C_SSD1306_DEV_CLK_SPD;
+	CHECK_OK(ssd1306_set_text(handle, 4, "add fails", true));
+	bus.add_fail_hz = 0;
+	CHECK_OK(ssd1306_flush(handle));
+	CHECK(clock_speed(handle) == I2C_SSD1306_DEV_CLK_SPD);
+	CHECK(handle->dirty_pages == 0);
+	CHECK(panel_matches(handle, &panel[1]));
+	CHECK_OK(ssd1306_delete(handle));
+
+	/* after a fallback the write gets a fresh set of retries at the slower clock */
+	fake_panel_init(&panel[2], 0x3E, false);
+	handle = init_panel(&bus, &panel[2], 0x3E, true);
+	CHECK(clock_speed(handle) == I2C_SSD1306_DEV_CLK_SPD_FAST_PLUS);
+	panel[2].nack = nack_fast_plus_then_fast;
+	g_slow_failures = I2C_XFR_RETRIES;
+	CHECK_OK(ssd1306_set_text(handle, 1, "fresh retries", false));
+	CHECK_OK(ssd1306_flush(handle));
+	CHECK(g_slow_failures == 0);
+	CHECK(clock_speed(handle) == I2C_SSD1306_DEV_CLK_SPD_FAST);
+	CHECK(panel_matches(handle, &panel[2]));
+
+	/* a fallback that can not re-add the device at either clock stops writing to the missing device */
+	panel[2].nack = NULL;
+	panel[2].max_scl_hz = I2C_SSD1306_DEV_CLK_SPD / 2;
+	bus.add_fail_any = true;
+	uint32_t log_count = bus.log_count;
+	CHECK_OK(ssd1306_set_text(handle, 5, "off the bus", false));
+	CHECK(ssd1306_flush(handle) == ESP_ERR_INVALID_STATE);
+	CHECK(handle->i2c_handle == NULL);
+	CHECK(bus.log_count - log_count <= I2C_CLK_FALLBACK_ERRORS);
+	log_count = bus.log_count;
+	CHECK(ssd1306_flush(handle) == ESP_ERR_INVALID_STATE);
+	CHECK(bus.log_count == log_count);
+	bus.add_fail_any = false;
+	CHECK_OK(ssd1306_delete(handle));
+
+	/* without negotiation a write is tried once and repeated `I2C_XFR_RETRIES` times */
+	fake_panel_init(&panel[3], 0x3F, false);
+	handle = init_panel(&bus, &panel[3], 0x3F, false);
+	log_count = bus.log_count;
+	panel[3].fail_next = I2C_XFR_RETRIES;
+	CHECK_OK(ssd1306_set_text(handle, 5, "retried", false));
+	CHECK_OK(ssd1306_flush(handle));
+	CHECK(bus.log_count - log_count == 1 + I2C_XFR_RETRIES);
+	CHECK(panel_matches(handle, &panel[3]));
+
+	/* a write failing every attempt keeps its pages dirty for the next flush */
+	log_count = bus.log_count;
+	panel[3].fail_next = 1 + I2C_XFR_RETRIES;
+	CHECK_OK(ssd1306_set_text(handle, 6, "lost once", true));
+	CHECK(ssd1306_flush(handle) != ESP_OK);
+	CHECK(bus.log_count - log_count == 1 + I2C_XFR_RETRIES);
+	CHECK(handle->dirty_pages == (1U << 6));
+	CHECK_OK(ssd1306_flush(handle));
+	CHECK(handle->dirty_pages == 0);
+	CHECK(clock_speed(handle) == I2C_SSD1306_DEV_CLK_SPD);
+	CHECK(panel_matches(handle, &panel[3]));
+	CHECK_OK(ssd1306_delete(handle));
+
+	CHECK(bus.adds == bus.removes);
+
+	return HOST_TEST_RESULT("clock");
+}
@@ -0,0 +1,87 @@
+/**
+ * @file test_flip.c
+ * @brief A flipped panel shows the same glass image whether the flip uses segment re-map and COM scan
+ * direction or reverses page data in software with `remap_disabled`, full frames and partial updates alike.
+ */
+#include <string.h>
+#include <ssd1306.h>
+#include "fake_bus.h"
+#include "host_test.h"
+
+#define WIDTH   128
+#define HEIGHT  64
+
+enum { PANEL_UPRIGHT, PANEL_HW_FLIP, PANEL_SW_FLIP, PANEL_COUNT };
+
+static void draw(ssd1306_handle_t handle) {
+	CHECK_OK(ssd1306_set_text(handle, 0, "flip", false));
+	CHECK_OK(ssd1306_set_text(handle, 5, "corner", true));
+	CHECK_OK(ssd1306_set_line(handle, 0, 63, 90, 10, false));
+	CHECK_OK(ssd1306_set_pixel(handle, 127, 0, false));
+}
+
+static void update(ssd1306_handle_t handle) {
+	CHECK_OK(ssd1306_set_text(handle, 3, "part", false));
+	CHECK_OK(ssd1306_set_pixel(handle, 2, 62, false));
+}
+
+/**
+ * @brief Both flipped panels show the upright image rotated by 180 degrees.
+ */
+static bool glass_matches(const fake_panel_t *panel) {
+	int lit = 0;
+
+	for (uint8_t y = 0; y < HEIGHT; y++) {
+		for (uint8_t x = 0; x < WIDTH; x++) {
+			bool upright = fake_panel_pixel(&panel[PANEL_UPRIGHT], WIDTH - 1 - x, HEIGHT - 1 - y);
+			lit += upright;
+			if (fake_panel_pixel(&panel[PANEL_HW_FLIP], x, y) != upright) return false;
+			if (fake_panel_pixel(&panel[PANEL_SW_FLIP], x, y) != upright) return false;
+		}
+	}
+
+	return lit > 0;
+}
+
+int main(void) {
+	fake_bus_t bus;
+	fake_panel_t panel[PANEL_COUNT];
+	ssd1306_handle_t handle[PANEL_COUNT];
+
+	fake_bus_init(&bus);
+
+	for (int i = 0; i < PANEL_COUNT; i++) {
+		ssd1306_config_t cfg = I2C_SSD1306_128x64_CONFIG_DEFAULT;
+		cfg.i2c_address = (uint16_t)(I2C_SSD1306_DEV_ADDR + i);
+		cfg.flip_enabled = (i != PANEL_UPRIGHT);
+		cfg.remap_disabled = (i == PANEL_SW_FLIP);
+		fake_panel_init(&panel[i], cfg.i2c_address, false);
+		fake_bus_attach(&bus, &panel[i]);
+		CHECK_OK(ssd1306_init(&bus, &cfg, &handle[i]));
+	}
+
+	/* the hardware flip changes the scan direction, the software flip keeps the upright one */
+	CHECK(handle[PANEL_HW_FLIP]->hw_flip && !handle[PANEL_SW_FLIP]->hw_flip);
+	CHECK(!panel[PANEL_HW_FLIP].seg_remap && !panel[PANEL_HW_FLIP].com_remap);
+	CHECK(panel[PANEL_SW_FLIP].seg_remap && panel[PANEL_SW_FLIP].com_remap);
+	CHECK(panel[PANEL_UPRIGHT].seg_remap && panel[PANEL_UPRIGHT].com_remap);
+
+	for (int i = 0; i < PANEL_COUNT; i++) {
+		draw(handle[i]);
+		CHECK_OK(ssd1306_display_pages(handle[i]));
+	}
+	CHECK(glass_matches(panel));
+
+	for (int i = 0; i < PANEL_COUNT; i++) {
+		update(handle[i]);
+		CHECK_OK(ssd1306_flush(handle[i]));
+		CHECK(handle[i]->dirty_pages == 0);
+	}
+	CHECK(glass_matches(panel));
+
+	for (int i = 0; i < PANEL_COUNT; i++) {
+		CHECK_OK(ssd1306_delete(handle[i]));
+	}
+
+	return HOST_TEST_RESULT("flip");
+}
@@ -0,0 +1,140 @@
+/**
+ * @file test_frame_lock.c
+ * @brief Tasks hammering one shared handle through `ssd1306_begin_frame` and `ssd1306_end_frame`,
+ * with a scheduler flushing concurrently, never interleave their frames.
+ */
+#include <string.h>
+#include <pthread.h>
+#include <freertos/task.h>
+#include <ssd1306.h>
+#include "fake_bus.h"
+#include "host_test.h"
+
+#define HAMMER_TASKS    4
+#define HAMMER_FRAMES   300
+
+static ssd1306_handle_t g_handle;
+static fake_panel_t g_panel;
+static int g_in_frame;
+static int g_overlaps;
+static int g_torn_frames;
+static volatile bool g_hammer_done;
+
+static void *hammer_task(void *arg) {
+	const int id = (int)(intptr_t)arg;
+	static __thread uint8_t drawn[8 * 128];
+	static __thread uint8_t sent[8 * 128];
+	char line[17];
+
+	for (int frame = 0; frame < HAMMER_FRAMES; frame++) {
+		if (ssd1306_begin_frame(g_handle, 1000) != ESP_OK) {
+			__atomic_fetch_add(&g_torn_frames, 1, __ATOMIC_RELAXED);
+			continue;
+		}
+		if (__atomic_fetch_add(&g_in_frame, 1, __ATOMIC_ACQ_REL) != 0) {
+			__atomic_fetch_add(&g_overlaps, 1, __ATOMIC_RELAXED);
+		}
+
+		for (uint8_t page = 0; page < 8; page++) {
+			snprintf(line, sizeof(line), "T%d F%03d P%d", id, frame, page);
+			ssd1306_set_text(g_handle, page, line, (id + page) & 0x01);
+			/* give the other tasks a chance to break in */
+			vTaskDelay(0);
+		}
+		ssd1306_get_pages(g_handle, drawn);
+		ssd1306_flush(g_handle);
+		ssd1306_get_pages(g_handle, sent);
+
+		/* the frame drawn is the frame on the glass, no other task touched it */
+		if (memcmp(drawn, sent, sizeof(drawn)) != 0 || memcmp(sent, g_panel.gram, sizeof(sent)) != 0) {
+			__atomic_fetch_add(&g_torn_frames, 1, __ATOMIC_RELAXED);
+		}
+
+		__atomic_fetch_sub(&g_in_frame, 1, __ATOMIC_ACQ_REL);
+		ssd1306_end_frame(g_handle);
+	}
+
+	return NULL;
+}
+
+static void *scheduler_task(void *arg) {
+	ssd1306_scheduler_t *scheduler = arg;
+
+	while (!g_hammer_done) {
+		ssd1306_scheduler_flush(scheduler);
+		vTaskDelay(0);
+	}
+
+	return NULL;
+}
+
+static void *contender_task(void *arg) {
+	esp_err_t *results = arg;
+
+	results[0] = ssd1306_begin_frame(g_handle, 20);
+	results[1] = ssd1306_end_frame(g_handle);
+
+	return NULL;
+}
+
+int main(void) {
+	fake_bus_t bus;
+	ssd1306_scheduler_t scheduler;
+	pthread_t tasks[HAMMER_TASKS];
+	pthread_t flusher;
+
+	fake_bus_init(&bus);
+	fake_panel_init(&g_panel, I2C_SSD1306_DEV_ADDR, false);
+	fake_bus_attach(&bus, &g_panel);
+
+	ssd1306_config_t cfg = I2C_SSD1306_128x64_CONFIG_DEFAULT;
+	cfg.frame_lock_enabled = true;
+	CHECK_OK(ssd1306_init(&bus, &cfg, &g_handle));
+
+	CHECK_OK(ssd1306_scheduler_init(&scheduler));
+	CHECK_OK(ssd1306_scheduler_add_panel(&scheduler, g_handle));
+
+	CHECK(pthread_create(&flusher, NULL, scheduler_task, &scheduler) == 0);
+	for (int i = 0; i < HAMMER_TASKS; i++) {
+		CHECK(pthread_create(&tasks[i], NULL, hammer_task, (void *)(intptr_t)i) == 0);
+	}
+	for (int i = 0; i < HAMMER_TASKS; i++) {
+		pthread_join(tasks[i], NULL);
+	}
+	g_hammer_done = true;
+	pthread_join(flusher, NULL);
+
+	printf("%d tasks x %d frames: %d overlapping frames, %d torn frames, %u transactions\n",
+		   HAMMER_TASKS, HAMMER_FRAMES, g_overlaps, g_torn_frames, (unsigned)g_panel.xfers);
+	CHECK(g_overlaps == 0);
+	CHECK(g_torn_frames == 0);
+
+	/* a held frame times out other tasks, and only the holder can end it; the fake mutex aborts like
+	 * configASSERT when a task gives a mutex held by another task, so end_frame must check the holder */
+	esp_err_t results[2];
+	pthread_t contender;
+	CHECK_OK(ssd1306_begin_frame(g_handle, 0));
+	CHECK(pthread_create(&contender, NULL, contender_task, results) == 0);
+	pthread_join(contender, NULL);
+	CHECK(results[0] == ESP_ERR_TIMEOUT);
+	CHECK(results[1] == ESP_ERR_INVALID_STATE);
+	CHECK_OK(ssd1306_end_frame(g_handle));
+	CHECK(ssd1306_end_frame(g_handle) == ESP_ERR_INVALID_STATE);
+
+	/* without a frame lock begin and end are free */
+	ssd1306_handle_t unlocked;
+	fake_panel_t panel2;
+	fake_panel_init(&panel2, I2C_SSD1306_DEV_ADDR + 1, false);
+	fake_bus_attach(&bus, &panel2);
+	ssd1306_config_t cfg2 = I2C_SSD1306_128x64_CONFIG_DEFAULT;
+	cfg2.i2c_address = I2C_SSD1306_DEV_ADDR + 1;
+	CHECK_OK(ssd1306_init(&bus, &cfg2, &unlocked));
+	CHECK_OK(ssd1306_begin_frame(unlocked, 0));
+	CHECK_OK(ssd1306_begin_frame(unlocked, 0));
+	CHECK_OK(ssd1306_end_frame(unlocked));
+
+	CHECK_OK(ssd1306_delete(unlocked));
+	CHECK_OK(ssd1306_delete(g_handle));
+
+	return HOST_TEST_RESULT("frame_lock");
+}
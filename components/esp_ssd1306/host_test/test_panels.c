@@ -0,0 +1,185 @@
+/**
+ * @file test_panels.c
+ * @brief Three emulated panels on one bus, 128x64 and 128x32 SSD1306 and a 128x128 SSD1327, flushed by
+ * the scheduler: every panel ends up matching its buffer and dirty pages are interleaved fairly.
+ */
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <ssd1306.h>
+#include "fake_bus.h"
+#include "host_test.h"
+
+#define PANEL_COUNT 3
+
+static const uint16_t panel_address[PANEL_COUNT] = { 0x3C, 0x3D, 0x3E };
+
+static ssd1306_handle_t g_holder_handle;
+static bool g_holder_in_frame;
+static bool g_holder_release;
+
+/* another task holding a frame until released */
+static void *holder_task(void *arg) {
+	(void)arg;
+
+	ssd1306_begin_frame(g_holder_handle, 0);
+	__atomic_store_n(&g_holder_in_frame, true, __ATOMIC_RELEASE);
+	while (!__atomic_load_n(&g_holder_release, __ATOMIC_ACQUIRE)) sched_yield();
+	ssd1306_end_frame(g_holder_handle);
+
+	return NULL;
+}
+
+static bool mono_matches(ssd1306_handle_t handle, const fake_panel_t *panel) {
+	static uint8_t pages[8 * 128];
+
+	ssd1306_get_pages(handle, pages);
+
+	return memcmp(pages, panel->gram, (size_t)handle->pages * 128) == 0;
+}
+
+static bool gray_matches(ssd1306_handle_t handle, const fake_panel_t *panel) {
+	return memcmp(handle->gray_buffer, panel->gray_ram, (size_t)handle->height * 64) == 0;
+}
+
+static int panel_index(uint16_t address) {
+	for (int i = 0; i < PANEL_COUNT; i++) {
+		if (panel_address[i] == address) return i;
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Between two transactions of one panel, every other panel with transactions still to come had its turn.
+ */
+static bool log_is_fair(const fake_bus_t *bus, uint32_t first, uint32_t last) {
+	for (uint32_t i = first; i < last; i++) {
+		for (uint32_t j = i + 1; j < last; j++) {
+			if (bus->log[j].address != bus->log[i].address) continue;
+
+			for (int other = 0; other < PANEL_COUNT; other++) {
+				if (panel_address[other] == bus->log[i].address) continue;
+
+				bool pending = false;
+				bool served = false;
+				for (uint32_t k = i + 1; k < last; k++) {
+					if (bus->log[k].address == panel_address[other]) {
+						pending = true;
+						if (k < j) served = true;
+					}
+				}
+				if (pending && !served) return false;
+			}
+			break;
+		}
+	}
+
+	return true;
+}
+
+int main(void) {
+	fake_bus_t bus;
+	fake_panel_t panel[PANEL_COUNT];
+	ssd1306_handle_t handle[PANEL_COUNT];
+	ssd1306_scheduler_t scheduler;
+	const ssd1306_config_t cfg[PANEL_COUNT] = {
+		I2C_SSD1306_128x64_CONFIG_DEFAULT,
+		I2C_SSD1306_128x32_CONFIG_DEFAULT,
+		I2C_SSD1306_128x128_CONFIG_DEFAULT,
+	};
+	char line[17];
+
+	fake_bus_init(&bus);
+	CHECK_OK(ssd1306_scheduler_init(&scheduler));
+
+	for (int i = 0; i < PANEL_COUNT; i++) {
+		ssd1306_config_t dev_cfg = cfg[i];
+		dev_cfg.i2c_address = panel_address[i];
+		dev_cfg.frame_lock_enabled = true;
+		fake_panel_init(&panel[i], panel_address[i], dev_cfg.panel_size == SSD1306_PANEL_128x128);
+		fake_bus_attach(&bus, &panel[i]);
+		CHECK_OK(ssd1306_init(&bus, &dev_cfg, &handle[i]));
+		CHECK_OK(ssd1306_scheduler_add_panel(&scheduler, handle[i]));
+	}
+
+	/* init leaves every panel matching its blank buffer */
+	CHECK(mono_matches(handle[0], &panel[0]));
+	CHECK(mono_matches(handle[1], &panel[1]));
+	CHECK(gray_matches(handle[2], &panel[2]));
+	CHECK(panel[0].height == 64 && panel[1].height == 32);
+
+	/* 8 dirty pages on the first panel, 1 on the second, 4 on the grayscale panel */
+	for (uint8_t page = 0; page < 8; page++) {
+		snprintf(line, sizeof(line), "128x64 page %u", page);
+		CHECK_OK(ssd1306_set_text(handle[0], page, line, false));
+	}
+	CHECK_OK(ssd1306_set_text(handle[1], 2, "128x32", true));
+	CHECK_OK(ssd1306_set_gray_level(handle[2], 0x09));
+	for (uint8_t page = 0; page < 4; page++) {
+		snprintf(line, sizeof(line), "gray %u", page);
+		CHECK_OK(ssd1306_set_text(handle[2], page * 3, line, false));
+	}
+	CHECK(__builtin_popcount(handle[0]->dirty_pages) == 8);
+	CHECK(__builtin_popcount(handle[1]->dirty_pages) == 1);
+	CHECK(__builtin_popcount(handle[2]->dirty_pages) == 4);
+
+	uint32_t first = bus.log_count;
+	CHECK_OK(ssd1306_scheduler_flush(&scheduler));
+	uint32_t last = bus.log_count;
+
+	/* one transaction per dirty page, interleaved round robin */
+	CHECK(last - first == 13);
+	CHECK(log_is_fair(&bus, first, last));
+	for (int i = 0; i < PANEL_COUNT; i++) {
+		CHECK(handle[i]->dirty_pages == 0);
+	}
+	CHECK(mono_matches(handle[0], &panel[0]));
+	CHECK(mono_matches(handle[1], &panel[1]));
+	CHECK(gray_matches(handle[2], &panel[2]));
+
+	/* the first turns go to each panel once before any panel gets a second page out */
+	int seen[PANEL_COUNT] = { 0 };
+	for (uint32_t k = first; k < first + PANEL_COUNT; k++) {
+		int index = panel_index(bus.log[k].address);
+		CHECK(index >= 0);
+		if (index >= 0) seen[index]++;
+	}
+	CHECK(seen[0] == 1 && seen[1] == 1 && seen[2] == 1);
+
+	/* a panel inside another task's frame keeps its dirty pages for a later round */
+	pthread_t holder;
+	g_holder_handle = handle[1];
+	CHECK(pthread_create(&holder, NULL, holder_task, NULL) == 0);
+	while (!__atomic_load_n(&g_holder_in_frame, __ATOMIC_ACQUIRE)) sched_yield();
+	CHECK_OK(ssd1306_set_text(handle[0], 7, "next frame", false));
+	CHECK_OK(ssd1306_set_text(handle[1], 3, "held", false));
+	CHECK_OK(ssd1306_scheduler_flush(&scheduler));
+	CHECK(handle[0]->dirty_pages == 0);
+	CHECK(handle[1]->dirty_pages == (1U << 3));
+	__atomic_store_n(&g_holder_release, true, __ATOMIC_RELEASE);
+	pthread_join(holder, NULL);
+	CHECK_OK(ssd1306_scheduler_flush(&scheduler));
+	CHECK(handle[1]->dirty_pages == 0);
+	CHECK(mono_matches(handle[0], &panel[0]));
+	CHECK(mono_matches(handle[1], &panel[1]));
+
+	/* the task holding a frame can run the scheduler inside it and its own panel is flushed */
+	CHECK_OK(ssd1306_begin_frame(handle[1], 0));
+	CHECK_OK(ssd1306_set_text(handle[1], 1, "own frame", false));
+	CHECK_OK(ssd1306_scheduler_flush(&scheduler));
+	CHECK(handle[1]->dirty_pages == 0);
+	CHECK(mono_matches(handle[1], &panel[1]));
+	CHECK_OK(ssd1306_end_frame(handle[1]));
+
+	/* the bus was busy for the wire time of every transaction */
+	printf("13 dirty pages over 3 panels: %u transactions, bus busy %lld us\n", (unsigned)(last - first), (long long)bus.busy_us);
+	CHECK(bus.busy_us > 0);
+
+	for (int i = 0; i < PANEL_COUNT; i++) {
+		CHECK_OK(ssd1306_delete(handle[i]));
+	}
+	CHECK(bus.removes == PANEL_COUNT);
+
+	return HOST_TEST_RESULT("panels");
+}
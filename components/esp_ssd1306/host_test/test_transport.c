@@ -0,0 +1,116 @@
+/**
+ * @file test_transport.c
+ * @brief I2C and 4-wire SPI transports drive identical display RAM, frame wire time follows the bus model.
+ */
+#include <string.h>
+#include <ssd1306.h>
+#include "fake_bus.h"
+#include "host_test.h"
+
+#define SPI_DC_IO   4
+#define SPI_CS_IO   5
+
+static void draw_frame(ssd1306_handle_t handle) {
+	/* 17 glyphs do not fit a 128 column page and nothing is drawn */
+	CHECK(ssd1306_set_text(handle, 0, "SSD1306 transport", false) == ESP_ERR_INVALID_SIZE);
+	CHECK_OK(ssd1306_set_text(handle, 0, "I2C and SPI", false));
+	CHECK_OK(ssd1306_set_text(handle, 3, "same frame", true));
+	CHECK_OK(ssd1306_set_line(handle, 0, 63, 127, 40, false));
+	CHECK_OK(ssd1306_set_circle(handle, 100, 20, 10, false));
+}
+
+static bool panel_matches(ssd1306_handle_t handle, const fake_panel_t *panel) {
+	static uint8_t pages[8 * 128];
+
+	ssd1306_get_pages(handle, pages);
+
+	return memcmp(pages, panel->gram, sizeof(pages)) == 0;
+}
+
+int main(void) {
+	fake_bus_t bus;
+	fake_panel_t i2c_panel;
+	fake_panel_t spi_panel;
+	uint32_t spi_trans = 0;
+	ssd1306_handle_t i2c_hdl;
+	ssd1306_handle_t spi_hdl;
+
+	fake_bus_init(&bus);
+	fake_panel_init(&i2c_panel, I2C_SSD1306_DEV_ADDR, false);
+	fake_panel_init(&spi_panel, 0, false);
+	fake_bus_attach(&bus, &i2c_panel);
+	fake_spi_attach(SPI2_HOST, &spi_panel, SPI_DC_IO, &spi_trans);
+
+	ssd1306_config_t i2c_cfg = I2C_SSD1306_128x64_CONFIG_DEFAULT;
+	i2c_cfg.i2c_clock_speed = I2C_SSD1306_DEV_CLK_SPD_FAST;
+	CHECK_OK(ssd1306_init(&bus, &i2c_cfg, &i2c_hdl));
+
+	ssd1306_spi_config_t spi_cfg = SPI_SSD1306_CONFIG_DEFAULT;
+	spi_cfg.dc_io_num = SPI_DC_IO;
+	spi_cfg.cs_io_num = SPI_CS_IO;
+	ssd1306_config_t spi_dev_cfg = I2C_SSD1306_128x64_CONFIG_DEFAULT;
+	CHECK_OK(ssd1306_spi_init(SPI2_HOST, &spi_cfg, &spi_dev_cfg, &spi_hdl));
+
+	/* setup decodes to the same controller state on both transports */
+	CHECK(i2c_panel.height == 64 && spi_panel.height == 64);
+	CHECK(i2c_panel.seg_remap && i2c_panel.com_remap);
+	CHECK(spi_panel.seg_remap && spi_panel.com_remap);
+
+	draw_frame(i2c_hdl);
+	draw_frame(spi_hdl);
+
+	/* full frame: one horizontal addressing window, one data stream */
+	int64_t t0 = fake_now_us;
+	uint32_t i2c_xfers = i2c_panel.xfers;
+	CHECK_OK(ssd1306_display_pages(i2c_hdl));
+	int64_t i2c_us = fake_now_us - t0;
+	i2c_xfers = i2c_panel.xfers - i2c_xfers;
+
+	t0 = fake_now_us;
+	spi_trans = 0;
+	CHECK_OK(ssd1306_display_pages(spi_hdl));
+	int64_t spi_us = fake_now_us - t0;
+
+	CHECK(panel_matches(i2c_hdl, &i2c_panel));
+	CHECK(panel_matches(spi_hdl, &spi_panel));
+	CHECK(memcmp(i2c_panel.gram, spi_panel.gram, 8 * 128) == 0);
+
+	/* commands, data and the closing page addressing commands are three d/c runs */
+	CHECK(i2c_xfers == 2);
+	CHECK(spi_trans == 3);
+
+	/* 1 KiB of pixels at 400 kHz is about 23.5 ms of wire time, 8 MHz SPI about 1 ms */
+	CHECK(i2c_us >= fake_i2c_wire_us(I2C_SSD1306_DEV_CLK_SPD_FAST, 8 * 128));
+	CHECK(i2c_us < 30000);
+	CHECK(spi_us < 1500);
+	CHECK(spi_us * 15 < i2c_us);
+	printf("full frame: i2c@400kHz %lld us in %u transactions, spi@8MHz %lld us in %u transactions\n",
+		   (long long)i2c_us, (unsigned)i2c_xfers, (long long)spi_us, (unsigned)spi_trans);
+
+	/* partial update: one changed line goes out as one window per transport */
+	CHECK_OK(ssd1306_set_text(i2c_hdl, 6, "dirty line", false));
+	CHECK_OK(ssd1306_set_text(spi_hdl, 6, "dirty line", false));
+	i2c_xfers = i2c_panel.xfers;
+	spi_trans = 0;
+	t0 = fake_now_us;
+	CHECK_OK(ssd1306_flush(i2c_hdl));
+	i2c_us = fake_now_us - t0;
+	CHECK_OK(ssd1306_flush(spi_hdl));
+	CHECK(i2c_panel.xfers - i2c_xfers == 1);
+	CHECK(spi_trans == 2);
+	CHECK(i2c_us < fake_i2c_wire_us(I2C_SSD1306_DEV_CLK_SPD_FAST, 128));
+	CHECK(panel_matches(i2c_hdl, &i2c_panel));
+	CHECK(memcmp(i2c_panel.gram, spi_panel.gram, 8 * 128) == 0);
+
+	/* redrawing identical text marks nothing */
+	CHECK_OK(ssd1306_set_text(i2c_hdl, 6, "dirty line", false));
+	i2c_xfers = i2c_panel.xfers;
+	CHECK_OK(ssd1306_flush(i2c_hdl));
+	CHECK(i2c_panel.xfers == i2c_xfers);
+
+	CHECK_OK(ssd1306_delete(i2c_hdl));
+	CHECK_OK(ssd1306_delete(spi_hdl));
+	CHECK(bus.removes == 1);
+
+	return HOST_TEST_RESULT("transport");
+}
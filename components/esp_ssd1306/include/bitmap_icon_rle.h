@@ -0,0 +1,200 @@
+/**
+ * @file bitmap_icon_rle.h
+ * @defgroup drivers ssd1306
+ * @{
+ *
+ * page-major, run-length compressed images for `ssd1306_set_rle_image`
+ *
+ * Generated by tools/ssd1306_rle_pack.py, do not edit.
+ */
+
+#ifndef __BITMAP_ICON_RLE_H__
+#define __BITMAP_ICON_RLE_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* data_tx_icon_32x32 32x32, 56 bytes (128 row-major) */
+static const uint8_t data_tx_icon_32x32_rle[] = {
+	0x20, 0x20, 0x83, 0xff, 0x00, 0x7f, 0x86, 0xbf, 0x00, 0x7f, 0x96, 0xff, 0x00, 0x00, 0x86, 0xff,
+	0x01, 0xfe, 0xfc, 0x8a, 0xfd, 0x00, 0x01, 0x89, 0xff, 0x00, 0x00, 0x8a, 0xff, 0x01, 0x0f, 0x67,
+	0x82, 0xf7, 0x05, 0xf1, 0xf9, 0xf3, 0xf7, 0x6f, 0x9f, 0x89, 0xff, 0x88, 0xfe, 0x82, 0xff, 0x83,
+	0xfe, 0x03, 0xf8, 0xf9, 0xfd, 0xfe, 0x86, 0xff,
+};
+
+/* data_rx_icon_32x32 32x32, 79 bytes (128 row-major) */
+static const uint8_t data_rx_icon_32x32_rle[] = {
+	0x20, 0x20, 0x85, 0xff, 0x00, 0x7f, 0x85, 0xbf, 0x00, 0x7f, 0x82, 0xff, 0x00, 0x3f, 0x82, 0xbf,
+	0x00, 0x3f, 0x8c, 0xff, 0x06, 0x1f, 0xef, 0xef, 0xe0, 0xef, 0xef, 0xff, 0x82, 0xef, 0x82, 0xee,
+	0x01, 0xae, 0x40, 0x82, 0xff, 0x06, 0x08, 0xbe, 0xee, 0x0e, 0xfe, 0xfe, 0x00, 0x86, 0xff, 0x00,
+	0x00, 0x84, 0xff, 0x86, 0xbd, 0x0b, 0xbf, 0xbf, 0xbe, 0xbd, 0xbe, 0xbf, 0xff, 0xff, 0x00, 0xff,
+	0xff, 0x00, 0x87, 0xff, 0x00, 0xfe, 0x92, 0xfd, 0x03, 0xfc, 0xfd, 0xfd, 0xfc, 0x83, 0xff,
+};
+
+/* batman_icon_32x13 32x13, 62 bytes (52 row-major) */
+static const uint8_t batman_icon_32x13_rle[] = {
+	0x20, 0x0d, 0x82, 0xff, 0x07, 0x3f, 0x0f, 0x07, 0x07, 0x03, 0x03, 0x01, 0x0d, 0x82, 0x1f, 0x03,
+	0x07, 0x03, 0x03, 0x07, 0x82, 0x1f, 0x07, 0x0d, 0x01, 0x03, 0x03, 0x07, 0x07, 0x0f, 0x3f, 0x82,
+	0xff, 0x83, 0x1f, 0x05, 0x1c, 0x18, 0x10, 0x14, 0x1e, 0x1e, 0x82, 0x1c, 0x05, 0x1e, 0x1c, 0x10,
+	0x10, 0x1c, 0x1e, 0x82, 0x1c, 0x05, 0x1e, 0x1e, 0x14, 0x10, 0x18, 0x1c, 0x83, 0x1f,
+};
+
+/* skull_icon_24x32 24x32, 79 bytes (96 row-major) */
+static const uint8_t skull_icon_24x32_rle[] = {
+	0x18, 0x20, 0x07, 0x00, 0x80, 0xf0, 0xf8, 0xf8, 0xfc, 0xfe, 0xfe, 0x86, 0xff, 0x06, 0xfe, 0xfe,
+	0xfc, 0xfc, 0xf8, 0xf0, 0xc0, 0x82, 0x00, 0x02, 0x3f, 0xff, 0xff, 0x84, 0x3f, 0x00, 0x7f, 0x82,
+	0xff, 0x00, 0x7f, 0x84, 0x3f, 0x02, 0xf7, 0xfe, 0xff, 0x82, 0x00, 0x02, 0x02, 0x1f, 0x1f, 0x83,
+	0xf8, 0x06, 0xfc, 0xfe, 0xc7, 0x83, 0xc3, 0xff, 0xfc, 0x83, 0xf8, 0x02, 0x3f, 0x1f, 0x06, 0x85,
+	0x00, 0x03, 0x03, 0x0f, 0x3f, 0x7f, 0x86, 0xff, 0x03, 0x7f, 0x3f, 0x1f, 0x03, 0x84, 0x00,
+};
+
+/* radioactive_icon_32x32 32x32, 74 bytes (128 row-major) */
+static const uint8_t radioactive_icon_32x32_rle[] = {
+	0x20, 0x20, 0x0b, 0x00, 0x00, 0xc0, 0xe0, 0xf0, 0xf8, 0xfc, 0xfe, 0xfc, 0xf0, 0xc0, 0x80, 0x87,
+	0x00, 0x0c, 0x80, 0xe0, 0xf8, 0xfc, 0xfe, 0xfc, 0xf8, 0xf0, 0xe0, 0xc0, 0x00, 0x00, 0x78, 0x89,
+	0x7f, 0x02, 0x1f, 0x0e, 0xe0, 0x83, 0xf0, 0x02, 0xe4, 0x0e, 0x3f, 0x89, 0x7f, 0x00, 0x78, 0x8a,
+	0x00, 0x09, 0x80, 0xe0, 0xf3, 0xf3, 0xf7, 0xf7, 0xf3, 0xf1, 0xe0, 0x80, 0x92, 0x00, 0x02, 0x10,
+	0x3c, 0x3e, 0x89, 0x7f, 0x02, 0x3e, 0x3c, 0x30, 0x87, 0x00,
+};
+
+/* biohazard_icon_36x32 36x32, 113 bytes (160 row-major) */
+static const uint8_t biohazard_icon_36x32_rle[] = {
+	0x24, 0x20, 0x86, 0x00, 0x05, 0xc0, 0xe0, 0xf8, 0x3c, 0x04, 0x02, 0x89, 0x00, 0x04, 0x06, 0x0c,
+	0xf8, 0xf0, 0xc0, 0x89, 0x00, 0x04, 0x80, 0xc0, 0xe0, 0xf0, 0xf8, 0x83, 0x7f, 0x0d, 0xf8, 0xf0,
+	0xe6, 0xee, 0xc7, 0xc7, 0x07, 0x47, 0xc7, 0xce, 0xee, 0xf4, 0xf8, 0xfc, 0x83, 0x7f, 0x03, 0xf0,
+	0xf0, 0xe0, 0x80, 0x83, 0x00, 0x02, 0x1c, 0x07, 0x01, 0x84, 0x00, 0x06, 0x1f, 0x7e, 0xfc, 0xe0,
+	0xc1, 0x83, 0x03, 0x82, 0xf8, 0x07, 0x18, 0x03, 0xc1, 0xe0, 0xf8, 0x7e, 0x3f, 0x0f, 0x83, 0x00,
+	0x02, 0x01, 0x03, 0x0e, 0x86, 0x00, 0x0a, 0x20, 0x20, 0x40, 0x40, 0xc0, 0xc0, 0xe0, 0xe1, 0xf1,
+	0xf9, 0x7e, 0x83, 0x7f, 0x05, 0xfc, 0xf3, 0xe1, 0xe0, 0xe0, 0xc0, 0x82, 0x40, 0x00, 0x20, 0x85,
+	0x00,
+};
+
+/* proton_icon_32x32 32x32, 111 bytes (128 row-major) */
+static const uint8_t proton_icon_32x32_rle[] = {
+	0x20, 0x20, 0x8a, 0x00, 0x0a, 0xe0, 0x38, 0x0e, 0x06, 0x03, 0x83, 0x83, 0xc6, 0x7c, 0xf0, 0xe0,
+	0x84, 0x30, 0x01, 0xe0, 0xc0, 0x82, 0x00, 0x3f, 0x80, 0xe0, 0x60, 0x30, 0x10, 0x18, 0x08, 0x08,
+	0x8c, 0xcc, 0xff, 0x3f, 0x1c, 0x0c, 0xc6, 0xc7, 0xe7, 0xc4, 0xc4, 0x04, 0x04, 0xff, 0xfc, 0x0c,
+	0x88, 0xf8, 0x38, 0x1f, 0x31, 0x60, 0xe0, 0xc0, 0x03, 0x07, 0x0c, 0x08, 0xd8, 0xf8, 0x3c, 0x37,
+	0x21, 0x21, 0xff, 0xe0, 0x60, 0x60, 0x63, 0x67, 0xe7, 0xe7, 0x63, 0x70, 0x78, 0xff, 0x7f, 0x23,
+	0x21, 0x30, 0x10, 0x18, 0x18, 0x0c, 0x07, 0x03, 0x83, 0x00, 0x01, 0x07, 0x0f, 0x82, 0x18, 0x0c,
+	0x08, 0x08, 0x0f, 0x1e, 0x76, 0xe2, 0xc3, 0xc1, 0xc0, 0x60, 0x38, 0x1e, 0x03, 0x89, 0x00,
+};
+
+/* molecule_icon_32x32 32x32, 61 bytes (128 row-major) */
+static const uint8_t molecule_icon_32x32_rle[] = {
+	0x20, 0x20, 0x83, 0x00, 0x00, 0x0e, 0x82, 0x1f, 0x00, 0x0e, 0x93, 0x00, 0x82, 0x80, 0x8b, 0x00,
+	0x01, 0xc0, 0xe0, 0x83, 0xf0, 0x01, 0xe0, 0xc0, 0x87, 0x00, 0x06, 0x03, 0x07, 0x07, 0x03, 0x30,
+	0x30, 0x10, 0x88, 0x00, 0x01, 0x03, 0x07, 0x83, 0x0f, 0x01, 0x07, 0x03, 0x85, 0x00, 0x82, 0x80,
+	0x8c, 0x00, 0x00, 0x10, 0x8c, 0x00, 0x00, 0x0f, 0x84, 0x1f, 0x01, 0x06, 0x00,
+};
+
+/* skull_icon_50x64 50x64, 227 bytes (448 row-major) */
+static const uint8_t skull_icon_50x64_rle[] = {
+	0x32, 0x40, 0x87, 0x00, 0x06, 0x80, 0x80, 0xc0, 0xe0, 0xf0, 0xf0, 0xf8, 0x82, 0xfc, 0x82, 0xfe,
+	0x88, 0xff, 0x82, 0xfe, 0x08, 0xfc, 0xfc, 0xf8, 0xf8, 0xf0, 0xe0, 0xe0, 0xc0, 0x80, 0x8c, 0x00,
+	0x02, 0xf0, 0xcc, 0x7f, 0xa2, 0xff, 0x02, 0x3e, 0xe0, 0xe0, 0x87, 0x00, 0x82, 0xff, 0x02, 0xfe,
+	0xf3, 0x1f, 0x9d, 0xff, 0x02, 0xbf, 0xe7, 0xfd, 0x82, 0xff, 0x00, 0xfc, 0x86, 0x00, 0x06, 0x03,
+	0x7f, 0xff, 0xef, 0xfd, 0xff, 0x1f, 0x83, 0x0f, 0x82, 0x07, 0x03, 0x0f, 0x0f, 0x1f, 0x3f, 0x86,
+	0xff, 0x03, 0x3f, 0x1f, 0x0f, 0x0f, 0x82, 0x07, 0x83, 0x0f, 0x05, 0x3f, 0xfe, 0xf7, 0xff, 0xff,
+	0x0f, 0x88, 0x00, 0x01, 0x3c, 0xfc, 0x82, 0xff, 0x05, 0xe0, 0xc0, 0x80, 0x80, 0xc0, 0xc0, 0x82,
+	0xe0, 0x0e, 0xf0, 0xf8, 0xfe, 0x3f, 0x0f, 0x07, 0x07, 0x0f, 0x1f, 0xff, 0xfc, 0xf0, 0xf0, 0xe0,
+	0xe0, 0x82, 0xc0, 0x03, 0x80, 0xc0, 0xc0, 0xf8, 0x82, 0xff, 0x01, 0x7c, 0x1c, 0x8a, 0x00, 0x03,
+	0x01, 0x03, 0x07, 0xf7, 0x83, 0xff, 0x00, 0xef, 0x85, 0xff, 0x00, 0xf0, 0x84, 0xe0, 0x00, 0xf8,
+	0x84, 0xff, 0x00, 0x6f, 0x83, 0xff, 0x04, 0xf7, 0x87, 0x07, 0x03, 0x01, 0x8f, 0x00, 0x0a, 0x07,
+	0x1f, 0x7f, 0xff, 0xff, 0xf9, 0xff, 0xe7, 0xff, 0xff, 0x03, 0x83, 0xff, 0x00, 0x07, 0x83, 0xff,
+	0x02, 0xfb, 0xff, 0xfd, 0x84, 0xff, 0x02, 0x1f, 0x0f, 0x03, 0x95, 0x00, 0x06, 0x01, 0x07, 0x0f,
+	0x1f, 0x3f, 0x7f, 0x7f, 0x82, 0xff, 0x85, 0xfe, 0x07, 0xff, 0x7f, 0x7f, 0x3f, 0x1f, 0x1f, 0x0f,
+	0x03, 0x8c, 0x00,
+};
+
+/* radioactive_icon_64x64 64x64, 165 bytes (512 row-major) */
+static const uint8_t radioactive_icon_64x64_rle[] = {
+	0x40, 0x40, 0x88, 0x00, 0x09, 0x80, 0xc0, 0xe0, 0xf0, 0xf0, 0xf8, 0xfc, 0xf0, 0xe0, 0x80, 0x99,
+	0x00, 0x09, 0xc0, 0xf0, 0xf8, 0xfc, 0xf8, 0xf0, 0xf0, 0xe0, 0xc0, 0x80, 0x8b, 0x00, 0x04, 0x80,
+	0xc0, 0xf0, 0xf8, 0xfe, 0x8a, 0xff, 0x03, 0xfe, 0xf8, 0xf0, 0xc0, 0x90, 0x00, 0x03, 0x80, 0xe0,
+	0xf8, 0xfe, 0x8b, 0xff, 0x04, 0xfe, 0xf8, 0xf0, 0xc0, 0x80, 0x83, 0x00, 0x01, 0xf0, 0xfc, 0x94,
+	0xff, 0x02, 0xfe, 0x78, 0x20, 0x88, 0x00, 0x02, 0x20, 0x70, 0x7c, 0x95, 0xff, 0x02, 0xfe, 0xf0,
+	0x00, 0x95, 0x3f, 0x05, 0x0f, 0x01, 0x00, 0xf0, 0xfc, 0xfe, 0x86, 0xff, 0x05, 0xfe, 0xfe, 0xfc,
+	0xe0, 0x00, 0x03, 0x96, 0x3f, 0x98, 0x00, 0x03, 0x01, 0x07, 0x8f, 0x8f, 0x85, 0x1f, 0x02, 0x8f,
+	0x8f, 0x03, 0xaf, 0x00, 0x03, 0x80, 0xe0, 0xf8, 0xfe, 0x8b, 0xff, 0x03, 0xfc, 0xf8, 0xe0, 0x80,
+	0xa6, 0x00, 0x03, 0x80, 0xe0, 0xf0, 0xfc, 0x95, 0xff, 0x03, 0xfc, 0xf0, 0xc0, 0x80, 0xa0, 0x00,
+	0x03, 0x06, 0x07, 0x0f, 0x0f, 0x82, 0x1f, 0x83, 0x3f, 0x89, 0x7f, 0x83, 0x3f, 0x82, 0x1f, 0x82,
+	0x0f, 0x00, 0x06, 0x8f, 0x00,
+};
+
+/* biohazard_icon_70x64 70x64, 322 bytes (576 row-major) */
+static const uint8_t biohazard_icon_70x64_rle[] = {
+	0x46, 0x40, 0x91, 0x00, 0x08, 0x80, 0xc0, 0xe0, 0xf0, 0x78, 0x18, 0x0c, 0x04, 0x02, 0x8f, 0x00,
+	0x08, 0x02, 0x02, 0x04, 0x0c, 0x38, 0x70, 0xe0, 0xe0, 0xc0, 0x9f, 0x00, 0x02, 0xc0, 0xf0, 0xfc,
+	0x83, 0xff, 0x00, 0x03, 0x9a, 0x00, 0x00, 0x03, 0x82, 0xff, 0x03, 0xfe, 0xfc, 0xf0, 0x80, 0x97,
+	0x00, 0x02, 0x80, 0x80, 0xfe, 0x86, 0xff, 0x07, 0xfc, 0xe0, 0xc0, 0x80, 0x18, 0x3c, 0x7c, 0xfc,
+	0x82, 0x7e, 0x85, 0x3f, 0x0b, 0x7e, 0x7e, 0xfe, 0xfc, 0xfc, 0x7c, 0x38, 0x10, 0x80, 0xc0, 0xf0,
+	0xfe, 0x86, 0xff, 0x02, 0xf0, 0x80, 0x80, 0x8d, 0x00, 0x07, 0x80, 0xc0, 0xf0, 0xf8, 0xfc, 0xfe,
+	0xff, 0xff, 0x83, 0x7f, 0x01, 0x3f, 0x3f, 0x84, 0x7f, 0x82, 0xff, 0x07, 0xfe, 0xfc, 0xfc, 0xf8,
+	0xf8, 0xf0, 0xf0, 0x70, 0x82, 0x00, 0x07, 0x70, 0xf0, 0xf0, 0xf8, 0xf8, 0xfc, 0xfc, 0xfe, 0x82,
+	0xff, 0x83, 0x7f, 0x01, 0x3f, 0x3f, 0x84, 0x7f, 0x06, 0xff, 0xff, 0xfe, 0xfc, 0xf8, 0xe0, 0xc0,
+	0x85, 0x00, 0x07, 0xe0, 0xfc, 0x3f, 0x0f, 0x07, 0x03, 0x01, 0x01, 0x86, 0x00, 0x00, 0x7e, 0x83,
+	0xfe, 0x09, 0xfc, 0xc0, 0x00, 0x01, 0x03, 0x03, 0x0f, 0x1f, 0x0f, 0xc3, 0x82, 0xc0, 0x00, 0x80,
+	0x82, 0xc0, 0x08, 0x8f, 0x1f, 0x0f, 0x07, 0x03, 0x01, 0x01, 0x00, 0xf0, 0x83, 0xfe, 0x00, 0xff,
+	0x87, 0x00, 0x07, 0x01, 0x03, 0x03, 0x0f, 0x1f, 0x7f, 0xfc, 0x80, 0x82, 0x00, 0x00, 0x1f, 0x8e,
+	0x00, 0x0d, 0x03, 0x0f, 0x1f, 0x7f, 0xff, 0xff, 0xfe, 0xfc, 0xf8, 0xf0, 0xe0, 0x40, 0x00, 0x01,
+	0x86, 0xff, 0x0c, 0x00, 0x00, 0xe0, 0xe0, 0xf0, 0xf8, 0xfc, 0xff, 0xff, 0x7f, 0x3f, 0x1f, 0x07,
+	0x8e, 0x00, 0x01, 0x01, 0x1f, 0x97, 0x00, 0x08, 0x01, 0x01, 0x03, 0x07, 0x87, 0xc7, 0xe0, 0xf8,
+	0xfe, 0x86, 0xff, 0x07, 0xfc, 0xf0, 0xc1, 0x87, 0x07, 0x03, 0x03, 0x01, 0x9f, 0x00, 0x06, 0x02,
+	0x04, 0x0c, 0x18, 0x18, 0x38, 0x30, 0x83, 0x70, 0x82, 0xf8, 0x02, 0xfc, 0xfc, 0xfe, 0x82, 0xff,
+	0x82, 0x7f, 0x03, 0x3f, 0x3f, 0x1f, 0x1f, 0x82, 0x3f, 0x82, 0x7f, 0x05, 0xff, 0xff, 0xfe, 0xfe,
+	0xfc, 0xfc, 0x82, 0xf8, 0x82, 0x70, 0x08, 0x30, 0x30, 0x18, 0x18, 0x08, 0x0c, 0x04, 0x02, 0x01,
+	0x86, 0x00,
+};
+
+/* proton_icon_64x64 64x64, 328 bytes (512 row-major) */
+static const uint8_t proton_icon_64x64_rle[] = {
+	0x40, 0x40, 0x97, 0x00, 0x05, 0x80, 0xe0, 0xf8, 0x7c, 0x3e, 0x1e, 0x84, 0x0f, 0x05, 0x1e, 0x3e,
+	0x7c, 0xf8, 0xe0, 0xc0, 0xab, 0x00, 0x05, 0xc0, 0xf8, 0xff, 0x3f, 0x07, 0x01, 0x84, 0x00, 0x0d,
+	0x80, 0xc0, 0xc0, 0xe0, 0xe0, 0x70, 0x79, 0x3f, 0x3f, 0xff, 0xfe, 0xce, 0x0e, 0x0e, 0x85, 0x07,
+	0x04, 0x0f, 0x1f, 0xfe, 0xfc, 0xf8, 0x8e, 0x00, 0x82, 0x80, 0x82, 0xc0, 0x82, 0xe0, 0x11, 0x60,
+	0x70, 0x70, 0xfc, 0xff, 0xff, 0xf1, 0xf0, 0xf8, 0xf8, 0x78, 0x3c, 0x3e, 0x3e, 0x3f, 0x3f, 0x3b,
+	0x39, 0x84, 0x38, 0x06, 0x70, 0x71, 0x7f, 0xff, 0xfe, 0xf0, 0x60, 0x83, 0xe0, 0x05, 0xc0, 0xc0,
+	0xf0, 0xff, 0xff, 0x0f, 0x86, 0x00, 0x0a, 0xc0, 0xe0, 0xf8, 0xfc, 0x3c, 0x1e, 0x0e, 0x07, 0x07,
+	0x03, 0x03, 0x82, 0x01, 0x0f, 0x00, 0x00, 0x80, 0xe0, 0xf0, 0xfe, 0xff, 0xff, 0x0f, 0x07, 0x03,
+	0x01, 0x00, 0x00, 0xe0, 0xf0, 0x85, 0xf8, 0x01, 0xf0, 0xe0, 0x84, 0x00, 0x82, 0xff, 0x27, 0x00,
+	0x80, 0xc0, 0xf0, 0xfd, 0x3f, 0x1f, 0x07, 0x03, 0x07, 0x07, 0x0f, 0x1e, 0x3e, 0xfc, 0xf8, 0xf0,
+	0xe0, 0x07, 0x1f, 0x3f, 0x7f, 0x78, 0xf0, 0xe0, 0xc0, 0xc0, 0x80, 0x80, 0xc0, 0xe0, 0xf8, 0x7e,
+	0x1f, 0x07, 0x03, 0x01, 0x7f, 0xff, 0xff, 0x85, 0x00, 0x02, 0x07, 0x1f, 0x1f, 0x83, 0x3f, 0x07,
+	0x1f, 0x1f, 0x0f, 0x00, 0x00, 0x80, 0xc0, 0xe0, 0x82, 0xff, 0x03, 0x1e, 0x0f, 0x07, 0x01, 0x83,
+	0x00, 0x09, 0x80, 0x80, 0xc0, 0xe0, 0xe0, 0xf8, 0x7e, 0x3f, 0x1f, 0x0f, 0x85, 0x00, 0x07, 0x01,
+	0x01, 0xe3, 0xff, 0xff, 0x3f, 0x07, 0x07, 0x82, 0x0e, 0x82, 0x1c, 0x03, 0x3f, 0xff, 0xff, 0xb8,
+	0x86, 0x38, 0x01, 0xb8, 0xb8, 0x82, 0xf8, 0x0a, 0x78, 0x3c, 0x3e, 0x3f, 0x1f, 0x9f, 0xff, 0xff,
+	0x7f, 0x1c, 0x1c, 0x83, 0x0e, 0x82, 0x07, 0x03, 0x03, 0x03, 0x01, 0x01, 0x8d, 0x00, 0x04, 0x3f,
+	0x7f, 0xff, 0xf0, 0xe0, 0x86, 0xc0, 0x0e, 0xe0, 0xe7, 0xff, 0xff, 0xfc, 0xf8, 0xbc, 0x1c, 0x1e,
+	0x0e, 0x07, 0x07, 0x03, 0x01, 0x01, 0x83, 0x00, 0x04, 0xc0, 0xf8, 0xff, 0x3f, 0x07, 0x9e, 0x00,
+	0x88, 0x01, 0x83, 0x00, 0x10, 0x03, 0x0f, 0x1f, 0x3e, 0x78, 0xf8, 0xf0, 0xf0, 0xe0, 0xf0, 0xf0,
+	0xf8, 0x78, 0x3e, 0x1f, 0x0f, 0x03, 0x96, 0x00,
+};
+
+/* molecule_icon_64x64 64x64, 189 bytes (512 row-major) */
+static const uint8_t molecule_icon_64x64_rle[] = {
+	0x40, 0x40, 0x87, 0x00, 0x02, 0x78, 0xfe, 0xfe, 0x83, 0xff, 0x02, 0xfe, 0xfc, 0x30, 0xb6, 0x00,
+	0x01, 0x01, 0x01, 0x82, 0x03, 0x82, 0x01, 0x04, 0x02, 0x04, 0x10, 0x60, 0x80, 0xa2, 0x00, 0x00,
+	0x80, 0x84, 0xc0, 0x96, 0x00, 0x05, 0x03, 0x04, 0x08, 0x30, 0x40, 0x80, 0x82, 0x00, 0x01, 0x80,
+	0x80, 0x8e, 0x00, 0x08, 0x80, 0x80, 0x40, 0x40, 0x20, 0x20, 0x00, 0x10, 0x0f, 0x85, 0x1f, 0x00,
+	0x07, 0x97, 0x00, 0x02, 0xf0, 0xf8, 0xfc, 0x88, 0xff, 0x0b, 0xfe, 0xfc, 0xf8, 0xf0, 0x10, 0x08,
+	0x04, 0x04, 0x02, 0x02, 0x01, 0x01, 0x96, 0x00, 0x82, 0x80, 0x82, 0x40, 0x0e, 0x00, 0x20, 0x20,
+	0x00, 0x10, 0x10, 0x00, 0x08, 0x08, 0x00, 0x04, 0x0f, 0x1f, 0x3f, 0x7f, 0x87, 0xff, 0x03, 0x7f,
+	0x7f, 0xdf, 0x8f, 0x97, 0x00, 0x00, 0x06, 0x82, 0x0f, 0x02, 0x03, 0x01, 0x01, 0x91, 0x00, 0x04,
+	0x80, 0x60, 0x18, 0x06, 0x01, 0x89, 0x00, 0x07, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+	0x82, 0x00, 0x00, 0x80, 0x84, 0xc0, 0x01, 0x80, 0x80, 0x99, 0x00, 0x04, 0x80, 0x60, 0x18, 0x06,
+	0x01, 0x95, 0x00, 0x00, 0x79, 0x8a, 0xff, 0x00, 0xfe, 0x95, 0x00, 0x03, 0x02, 0x07, 0x07, 0x02,
+	0x99, 0x00, 0x02, 0x01, 0x03, 0x03, 0x85, 0x07, 0x01, 0x03, 0x01, 0x83, 0x00,
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif /* __BITMAP_ICON_RLE_H__ */
@@ -0,0 +1,1221 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file ssd1306.h
+ * @defgroup drivers ssd1306
+ * @{
+ *
+ * ESP-IDF driver for ssd1306 display panel
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __SSD1306_H__
+#define __SSD1306_H__
+
+/**
+ * dependency includes
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_err.h>
+#include <driver/i2c_master.h>
+#include <driver/spi_master.h>
+#include <driver/gpio.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <sdkconfig.h>
+#include <type_utils.h>
+#include "ssd1306_version.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * public constant definitions
+ */
+
+#define I2C_SSD1306_DEV_CLK_SPD           		UINT32_C(100000) //!< ssd1306 I2C default clock frequency (100KHz)
+#define I2C_SSD1306_DEV_CLK_SPD_FAST      		UINT32_C(400000) //!< ssd1306 I2C fast mode clock frequency (400KHz)
+#define I2C_SSD1306_DEV_CLK_SPD_FAST_PLUS 		UINT32_C(1000000) //!< ssd1306 I2C fast mode plus clock frequency (1MHz)
+
+#define I2C_SSD1306_DEV_ADDR               		UINT8_C(0x3c)   //!< ssd1306 I2C address
+
+#define I2C_XFR_TIMEOUT_MS      (500)          //!< I2C transaction timeout in milliseconds
+#define I2C_XFR_RETRIES         (2)            //!< I2C transaction attempts after a failed transaction
+#define I2C_CLK_VERIFY_ROUNDS   (8)            //!< I2C pattern writes that must all be acknowledged before a faster clock is kept
+#define I2C_CLK_FALLBACK_ERRORS (3)            //!< I2C failed transactions within a window that step the negotiated clock down
+#define I2C_CLK_FALLBACK_WINDOW (256)          //!< I2C transactions per fallback error counting window
+
+#define SPI_SSD1306_DEV_CLK_SPD           		UINT32_C(8000000) //!< ssd1306 SPI default clock frequency (8MHz)
+
+
+#define SSD1306_PAGE_SEGMENT_SIZE				128		//!< ssd1306 segment size
+#define SSD1306_PAGE_128x32_SIZE				4		//!< ssd1306 128x32 page size
+#define SSD1306_PAGE_128x64_SIZE				8		//!< ssd1306 128x64 page size
+#define SSD1306_PAGE_128x128_SIZE				16		//!< ssd1306 128x128 page size
+
+#define SSD1306_PANEL_128x32_WIDTH				128		//!< ssd1306 128x32 panel width
+#define SSD1306_PANEL_128x64_WIDTH				128		//!< ssd1306 128x64 panel width
+#define SSD1306_PANEL_128x128_WIDTH				128		//!< ssd1306 128x128 panel width
+
+#define SSD1306_CMD_LIST_MAX_XFERS				20		//!< ssd1306 maximum transactions recorded by a command list
+#define SSD1306_SPI_MAX_SEGMENTS				4		//!< ssd1306 command and data runs queued per spi write
+#define SSD1306_SCHEDULER_MAX_PANELS			4		//!< ssd1306 maximum panels sharing a bus flush scheduler
+
+#define SSD1306_I2C_STATS_LATENCY_BUCKETS		16		//!< ssd1306 i2c latency histogram buckets, bucket n counts [2^n, 2^(n+1)) us
+
+#define SSD1306_RLE_HEADER_SIZE					2		//!< ssd1306 rle image header size (width, height)
+#define SSD1306_RLE_REPEAT						0x80	//!< ssd1306 rle control flag, next byte repeats (count & 0x7f) + 1 times
+#define SSD1306_RLE_COUNT_MASK					0x7F	//!< ssd1306 rle control run length mask, literal runs copy (count + 1) bytes
+
+#define SSD1306_PANEL_128x32_HEIGHT				32		//!< ssd1306 128x32 panel height
+#define SSD1306_PANEL_128x64_HEIGHT				64		//!< ssd1306 128x64 panel height
+#define SSD1306_PANEL_128x128_HEIGHT			128		//!< ssd1306 128x128 panel height
+
+/**
+ * public macro definitions
+ */
+
+/**
+ * @brief Macro that sizes a command list buffer for one page addressed image (page address commands and 128 segments).
+ */
+#define SSD1306_CMD_LIST_IMAGE_SIZE			(7 + SSD1306_PAGE_SEGMENT_SIZE)
+
+/**
+ * @brief Macro that sizes a command list buffer for a full frame of `pages` with addressing window commands.
+ */
+#define SSD1306_CMD_LIST_FRAME_SIZE(pages)	(32 + ((pages) * SSD1306_PAGE_SEGMENT_SIZE))
+
+/**
+ * @brief Macro that sizes a command list buffer for an ssd1327 grayscale window of `width` by `height` pixels.
+ */
+#define SSD1327_CMD_LIST_WINDOW_SIZE(width, height)	(16 + ((((width) + 1) / 2) * (height)))
+
+/**
+ * @brief Macro that initializes `ssd1306_config_t` to default configuration settings for a 128x32 display.
+ */
+#define I2C_SSD1306_128x32_CONFIG_DEFAULT 	{				\
+    .i2c_address  				= I2C_SSD1306_DEV_ADDR,		\
+	.i2c_clock_speed    		= I2C_SSD1306_DEV_CLK_SPD,  \
+    .panel_size                 = SSD1306_PANEL_128x32,	    \
+    .offset_x                   = 0,						\
+    .flip_enabled               = false }	
+
+/**
+ * @brief Macro that initializes `ssd1306_config_t` to default configuration settings for a 128x64 display.
+ */
+#define I2C_SSD1306_128x64_CONFIG_DEFAULT 	{				\
+    .i2c_address  				= I2C_SSD1306_DEV_ADDR,		\
+	.i2c_clock_speed    		= I2C_SSD1306_DEV_CLK_SPD,  \
+    .panel_size                 = SSD1306_PANEL_128x64,	    \
+    .offset_x                   = 0,						\
+    .flip_enabled               = false }
+
+/**
+ * @brief Macro that initializes `ssd1306_config_t` to default configuration settings for a 128x128 display.
+ */
+#define I2C_SSD1306_128x128_CONFIG_DEFAULT 	{				\
+    .i2c_address  				= I2C_SSD1306_DEV_ADDR,		\
+	.i2c_clock_speed    		= I2C_SSD1306_DEV_CLK_SPD,  \
+    .panel_size                 = SSD1306_PANEL_128x128,	\
+    .offset_x                   = 0,						\
+    .flip_enabled               = false }
+
+
+/**
+ * @brief Macro that initializes `ssd1306_spi_config_t` to default 4-wire SPI settings, pins are set by the caller.
+ */
+#define SPI_SSD1306_CONFIG_DEFAULT 	{					\
+    .cs_io_num                  = GPIO_NUM_NC,			\
+    .dc_io_num                  = GPIO_NUM_NC,			\
+    .rst_io_num                 = GPIO_NUM_NC,			\
+	.clock_speed_hz    			= SPI_SSD1306_DEV_CLK_SPD }
+
+
+/*
+ * enumerator and structure declarations
+*/
+
+/**
+ * @brief SSD1306 transport types enumerator definition.
+ */
+typedef enum ssd1306_transport_types_e {
+	SSD1306_TRANSPORT_I2C = 0, /*!< ssd1306 on an i2c master bus */
+	SSD1306_TRANSPORT_SPI = 1  /*!< ssd1306 on a 4-wire spi bus with d/c line */
+} ssd1306_transport_types_t;
+
+
+/**
+ * @brief SSD1306 scroll step in terms of frame frequency enumerator definition.
+ * 
+ */
+typedef enum ssd1306_scroll_frames_e {
+	SSD1306_SCROLL_5_FRAMES 	= 0b000,
+	SSD1306_SCROLL_64_FRAMES 	= 0b001,
+	SSD1306_SCROLL_128_FRAMES 	= 0b010,
+	SSD1306_SCROLL_256_FRAMES	= 0b011,
+	SSD1306_SCROLL_3_FRAMES 	= 0b100,
+	SSD1306_SCROLL_4_FRAMES 	= 0b101,
+	SSD1306_SCROLL_25_FRAMES 	= 0b110,
+	SSD1306_SCROLL_2_FRAMES 	= 0b111
+} ssd1306_scroll_frames_t;
+
+/**
+ * @brief SSD1306 scroll types enumerator definition.
+ * 
+ */
+typedef enum ssd1306_scroll_types_e {
+	SSD1306_SCROLL_RIGHT	= 1,
+	SSD1306_SCROLL_LEFT 	= 2,
+	SSD1306_SCROLL_DOWN 	= 3,
+	SSD1306_SCROLL_UP 		= 4,
+	SSD1306_SCROLL_STOP 	= 5
+} ssd1306_scroll_types_t;
+
+/**
+ * @brief SSD1306 panel sizes enumerator definition.
+ * 
+ */
+typedef enum ssd1306_panel_sizes_e {
+	SSD1306_PANEL_128x32  = 0, /*!< 128x32 ssd1306 display */
+	SSD1306_PANEL_128x64  = 1, /*!< 128x64 ssd1306 display */
+	SSD1306_PANEL_128x128 = 2  /*!< 128x128 ssd1327 display */
+} ssd1306_panel_sizes_t;
+
+/**
+ * @brief SSD1306 BDF text alignment within a layout box enumerator.
+ */
+typedef enum ssd1306_bdf_align_e {
+	SSD1306_BDF_ALIGN_LEFT   = 0, /*!< text starts at the left edge of the box */
+	SSD1306_BDF_ALIGN_CENTER = 1, /*!< text is centered in the box */
+	SSD1306_BDF_ALIGN_RIGHT  = 2  /*!< text ends at the right edge of the box */
+} ssd1306_bdf_align_t;
+
+/**
+ * @brief SSD1306 page structure definition.
+ */
+typedef struct ssd1306_page_s {
+	uint8_t segment[SSD1306_PAGE_SEGMENT_SIZE];		/*!< page segment data to display */
+} ssd1306_page_t;
+
+/**
+ * @brief SSD1306 panel structure definition.
+ */
+typedef struct ssd1306_panel_s {
+	ssd1306_panel_sizes_t	panel_size;	/*!< ssd1306 display panel size */
+	uint8_t 				width;		/*!< ssd1306 width of display panel */
+	uint8_t 				height;		/*!< ssd1306 height of display panel */
+	uint8_t 				pages;		/*!< ssd1306 number of pages supported by display panel */
+	bool					remap_supported; /*!< ssd1306 controller supports segment re-map and COM scan direction commands */
+} ssd1306_panel_t;
+
+/**
+ * @brief SSD1306 BDF font structure definition.
+ */
+typedef struct ssd1306_bdf_font_s {
+	uint8_t encoding;
+	uint8_t width;
+	uint8_t bbw;
+	uint8_t bbh;
+	uint8_t bbx;
+	uint8_t bby;
+	uint8_t num_data;
+	uint8_t y_start;
+	uint8_t y_end;
+} ssd1306_bdf_font_t;
+
+/**
+ * @brief SSD1306 BDF font metrics cache structure definition, built once per font by `ssd1306_bdf_metrics_init`.
+ */
+typedef struct ssd1306_bdf_metrics_s {
+	const uint8_t			*font;			/*!< ssd1306 bdf font bitmap data */
+	uint8_t					bbw;			/*!< ssd1306 bdf font bounding box width */
+	uint8_t					bbh;			/*!< ssd1306 bdf font bounding box height */
+	uint16_t				offset[256];	/*!< ssd1306 bdf glyph record offset by encoding, 0 when the font has no glyph */
+	uint8_t					advance[256];	/*!< ssd1306 bdf glyph advance width by encoding */
+} ssd1306_bdf_metrics_t;
+
+/**
+ * @brief SSD1306 BDF kerning pair structure definition.
+ */
+typedef struct ssd1306_bdf_kern_pair_s {
+	uint8_t					left;			/*!< ssd1306 bdf encoding of the left glyph */
+	uint8_t					right;			/*!< ssd1306 bdf encoding of the right glyph */
+	int8_t					adjust;			/*!< ssd1306 bdf advance adjustment in pixels */
+} ssd1306_bdf_kern_pair_t;
+
+/**
+ * @brief SSD1306 BDF text layout structure definition.
+ */
+typedef struct ssd1306_bdf_layout_s {
+	const ssd1306_bdf_metrics_t *metrics;	/*!< ssd1306 bdf font metrics */
+	const ssd1306_bdf_kern_pair_t *kern_pairs; /*!< ssd1306 bdf kerning pairs sorted by left then right glyph, NULL when none */
+	uint16_t				kern_count;		/*!< ssd1306 bdf number of kerning pairs */
+	int8_t					tracking;		/*!< ssd1306 bdf extra pixels added to every glyph advance */
+	int16_t					box_x;			/*!< ssd1306 bdf x-axis position of the clip box */
+	int16_t					box_y;			/*!< ssd1306 bdf y-axis position of the clip box, top of the font bounding box */
+	uint8_t					box_width;		/*!< ssd1306 bdf width of the clip box */
+	uint8_t					box_height;		/*!< ssd1306 bdf height of the clip box */
+	ssd1306_bdf_align_t		align;			/*!< ssd1306 bdf text alignment within the clip box */
+	bool					invert;			/*!< ssd1306 bdf glyph pixels are cleared instead of set when true */
+} ssd1306_bdf_layout_t;
+
+/**
+ * @brief SSD1306 sparse glyph table structure definition, generated by `tools/ssd1306_glyph_pack.py`.
+ */
+typedef struct ssd1306_glyph_table_s {
+	const uint32_t			*code_points;	/*!< ssd1306 glyph unicode code points, sorted ascending */
+	const uint8_t			(*glyphs)[8];	/*!< ssd1306 90 degree transposed 8x8 glyphs in code point order */
+	uint16_t				count;			/*!< ssd1306 number of glyphs in the table */
+} ssd1306_glyph_table_t;
+
+/**
+ * @brief SSD1306 I2C bus statistics structure definition.
+ */
+typedef struct ssd1306_i2c_stats_s {
+	uint32_t				transactions;	/*!< ssd1306 i2c transmit calls, retries included */
+	uint32_t				bytes;			/*!< ssd1306 i2c bytes transmitted by successful transactions */
+	uint32_t				failures;		/*!< ssd1306 i2c failed transmit calls */
+	uint32_t				retries;		/*!< ssd1306 i2c transmit calls repeating a failed transaction */
+	uint64_t				busy_us;		/*!< ssd1306 i2c time spent in transmit calls */
+	uint64_t				window_us;		/*!< ssd1306 i2c time since statistics were reset */
+	uint32_t				latency_max_us;	/*!< ssd1306 i2c longest transmit call */
+	uint32_t				latency_hist[SSD1306_I2C_STATS_LATENCY_BUCKETS]; /*!< ssd1306 i2c log2 histogram of transmit call latency, last bucket is open ended */
+	float					busy_percent;	/*!< ssd1306 i2c share of the window spent in transmit calls */
+	uint32_t				clock_speed;	/*!< ssd1306 i2c scl clock speed in use */
+	uint32_t				clock_fallbacks;/*!< ssd1306 i2c clock step downs since init */
+} ssd1306_i2c_stats_t;
+
+/**
+ * @brief SSD1306 configuration structure definition.
+ */
+typedef struct ssd1306_config_s {
+	uint16_t                    i2c_address;    /*!< ssd1306 i2c device address */
+    uint32_t                    i2c_clock_speed;/*!< ssd1306 i2c device scl clock speed  */
+	ssd1306_panel_sizes_t	    panel_size;		/*!< ssd1306 panel size */
+	uint8_t						offset_x;	    /*!< ssd1306 x-axis offset */
+	bool						flip_enabled;   /*!< ssd1306 displayed information is flipped when true */
+	bool						remap_disabled; /*!< ssd1306 flip reverses page data in software instead of using segment re-map and COM scan direction when true, for modules that ignore re-map commands, the ssd1327 always re-maps */
+	bool						display_enabled;/*!< ssd1306 display is on when true otherwise it is off and sleeping */
+	bool						frame_lock_enabled; /*!< ssd1306 handle is shared between tasks, drawing is scoped by `ssd1306_begin_frame` and `ssd1306_end_frame` when true */
+	bool						clock_negotiation_enabled; /*!< ssd1306 i2c scl clock is probed upward from `i2c_clock_speed` at init and stepped down when errors rise when true */
+} ssd1306_config_t;
+
+/**
+ * @brief SSD1306 4-wire SPI configuration structure definition.
+ */
+typedef struct ssd1306_spi_config_s {
+	int							cs_io_num;		/*!< ssd1306 spi chip select gpio */
+	int							dc_io_num;		/*!< ssd1306 data/command select gpio */
+	int							rst_io_num;		/*!< ssd1306 reset gpio, -1 when not connected */
+	uint32_t					clock_speed_hz;	/*!< ssd1306 spi clock speed */
+} ssd1306_spi_config_t;
+
+/**
+ * @brief SSD1306 context structure definition.
+ */
+typedef struct ssd1306_context_t ssd1306_context_t;
+
+/**
+ * @brief SSD1306 transport structure definition, writes buffers framed with i2c control bytes.
+ */
+typedef struct ssd1306_transport_s {
+	esp_err_t (*write)(ssd1306_context_t *handle, const uint8_t *buffer, const size_t size); /*!< ssd1306 transport write */
+	esp_err_t (*remove)(ssd1306_context_t *handle);												/*!< ssd1306 transport device removal */
+} ssd1306_transport_t;
+
+/**
+ * @brief SSD1306 context structure.
+ */
+struct ssd1306_context_t {
+	ssd1306_config_t 	dev_config;    /*!< ssd1306 device configuration */
+	const ssd1306_transport_t *transport;	/*!< ssd1306 transport of the device */
+    i2c_master_dev_handle_t  i2c_handle;    /*!< ssd1306 i2c device handle */
+	i2c_master_bus_handle_t	i2c_bus_handle;	/*!< ssd1306 i2c master bus handle, the device is re-added on clock changes */
+	uint32_t				i2c_clock_speed;/*!< ssd1306 i2c scl clock speed in use */
+	uint32_t				i2c_clock_fallbacks; /*!< ssd1306 i2c clock step downs since init */
+	uint16_t				i2c_window_count;	/*!< ssd1306 i2c transactions in the fallback error window */
+	uint8_t					i2c_window_errors;	/*!< ssd1306 i2c failed transactions in the fallback error window */
+	ssd1306_spi_config_t	spi_config;		/*!< ssd1306 spi configuration */
+	spi_device_handle_t		spi_handle;		/*!< ssd1306 spi device handle */
+	spi_transaction_t		spi_trans[SSD1306_SPI_MAX_SEGMENTS];	/*!< ssd1306 spi transactions queued per write */
+	uint8_t					*spi_buffer;	/*!< ssd1306 spi dma buffer */
+	size_t					spi_buffer_size;/*!< ssd1306 spi dma buffer size */
+	uint8_t				width;				/*!< ssd1306 width of display panel */
+	uint8_t 			height;				/*!< ssd1306 height display panel */
+	bool				hw_flip;			/*!< ssd1306 flip is handled by segment re-map and COM scan direction when true */
+	bool				scroll_enabled;		/*!< ssd1306 scroll enabled when true */
+	uint8_t				scroll_start;		/*!< ssd1306 start page of scroll */
+	uint8_t				scroll_end;			/*!< ssd1306 end page of scroll */
+	int8_t			    scroll_direction;   /*!< ssd1306 scroll direction */
+	uint8_t				pages;				/*!< ssd1306 number of pages supported by display panel */
+	ssd1306_page_t	    page[16];			/*!< ssd1306 pages of segment data to display */
+	SemaphoreHandle_t	frame_lock;			/*!< ssd1306 frame lock, NULL when the handle is not shared */
+	uint16_t			dirty_pages;		/*!< ssd1306 pages changed since last sent to the panel, one bit per page */
+	uint8_t				dirty_start[16];	/*!< ssd1306 first changed segment by page */
+	uint8_t				dirty_end[16];		/*!< ssd1306 last changed segment by page */
+	uint8_t				*gray_buffer;		/*!< ssd1327 4-bit grayscale frame, 2 pixels per byte row major, NULL for 1-bit panels */
+	uint8_t				gray_level;			/*!< ssd1327 grayscale level (0 to 15) of pixels set by 1-bit drawing */
+	const ssd1306_glyph_table_t *glyph_table;	/*!< ssd1306 glyphs for code points above U+00FF, NULL when not set */
+#if CONFIG_SSD1306_I2C_STATS
+	ssd1306_i2c_stats_t	i2c_stats;			/*!< ssd1306 i2c bus statistics */
+	int64_t				i2c_stats_start_us;	/*!< ssd1306 i2c time statistics were reset */
+#endif
+};
+
+/**
+ * @brief SSD1306 handle stucture definition.
+ */
+typedef struct ssd1306_context_t* ssd1306_handle_t;
+
+/**
+ * @brief SSD1306 flush scheduler structure definition, interleaves dirty page flushes of panels sharing a bus.
+ */
+typedef struct ssd1306_scheduler_s {
+	ssd1306_handle_t	panel[SSD1306_SCHEDULER_MAX_PANELS];	/*!< ssd1306 panels flushed by the scheduler */
+	uint8_t				panel_count;		/*!< ssd1306 number of panels */
+	uint8_t				next_panel;			/*!< ssd1306 round robin index of the panel with the next turn */
+} ssd1306_scheduler_t;
+
+/**
+ * @brief SSD1306 command list structure definition.
+ * 
+ * @note Commands and data are recorded into a caller supplied buffer. Commands
+ * are kept open with single command control bytes so a data stream can follow
+ * in the same I2C transaction, a data stream closes its transaction.
+ */
+typedef struct ssd1306_cmd_list_s {
+	ssd1306_handle_t	handle;			/*!< ssd1306 device handle the list is submitted to */
+	uint8_t				*buffer;		/*!< ssd1306 command list buffer */
+	size_t				size;			/*!< ssd1306 command list buffer size */
+	size_t				length;			/*!< ssd1306 command list bytes recorded */
+	bool				data_open;		/*!< ssd1306 a data stream is open in the current transaction when true */
+	uint8_t				xfer_count;		/*!< ssd1306 number of closed transactions */
+	size_t				xfer_end[SSD1306_CMD_LIST_MAX_XFERS]; /*!< ssd1306 end offset of each transaction */
+	uint16_t			sent_pages;		/*!< ssd1306 pages with recorded segments, their dirty state is cleared once the list is submitted */
+	uint8_t				sent_start[16];	/*!< ssd1306 first recorded segment by page */
+	uint8_t				sent_end[16];	/*!< ssd1306 last recorded segment by page */
+} ssd1306_cmd_list_t;
+
+
+
+/**
+ * public function and subroutine declarations
+ */
+
+/**
+ * @brief Initializes an SSD1306 command list over a caller supplied buffer.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param list SSD1306 command list to initialize.
+ * @param buffer Buffer to record commands and data into.
+ * @param size Size of the buffer, see `SSD1306_CMD_LIST_IMAGE_SIZE` and `SSD1306_CMD_LIST_FRAME_SIZE`.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_cmd_list_init(ssd1306_handle_t handle, ssd1306_cmd_list_t *list, uint8_t *buffer, size_t size);
+
+/**
+ * @brief Discards everything recorded in an SSD1306 command list.
+ * 
+ * @param list SSD1306 command list.
+ */
+void ssd1306_cmd_list_reset(ssd1306_cmd_list_t *list);
+
+/**
+ * @brief Records command bytes into an SSD1306 command list.
+ * 
+ * @param list SSD1306 command list.
+ * @param cmds Command bytes, including command parameters.
+ * @param len Number of command bytes.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_cmd_list_add_command(ssd1306_cmd_list_t *list, const uint8_t *cmds, size_t len);
+
+/**
+ * @brief Records a data segment into an SSD1306 command list.
+ * 
+ * @param list SSD1306 command list.
+ * @param data Data bytes written to display RAM.
+ * @param len Number of data bytes.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_cmd_list_add_data(ssd1306_cmd_list_t *list, const uint8_t *data, size_t len);
+
+/**
+ * @brief Records a contrast change into an SSD1306 command list.
+ * 
+ * @param list SSD1306 command list.
+ * @param contrast Contrast of information being displayed (0 to 255).
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_cmd_list_add_contrast(ssd1306_cmd_list_t *list, uint8_t contrast);
+
+/**
+ * @brief Records an image by page and segment into an SSD1306 command list and sets it to the page buffer.
+ * 
+ * @param list SSD1306 command list.
+ * @param page Index of page.
+ * @param segment Index of segment data.
+ * @param image Image data.
+ * @param width Width of the image.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_cmd_list_add_image(ssd1306_cmd_list_t *list, uint8_t page, uint8_t segment, const uint8_t *image, uint8_t width);
+
+/**
+ * @brief Records segment data for each page of the SSD1306 display panel as one addressing window.
+ * 
+ * @param list SSD1306 command list.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_cmd_list_add_pages(ssd1306_cmd_list_t *list);
+
+/**
+ * @brief Submits an SSD1306 command list, one I2C transaction per recorded data stream, and resets it.
+ * 
+ * @param list SSD1306 command list.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_cmd_list_submit(ssd1306_cmd_list_t *list);
+
+/**
+ * @brief Loads a BDF bitmap font and BDF font structure from a font file.
+ * 
+ * @param[in] font BDF font bitmap data.
+ * @param[in] encoding BDF font encoding.
+ * @param[out] bitmap BDF font bitmap data.
+ * @param[out] bdf_font BDF font structure.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_load_bitmap_font(const uint8_t *font, int encoding, uint8_t *bitmap, ssd1306_bdf_font_t *const bdf_font);
+
+/**
+ * @brief Sets the sparse glyph table used by text functions for code points above U+00FF.
+ * 
+ * @note Text is decoded as UTF-8, code points U+0000 to U+00FF use the built-in latin font and
+ * code points missing from both are drawn as '?'.  The table must outlive the handle.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param glyph_table Sparse glyph table, NULL to use the built-in latin font only.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_set_glyph_table(ssd1306_handle_t handle, const ssd1306_glyph_table_t *glyph_table);
+
+/**
+ * @brief Displays text on the SSD1306 with BDF font support.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param font BDF font bitmap data.
+ * @param text Text characters to display.
+ * @param xpos X-axis position of the font character.
+ * @param ypos Y-axis position of the font character.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_display_bdf_text(ssd1306_handle_t handle, const uint8_t *font, const char *text, int xpos, int ypos);
+
+/**
+ * @brief Displays BDF font code on the SSD1306.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param font BDF font bitmap data.
+ * @param code BDF font code to display.
+ * @param xpos X-axis position of the font character.
+ * @param ypos Y-axis position of the font character.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_display_bdf_code(ssd1306_handle_t handle, const uint8_t *font, int code, int xpos, int ypos);
+
+/**
+ * @brief Builds the metrics cache of a BDF font, glyph records are indexed once so layout never scans the font.
+ * 
+ * @param font BDF font bitmap data.
+ * @param metrics BDF font metrics cache.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_bdf_metrics_init(const uint8_t *font, ssd1306_bdf_metrics_t *metrics);
+
+/**
+ * @brief Measures the width of UTF-8 text laid out with a BDF font, kerning and tracking included.
+ * 
+ * @note Only cached metrics are read, glyph bitmap data is never touched.
+ * 
+ * @param layout BDF text layout.
+ * @param text UTF-8 text, code points above U+00FF have no glyph.
+ * @param width Width of the text in pixels.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_measure_bdf_text(const ssd1306_bdf_layout_t *layout, const char *text, uint16_t *const width);
+
+/**
+ * @brief Sets SSD1306 pages and segments data for UTF-8 text laid out with a BDF font in a clip box.
+ * 
+ * @note Glyphs are aligned, kerned and clipped to the layout box and the panel in a single pass, text
+ * that does not fit is cut at the box edge.  Call `ssd1306_flush` to display the text.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param layout BDF text layout.
+ * @param text UTF-8 text, code points above U+00FF have no glyph.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_set_bdf_text(ssd1306_handle_t handle, const ssd1306_bdf_layout_t *layout, const char *text);
+
+/**
+ * @brief Turns SSD1306 display panel on.
+ * 
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_enable_display(ssd1306_handle_t handle);
+
+/**
+ * @brief Turns SSD1306 display panel off (sleep mode).
+ * 
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_disable_display(ssd1306_handle_t handle);
+
+/**
+ * @brief Displays segment data for each page supported by the SSD1306 display panel.
+ * 
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_display_pages(ssd1306_handle_t handle);
+
+/**
+ * @brief Displays only the page segments changed since they were last sent to the SSD1306 display panel.
+ * 
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_flush(ssd1306_handle_t handle);
+
+/**
+ * @brief Initializes an SSD1306 flush scheduler without panels.
+ * 
+ * @param scheduler SSD1306 flush scheduler.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_scheduler_init(ssd1306_scheduler_t *scheduler);
+
+/**
+ * @brief Adds an SSD1306 panel to a flush scheduler, panels typically share one I2C bus.
+ * 
+ * @param scheduler SSD1306 flush scheduler.
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_scheduler_add_panel(ssd1306_scheduler_t *scheduler, ssd1306_handle_t handle);
+
+/**
+ * @brief Flushes the changed pages of every scheduled panel in round robin turns of one page.
+ * 
+ * @note Panels whose frame lock is held by another task are skipped until a later round,
+ * the flush returns when a full round makes no progress.  Panels whose frame is held by
+ * the calling task are flushed, the scheduler may run inside the caller's own frame.
+ * 
+ * @param scheduler SSD1306 flush scheduler.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_scheduler_flush(ssd1306_scheduler_t *scheduler);
+
+/**
+ * @brief Sets segment data for each page supported by the SSD1306 display panel.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param buffer Segment data in 128-byte blocks by page.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_set_pages(ssd1306_handle_t handle, uint8_t *buffer);
+
+/**
+ * @brief Gets segment data for each page supported by the SSD1306 display panel.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param buffer Segment data in 128-byte blocks by page.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_get_pages(ssd1306_handle_t handle, uint8_t *buffer);
+
+/**
+ * @brief Sets SSD1306 pages and segments data for a pixel.
+ * 
+ * @note Call `ssd1306_display_pages` to display the pixel.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param xpos X-axis position of the pixel.
+ * @param ypos Y-axis position of the pixel.
+ * @param invert Pixel is inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_set_pixel(ssd1306_handle_t handle, uint8_t xpos, uint8_t ypos, bool invert);
+
+/**
+ * @brief Sets the grayscale level used by 1-bit drawing, fonts and icons on an SSD1327 display panel.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param level Grayscale level (0 to 15).
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_set_gray_level(ssd1306_handle_t handle, uint8_t level);
+
+/**
+ * @brief Sets the grayscale level of a pixel on an SSD1327 display panel.
+ * 
+ * @note Call `ssd1306_flush` to display the pixel.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param xpos X-axis position of the pixel.
+ * @param ypos Y-axis position of the pixel.
+ * @param level Grayscale level (0 to 15).
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_SUPPORTED on 1-bit panels.
+ */
+esp_err_t ssd1306_set_gray_pixel(ssd1306_handle_t handle, uint8_t xpos, uint8_t ypos, uint8_t level);
+
+/**
+ * @brief Sets SSD1306 pages and segments data for a line.
+ * 
+ * @note Call `ssd1306_display_pages` to display the line.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param x1 X-axis start position of the line.
+ * @param y1 Y-axis start position of the line.
+ * @param x2 X-axis end position of the line.
+ * @param y2 Y-axis end position of the line.
+ * @param invert Line is inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_set_line(ssd1306_handle_t handle, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool invert);
+
+/**
+ * @brief Sets SSD1306 pages and segments data for a circle.
+ * 
+ * @note Call `ssd1306_display_pages` to display the circle.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param x0 X-axis start position of the circle.
+ * @param y0 Y-axis start position of the circle.
+ * @param r Radius of the circle.
+ * @param invert Circle is inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_set_circle(ssd1306_handle_t handle, uint8_t x0, uint8_t y0, uint8_t r, bool invert);
+
+/**
+ * @brief Sets SSD1306 pages and segments data for a circle and display's the circle.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param x0 X-axis start position of the circle.
+ * @param y0 Y-axis start position of the circle.
+ * @param r Radius of the circle.
+ * @param invert Circle is inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_display_circle(ssd1306_handle_t handle, uint8_t x0, uint8_t y0, uint8_t r, bool invert);
+
+/**
+ * @brief Sets SSD1306 pages and segments data for a filled circle and display's the filled circle.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param x0 X-axis start position of the circle.
+ * @param y0 Y-axis start position of the circle.
+ * @param r Radius of the circle.
+ * @param invert Circle is inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_display_filled_circle(ssd1306_handle_t handle, uint8_t x0, uint8_t y0, uint8_t r, bool invert);
+
+/**
+ * @brief Sets SSD1306 pages and segments data for a rectangle.
+ * 
+ * @note Call `ssd1306_display_pages` to display the rectangle.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param x X-axis start position of the rectangle.
+ * @param y Y-axis start position of the rectangle.
+ * @param w Width of the rectangle.
+ * @param h Height of the rectangle.
+ * @param invert Rectangle is inverted when true.
+ * @return esp_err_t 
+ */
+esp_err_t ssd1306_set_rectangle(ssd1306_handle_t handle, uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool invert);
+
+/**
+ * @brief Sets SSD1306 pages and segments data for a rectangle and display's the rectangle.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param x X-axis start position of the rectangle.
+ * @param y Y-axis start position of the rectangle.
+ * @param w Width of the rectangle.
+ * @param h Height of the rectangle.
+ * @param invert Rectangle is inverted when true.
+ * @return esp_err_t 
+ */
+esp_err_t ssd1306_display_rectangle(ssd1306_handle_t handle, uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool invert);
+
+/**
+ * @brief Sets SSD1306 pages and segments data for a filled rectangle and display's the filled rectangle.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param x X-axis start position of the rectangle.
+ * @param y Y-axis start position of the rectangle.
+ * @param w Width of the rectangle.
+ * @param h Height of the rectangle.
+ * @param invert Rectangle is inverted when true.
+ * @return esp_err_t 
+ */
+esp_err_t ssd1306_display_filled_rectangle(ssd1306_handle_t handle, uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool invert);
+
+/**
+ * @brief Sets contrast of the SSD1306 display panel.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param contrast Contrast of information being displayed (0 to 255).
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_set_contrast(ssd1306_handle_t handle, uint8_t contrast);
+
+/**
+ * @brief Sets SSD1306 pages and segments data for a bitmap.
+ * 
+ * @note Call `ssd1306_display_pages` to display the bitmap.
+ *  
+ * @param handle SSD1306 device handle.
+ * @param xpos X-axis position of the bitmap.
+ * @param ypos Y-axis position of the bitmap.
+ * @param bitmap Bitmap data.
+ * @param width Width of the bitmap.
+ * @param height Height of the bitmap
+ * @param invert Bitmap is inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_set_bitmap(ssd1306_handle_t handle, uint8_t xpos, uint8_t ypos, const uint8_t *bitmap, uint8_t width, uint8_t height, bool invert);
+
+/**
+ * @brief Displays a bitmap on the SSD1306.
+ * 
+ * @note Image to byte converter: https://mischianti.org/images-to-byte-array-online-converter-cpp-arduino/
+ * 
+ * @param handle SSD1306 device handle.
+ * @param xpos X-axis position of the bitmap.
+ * @param ypos Y-axis position of the bitmap.
+ * @param bitmap Bitmap data.
+ * @param width Width of the bitmap.
+ * @param height Height of the bitmap
+ * @param invert Bitmap is inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_display_bitmap(ssd1306_handle_t handle, uint8_t xpos, uint8_t ypos, const uint8_t *bitmap, uint8_t width, uint8_t height, bool invert);
+
+/**
+ * @brief Sets SSD1306 pages and segments data for a page-major, run-length compressed image.
+ * 
+ * @note Images are packed on the host with `tools/ssd1306_rle_pack.py`, see `bitmap_icon_rle.h`.
+ * The image is opaque, every pixel of its rectangle is replaced, and it is clipped to the panel.
+ * Call `ssd1306_flush` to display the image.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param xpos X-axis position of the image.
+ * @param ypos Y-axis position of the image, page aligned positions are stored without shifting.
+ * @param rle Run-length compressed image data.
+ * @param invert Image is inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_set_rle_image(ssd1306_handle_t handle, uint8_t xpos, uint8_t ypos, const uint8_t *rle, bool invert);
+
+/**
+ * @brief Displays a page-major, run-length compressed image on the SSD1306.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param xpos X-axis position of the image.
+ * @param ypos Y-axis position of the image.
+ * @param rle Run-length compressed image data.
+ * @param invert Image is inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_display_rle_image(ssd1306_handle_t handle, uint8_t xpos, uint8_t ypos, const uint8_t *rle, bool invert);
+
+/**
+ * @brief Displays an image by page and segment on the SSD1306.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param page Index of page.
+ * @param segment Index of segment data.
+ * @param image Image data.
+ * @param width Width of the image.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_display_image(ssd1306_handle_t handle, uint8_t page, uint8_t segment, const uint8_t *image, uint8_t width);
+
+/**
+ * @brief Sets text by page in the page buffer with a maximum of 16-characters, changed segments are sent by `ssd1306_flush`.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param page Index of page.
+ * @param text UTF-8 text characters (16 characters maximum) to set.
+ * @param invert Text is inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_set_text(ssd1306_handle_t handle, uint8_t page, const char *text, bool invert);
+
+/**
+ * @brief Displays text by page on the SSD1306 with a maximum of 16-characters.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param page Index of page.
+ * @param text UTF-8 text characters (16 characters maximum) to display.
+ * @param invert Text is inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_display_text(ssd1306_handle_t handle, uint8_t page, const char *text, bool invert);
+
+/**
+ * @brief Sets text x2 larger by page in the page buffer, changed segments are sent by `ssd1306_flush`.
+ * 
+ * @note Text uses 2-pages with a maximum of 8-characters.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param page Index of page.
+ * @param text UTF-8 text characters (8 characters maximum) to set.
+ * @param invert Text is inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_set_text_x2(ssd1306_handle_t handle, uint8_t page, const char *text, bool invert);
+
+/**
+ * @brief Displays text x2 larger by page on the SSD1306.
+ * 
+ * @note Text displayed uses 2-pages with a maximum of 8-characters.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param page Index of page.
+ * @param text UTF-8 text characters (8 characters maximum) to display.
+ * @param invert Text is inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_display_text_x2(ssd1306_handle_t handle, uint8_t page, const char *text, bool invert);
+
+/**
+ * @brief Sets text x3 larger by page in the page buffer, changed segments are sent by `ssd1306_flush`.
+ * 
+ * @note Text uses 3-pages with a maximum of 5 characters.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param page Index of page.
+ * @param text UTF-8 text characters (5 characters maximum) to set.
+ * @param invert Text is inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_set_text_x3(ssd1306_handle_t handle, uint8_t page, const char *text, bool invert);
+
+/**
+ * @brief Displays text x3 larger by page on the SSD1306.
+ * 
+ * @note Text displayed uses 3-pages with a maximum of 5 characters.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param page Index of page.
+ * @param text UTF-8 text characters (5 characters maximum) to display.
+ * @param invert Text is inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_display_text_x3(ssd1306_handle_t handle, uint8_t page, const char *text, bool invert);
+
+/**
+ * @brief Displays scrolling text within a box as banner by page and segment on the SSD1306 with a maximum of 100-characters.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param page Index of page.
+ * @param seg Index of segment data.
+ * @param text UTF-8 text characters (100 characters maximum) to display.
+ * @param box_width Width of the box.
+ * @param invert Text is inverted when true.
+ * @param delay Delay in milliseconds before information is displayed, a value 0 there is no wait.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_display_textbox_banner(ssd1306_handle_t handle, uint8_t page, uint8_t segment, const char *text, uint8_t box_width, bool invert, uint8_t delay);
+
+/**
+ * @brief Displays scrolling text within a box as a ticker by page and segment on the SSD1306 with a maximum of 100-characters.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param page Index of page.
+ * @param seg Index of segment data.
+ * @param text UTF-8 text characters (100 characters maximum) to display.
+ * @param box_width Width of the box.
+ * @param invert Text is inverted when true.
+ * @param delay Delay in milliseconds before information is displayed, a value 0 there is no wait.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_display_textbox_ticker(ssd1306_handle_t handle, uint8_t page, uint8_t segment, const char *text, uint8_t box_width, bool invert, uint8_t delay);
+
+/**
+ * @brief Clears a page from the SSD1306 display.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param page Index of page to clear from the display.
+ * @param invert Background is inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_clear_display_page(ssd1306_handle_t handle, uint8_t page, bool invert);
+
+/**
+ * @brief Clears the page buffer, changed segments are sent by `ssd1306_flush`.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param invert Background is inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_clear_pages(ssd1306_handle_t handle, bool invert);
+
+/**
+ * @brief Clears the entire SSD1306 display.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param invert Background is inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_clear_display(ssd1306_handle_t handle, bool invert);
+
+/**
+ * @brief Sets SSD1306 scroll orientation and frame frequency for hardware based scrolling text.
+ * 
+ * @note Call `i2c_ssd1306_display_text` to display hardware based scrolling text.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param scroll Scrolling orientation.
+ * @param frame_frequency Frame rate of scrolling text.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_set_hardware_scroll(ssd1306_handle_t handle, ssd1306_scroll_types_t scroll, ssd1306_scroll_frames_t frame_frequency);
+
+/**
+ * @brief Sets SSD1306 start and end page for software based scrolling text.
+ * 
+ * @note Call `i2c_ssd1306_display_scroll_text` to display software based scrolling text.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param start Index of start page.
+ * @param end Index of end page.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_set_software_scroll(ssd1306_handle_t handle, uint8_t start, uint8_t end);
+
+/**
+ * @brief Displays software based scrolling text on the SSD1306.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param text UTF-8 text characters (16 characters maximum) to display.
+ * @param invert Text is inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_display_software_scroll_text(ssd1306_handle_t handle, const char *text, bool invert);
+
+/**
+ * @brief Clears software based scrolling text from SSD1306 display.
+ * 
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_clear_display_software_scroll(ssd1306_handle_t handle);
+
+/**
+ * @brief Sets SSD1306 scroll orientation, start and end pages to wrap around the display.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param scroll Scrolling orientation.
+ * @param start Index of page for left or right scroll, otherwise, height position for up or down scroll.
+ * @param end Index of page for left or right scroll, otherwise, height position for up or down scroll.
+ * @param delay Delay in milliseconds (0-255) before information is displayed, a value 0 there is no wait, and nothing is displayed with a value of -1.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_display_wrap_around(ssd1306_handle_t handle, ssd1306_scroll_types_t scroll, uint8_t start, uint8_t end, int8_t delay);
+
+/**
+ * @brief Copies bit from source to destination.
+ * 
+ * @param src 
+ * @param src_bits 
+ * @param dst 
+ * @param dst_bits 
+ * @return uint8_t 
+ */
+uint8_t ssd1306_copy_bit(uint8_t src, uint8_t src_bits, uint8_t dst, uint8_t dst_bits);
+
+/**
+ * @brief Inverts the buffer data.
+ * 
+ * @param buf Buffer data.
+ * @param blen Length of buffer data.
+ */
+void ssd1306_invert_buffer(uint8_t *buf, size_t blen);
+
+/**
+ * @brief Flips the buffer data (upsidedown).
+ * 
+ * @param buf Buffer data.
+ * @param blen Length of buffer data.
+ */
+void ssd1306_flip_buffer(uint8_t *buf, size_t blen);
+
+/**
+ * @brief Rotates 8-bits, as an example, 0x12 becomes 0x48.
+ * 
+ * @param ch1 8-bit value to rotate.
+ * @return uint8_t rotated 8-bit value.
+ */
+uint8_t ssd1306_rotate_byte(uint8_t ch1);
+
+/**
+ * @brief SSD1306 display is faded out and cleared.
+ * 
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_display_fadeout(ssd1306_handle_t handle);
+
+/**
+ * @brief Initializes an SSD1306 device onto the I2C master bus.
+ *
+ * @param[in] master_handle I2C master bus handle.
+ * @param[in] ssd1306_config SSD1306 device configuration.
+ * @param[out] ssd1306_handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_init(i2c_master_bus_handle_t master_handle, const ssd1306_config_t *ssd1306_config, ssd1306_handle_t *ssd1306_handle);
+
+/**
+ * @brief Begins an SSD1306 frame, takes the frame lock of a shared handle.
+ * 
+ * @note Drawing primitives do not lock, every access to a shared handle must be
+ * scoped between `ssd1306_begin_frame` and `ssd1306_end_frame`. This is a no-op
+ * when `frame_lock_enabled` is false.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param timeout_ms Maximum time to wait for the frame lock in milliseconds.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_TIMEOUT when another task holds the frame.
+ */
+esp_err_t ssd1306_begin_frame(ssd1306_handle_t handle, uint32_t timeout_ms);
+
+/**
+ * @brief Ends an SSD1306 frame, releases the frame lock of a shared handle.
+ * 
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE when the calling task does not hold the frame.
+ */
+esp_err_t ssd1306_end_frame(ssd1306_handle_t handle);
+
+/**
+ * @brief Initializes an SSD1306 device onto a 4-wire SPI bus.
+ * 
+ * @note The SPI bus is initialized by the caller with `spi_bus_initialize` and DMA enabled.
+ *
+ * @param[in] host SPI host the bus was initialized on.
+ * @param[in] spi_config SSD1306 SPI pins and clock configuration.
+ * @param[in] ssd1306_config SSD1306 device configuration, i2c fields are ignored.
+ * @param[out] ssd1306_handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_spi_init(spi_host_device_t host, const ssd1306_spi_config_t *spi_config, const ssd1306_config_t *ssd1306_config, ssd1306_handle_t *ssd1306_handle);
+
+/**
+ * @brief Removes an SSD1306 device from master bus.
+ *
+ * @param[in] handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_remove(ssd1306_handle_t handle);
+
+/**
+ * @brief Removes an SSD1306 device from master bus and frees handle.
+ * 
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_delete(ssd1306_handle_t handle);
+
+/**
+ * @brief Gets the I2C scl clock speed in use by an SSD1306 device, the negotiated speed when clock negotiation is enabled.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param clock_speed I2C scl clock speed in Hz.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_get_i2c_clock_speed(ssd1306_handle_t handle, uint32_t *const clock_speed);
+
+/**
+ * @brief Reads the I2C bus statistics of an SSD1306 device and computes the bus busy percentage.
+ * 
+ * @note Requires `CONFIG_SSD1306_I2C_STATS`.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param stats I2C bus statistics.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_SUPPORTED when statistics are compiled out.
+ */
+esp_err_t ssd1306_get_i2c_stats(ssd1306_handle_t handle, ssd1306_i2c_stats_t *stats);
+
+/**
+ * @brief Clears the I2C bus statistics of an SSD1306 device and starts a new window.
+ * 
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_SUPPORTED when statistics are compiled out.
+ */
+esp_err_t ssd1306_reset_i2c_stats(ssd1306_handle_t handle);
+
+/**
+ * @brief Prints the I2C bus statistics of an SSD1306 device to the console.
+ * 
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_SUPPORTED when statistics are compiled out.
+ */
+esp_err_t ssd1306_dump_i2c_stats(ssd1306_handle_t handle);
+
+/**
+ * @brief Converts SSD1306 firmware version numbers (major, minor, patch) into a string.
+ * 
+ * @return char* SSD1306 firmware version as a string that is formatted as X.X.X (e.g. 4.0.0).
+ */
+const char* ssd1306_get_fw_version(void);
+
+/**
+ * @brief Converts SSD1306 firmware version numbers (major, minor, patch) into an integer value.
+ * 
+ * @return int32_t SSD1306 firmware version number.
+ */
+int32_t ssd1306_get_fw_version_number(void);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif /* __SSD1306_H__ */
\ No newline at end of file
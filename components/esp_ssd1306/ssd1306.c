@@ -0,0 +1,3058 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file ssd1306.c
+ *
+ * ESP-IDF driver for SSD1306 display panel
+ *
+ * Ported from esp-open-rtos
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+
+#include "include/ssd1306.h"
+#include "include/font_latin_8x8.h"
+#include <string.h>
+#include <esp_log.h>
+#include <esp_check.h>
+#include <esp_attr.h>
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <inttypes.h>
+#if CONFIG_SSD1306_I2C_STATS
+#include <stdio.h>
+#include <esp_timer.h>
+#endif
+
+// Following definitions are borrowed from 
+// http://robotcantalk.blogspot.com/2015/03/interfacing-arduino-with-ssd1306-driven.html
+// https://github.com/nopnop2002/esp-idf-ssd1306/tree/master/components/ssd1306
+
+/* Control byte for i2c
+Co : bit 8 : Continuation Bit 
+ * 1 = no-continuation (only one byte to follow) 
+ * 0 = the controller should expect a stream of bytes. 
+D/C# : bit 7 : Data/Command Select bit 
+ * 1 = the next byte or byte stream will be Data. 
+ * 0 = a Command byte or byte stream will be coming up next. 
+ Bits 6-0 will be all zeros. 
+Usage: 
+0x80 : Single Command byte 
+0x00 : Command Stream 
+0xC0 : Single Data byte 
+0x40 : Data Stream
+*/
+#define SSD1306_CONTROL_BYTE_CMD_SINGLE    0x80		// Continuation bit=1, D/C=0; 1000 0000
+#define SSD1306_CONTROL_BYTE_CMD_STREAM    0x00		// Continuation bit=0, D/C=0; 0000 0000
+#define SSD1306_CONTROL_BYTE_DATA_SINGLE   0xC0		// Continuation bit=1, D/C=1; 1100 0000
+#define SSD1306_CONTROL_BYTE_DATA_STREAM   0x40		// Continuation bit=0, D/C=1; 0100 0000
+
+// Fundamental commands (pg.28)
+#define SSD1306_CMD_SET_CONTRAST           0x81     // Set Contrast Control, Double byte command to select 1 to 256 contrast steps, increases as the value increases
+#define SSD1306_CMD_DISPLAY_RAM            0xA4		// Entire Display ON, Output ignores RAM content
+#define SSD1306_CMD_DISPLAY_ALLON          0xA5		// Resume to RAM content display, Output follows RAM content
+#define SSD1306_CMD_DISPLAY_NORMAL         0xA6		// Normal display, 0 in RAM: OFF in display panel, 1 in RAM: ON in display panel
+#define SSD1306_CMD_DISPLAY_INVERTED       0xA7		// Inverse display, 0 in RAM: ON in display panel, 1 in RAM: OFF in display panel
+#define SSD1306_CMD_DISPLAY_OFF            0xAE		// Display OFF (sleep mode)
+#define SSD1306_CMD_DISPLAY_ON             0xAF		// Display ON in normal mode
+
+// Addressing Command Table (pg.30)
+#define SSD1306_CMD_SET_MEMORY_ADDR_MODE   0x20    // Set Memory Addressing Mode
+#define SSD1306_CMD_SET_HORI_ADDR_MODE     0x00    // Horizontal Addressing Mode
+#define SSD1306_CMD_SET_VERT_ADDR_MODE     0x01    // Vertical Addressing Mode
+#define SSD1306_CMD_SET_PAGE_ADDR_MODE     0x02    // Page Addressing Mode
+#define SSD1306_CMD_SET_COLUMN_RANGE       0x21    // can be used only in HORZ/VERT mode - follow with 0x00 and 0x7F = COL127
+#define SSD1306_CMD_SET_PAGE_RANGE         0x22    // can be used only in HORZ/VERT mode - follow with 0x00 and 0x07 = PAGE7
+
+// Hardware Config (pg.31)
+#define SSD1306_CMD_SET_DISPLAY_START_LINE 0x40
+#define SSD1306_CMD_SET_SEGMENT_REMAP_0    0xA0		// Set Segment Re-map, X[0]=0b column address 0 is mapped to SEG0    
+#define SSD1306_CMD_SET_SEGMENT_REMAP_1    0xA1    	// Set Segment Re-map, X[0]=1b: column address 127 is mapped to SEG0
+#define SSD1306_CMD_SET_MUX_RATIO          0xA8		// Set MUX ratio to N+1 MUX, N=A[5:0] : from 32MUX, 64MUX, and 128MUX
+#define SSD1306_CMD_SET_COM_SCAN_NORMAL    0xC0		// Set COM Output Scan Direction, normal mode, scan from COM0 to COM[N-1]
+#define SSD1306_CMD_SET_COM_SCAN_REMAP     0xC8		// Set COM Output Scan Direction, remapped mode, scan from COM[N-1] to COM0
+#define SSD1306_CMD_SET_DISPLAY_OFFSET     0xD3    	// follow with 0x00
+#define SSD1306_CMD_SET_COM_PIN_MAP        0xDA    	// Set COM Pins Hardware Configuration,
+													// A[4]=0b, Sequential COM pin configuration, A[4]=1b(RESET), Alternative COM pin configuration
+                                          			// A[5]=0b(RESET), Disable COM Left/Right remap, A[5]=1b, Enable COM Left/Right remap 
+#define SSD1306_CMD_NOP                    0xE3    	// No operation
+
+// Timing and Driving Scheme (pg.32)
+#define SSD1306_CMD_SET_DISPLAY_CLK_DIV    0xD5    // follow with 0x80
+#define SSD1306_CMD_SET_PRECHARGE          0xD9    // follow with 0xF1
+#define SSD1306_CMD_SET_VCOMH_DESELCT      0xDB    // follow with 0x30
+
+// Charge Pump (pg.62)
+#define SSD1306_CMD_SET_CHARGE_PUMP        0x8D    // follow with 0x14
+
+// Scrolling Command
+#define SSD1306_CMD_HORIZONTAL_RIGHT       0x26
+#define SSD1306_CMD_HORIZONTAL_LEFT        0x27
+#define SSD1306_CMD_CONTINUOUS_SCROLL      0x29
+#define SSD1306_CMD_DEACTIVE_SCROLL        0x2E
+#define SSD1306_CMD_ACTIVE_SCROLL          0x2F
+#define SSD1306_CMD_VERTICAL               0xA3
+
+// SSD1327 grayscale commands (pg.33)
+#define SSD1327_CMD_SET_COLUMN_RANGE       0x15		// follow with start and end column, 2 pixels per column
+#define SSD1327_CMD_SET_ROW_RANGE          0x75		// follow with start and end row
+#define SSD1327_CMD_SET_REMAP              0xA0		// follow with re-map and dual COM line mode
+#define SSD1327_CMD_SET_START_LINE         0xA1		// follow with 0x00
+#define SSD1327_CMD_SET_DISPLAY_OFFSET     0xA2		// follow with 0x00
+#define SSD1327_CMD_SET_FUNCTION_A         0xAB		// follow with 0x01 to enable internal VDD regulator
+#define SSD1327_CMD_SET_PHASE_LENGTH       0xB1		// follow with 0xF1
+#define SSD1327_CMD_SET_CLK_DIV            0xB3		// follow with 0x00
+#define SSD1327_CMD_SET_PRECHARGE2         0xB6		// follow with 0x0F
+#define SSD1327_CMD_SET_PRECHARGE_VOLTAGE  0xBC		// follow with 0x08
+#define SSD1327_CMD_SET_VCOMH              0xBE		// follow with 0x0F
+#define SSD1327_CMD_SET_FUNCTION_B         0xD5		// follow with 0x62
+#define SSD1327_CMD_SET_COMMAND_LOCK       0xFD		// follow with 0x12 to unlock
+#define SSD1327_REMAP_NORMAL               0x51		// column and COM re-map, COM split odd even
+#define SSD1327_REMAP_FLIPPED              0x42		// nibble re-map, COM split odd even, rotated 180 degrees
+
+#define SSD1327_ROW_BYTES                  (SSD1306_PANEL_128x128_WIDTH / 2)	// 4-bit pixels, 2 per byte
+
+#define SSD1306_TEXTBOX_DISPLAY_MAX_LEN	   50
+#define SSD1306_TEXT_DISPLAY_MAX_LEN	   18
+#define SSD1306_TEXT_X2_DISPLAY_MAX_LEN	   8
+#define SSD1306_TEXT_X3_DISPLAY_MAX_LEN	   5
+
+/*
+ * macro definitions
+*/
+#define ESP_ARG_CHECK(VAL) do { if (!(VAL)) return ESP_ERR_INVALID_ARG; } while (0)
+#define PACK8 __attribute__((aligned( __alignof__( uint8_t ) ), packed ))
+
+/*
+* static constant declarations
+*/
+static const char *TAG = "ssd1306";
+
+/**
+ * @brief SSD1306 panel properties for each display panel size supported.
+ */
+static const ssd1306_panel_t ssd1306_panel_properties[] = {
+	{ .panel_size = SSD1306_PANEL_128x32, .width = SSD1306_PANEL_128x32_WIDTH, .height = SSD1306_PANEL_128x32_HEIGHT, .pages = SSD1306_PAGE_128x32_SIZE, .remap_supported = true },
+	{ .panel_size = SSD1306_PANEL_128x64, .width = SSD1306_PANEL_128x64_WIDTH, .height = SSD1306_PANEL_128x64_HEIGHT, .pages = SSD1306_PAGE_128x64_SIZE, .remap_supported = true },
+	{ .panel_size = SSD1306_PANEL_128x128, .width = SSD1306_PANEL_128x128_WIDTH, .height = SSD1306_PANEL_128x128_HEIGHT, .pages = SSD1306_PAGE_128x128_SIZE, .remap_supported = true }
+};
+
+typedef union ssd1306_out_column_t {
+	uint32_t u32;
+	uint8_t  u8[4];
+} PACK8 ssd1306_out_column_t;
+
+
+/**
+ * @brief I2C scl clock speeds probed by clock negotiation, ascending.
+ */
+static const uint32_t ssd1306_i2c_clock_speeds[] = {
+	I2C_SSD1306_DEV_CLK_SPD,
+	I2C_SSD1306_DEV_CLK_SPD_FAST,
+	I2C_SSD1306_DEV_CLK_SPD_FAST_PLUS
+};
+
+/**
+ * @brief Re-adds the SSD1306 device to the master bus with a new scl clock speed.
+ * 
+ * @note When the device can not be added at the new speed it is re-added at the previous one
+ * so the handle stays usable, the error is still returned.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param clock_speed I2C scl clock speed in Hz.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t ssd1306_i2c_set_clock_speed(ssd1306_handle_t handle, uint32_t clock_speed) {
+	esp_err_t ret;
+	i2c_device_config_t i2c_dev_conf = {
+        .dev_addr_length    = I2C_ADDR_BIT_LEN_7,
+        .device_address     = handle->dev_config.i2c_address,
+        .scl_speed_hz       = clock_speed,
+    };
+
+	if (handle->i2c_handle) {
+		ESP_RETURN_ON_ERROR(i2c_master_bus_rm_device(handle->i2c_handle), TAG, "i2c remove device for clock change failed");
+		handle->i2c_handle = NULL;
+	}
+
+	ret = i2c_master_bus_add_device(handle->i2c_bus_handle, &i2c_dev_conf, &handle->i2c_handle);
+	if (ret != ESP_OK) {
+		handle->i2c_handle = NULL;
+
+		/* a fresh error window, later writes do not retry the failed change on every transaction */
+		handle->i2c_window_count = 0;
+		handle->i2c_window_errors = 0;
+
+		/* keep the device on the bus at the speed it had, none before the first add */
+		i2c_dev_conf.scl_speed_hz = handle->i2c_clock_speed;
+		if (handle->i2c_clock_speed && i2c_master_bus_add_device(handle->i2c_bus_handle, &i2c_dev_conf, &handle->i2c_handle) != ESP_OK) {
+			handle->i2c_handle = NULL;
+			ESP_LOGE(TAG, "i2c re-add device at %" PRIu32 " Hz failed, device is off the bus", handle->i2c_clock_speed);
+		}
+
+		ESP_RETURN_ON_ERROR(ret, TAG, "i2c add device for clock change failed");
+	}
+
+	handle->i2c_clock_speed = clock_speed;
+	handle->i2c_window_count = 0;
+	handle->i2c_window_errors = 0;
+
+	return ESP_OK;
+}
+
+/**
+ * @brief Counts a transmit result in the fallback error window and steps the negotiated clock down when errors rise.
+ * 
+ * @param handle SSD1306 device handle with clock negotiation enabled.
+ * @param result Result of the transmit call.
+ * @return bool True when the clock was stepped down.
+ */
+static bool ssd1306_i2c_track_clock(ssd1306_handle_t handle, esp_err_t result) {
+	if (result != ESP_OK) handle->i2c_window_errors++;
+
+	if (handle->i2c_window_errors >= I2C_CLK_FALLBACK_ERRORS) {
+		/* next slower probed speed, none below the lowest */
+		for (int8_t i = (int8_t)(sizeof(ssd1306_i2c_clock_speeds) / sizeof(ssd1306_i2c_clock_speeds[0])) - 1; i >= 0; i--) {
+			if (ssd1306_i2c_clock_speeds[i] < handle->i2c_clock_speed) {
+				ESP_LOGW(TAG, "i2c errors rising at %" PRIu32 " Hz, falling back to %" PRIu32 " Hz", handle->i2c_clock_speed, ssd1306_i2c_clock_speeds[i]);
+				if (ssd1306_i2c_set_clock_speed(handle, ssd1306_i2c_clock_speeds[i]) != ESP_OK) return false;
+				handle->i2c_clock_fallbacks++;
+				return true;
+			}
+		}
+	}
+
+	if (++handle->i2c_window_count >= I2C_CLK_FALLBACK_WINDOW) {
+		handle->i2c_window_count = 0;
+		handle->i2c_window_errors = 0;
+	}
+
+	return false;
+}
+
+#if CONFIG_SSD1306_I2C_STATS
+/**
+ * @brief Records one I2C transmit call into the bus statistics.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param size Length of buffer transmitted.
+ * @param latency_us Duration of the transmit call.
+ * @param result Result of the transmit call.
+ * @param retry Transmit call repeats a failed transaction when true.
+ */
+static inline void ssd1306_i2c_stats_record(ssd1306_handle_t handle, size_t size, uint32_t latency_us, esp_err_t result, bool retry) {
+	ssd1306_i2c_stats_t *stats = &handle->i2c_stats;
+	uint8_t bucket = (latency_us > 1) ? (uint8_t)(31 - __builtin_clz(latency_us)) : 0;
+
+	if (bucket >= SSD1306_I2C_STATS_LATENCY_BUCKETS) bucket = SSD1306_I2C_STATS_LATENCY_BUCKETS - 1;
+
+	stats->transactions++;
+	if (result == ESP_OK) {
+		stats->bytes += size;
+	} else {
+		stats->failures++;
+	}
+	if (retry) stats->retries++;
+	stats->busy_us += latency_us;
+	if (latency_us > stats->latency_max_us) stats->latency_max_us = latency_us;
+	stats->latency_hist[bucket]++;
+}
+#endif
+
+/**
+ * @brief SSD1306 I2C write transaction.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param buffer Buffer to write for write transaction.
+ * @param size Length of buffer to write for write transaction.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t ssd1306_i2c_write(ssd1306_handle_t handle, const uint8_t *buffer, const size_t size) {
+	esp_err_t ret;
+	uint8_t attempt = 0;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( handle );
+
+	/* a failed clock change leaves no device when it can not be re-added */
+	if (handle->i2c_handle == NULL) return ESP_ERR_INVALID_STATE;
+
+    /* attempt i2c write transaction, repeated on failure */
+	for (uint8_t xfer = 0; ; xfer++) {
+#if CONFIG_SSD1306_I2C_STATS
+		const int64_t start_us = esp_timer_get_time();
+#endif
+		ret = i2c_master_transmit(handle->i2c_handle, buffer, size, I2C_XFR_TIMEOUT_MS);
+#if CONFIG_SSD1306_I2C_STATS
+		ssd1306_i2c_stats_record(handle, size, (uint32_t)(esp_timer_get_time() - start_us), ret, xfer > 0);
+#endif
+		const bool fell_back = handle->dev_config.clock_negotiation_enabled && ssd1306_i2c_track_clock(handle, ret);
+		if (ret == ESP_OK) break;
+		/* the fallback could not re-add the device at either clock */
+		if (handle->i2c_handle == NULL) return ESP_ERR_INVALID_STATE;
+		/* a slower clock gets a fresh set of retries */
+		if (fell_back) attempt = 0;
+		else if (++attempt > I2C_XFR_RETRIES) break;
+	}
+
+    ESP_RETURN_ON_ERROR( ret, TAG, "i2c_master_transmit, i2c write failed" );
+                        
+    return ESP_OK;
+}
+
+/**
+ * @brief SSD1306 I2C device removal from master bus.
+ * 
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t ssd1306_i2c_remove(ssd1306_handle_t handle) {
+	if (handle->i2c_handle == NULL) return ESP_OK;
+
+	return i2c_master_bus_rm_device(handle->i2c_handle);
+}
+
+/**
+ * @brief SSD1306 SPI pre-transfer callback, drives the D/C line from the transaction user field.
+ * 
+ * @param trans SPI transaction about to start.
+ */
+static void IRAM_ATTR ssd1306_spi_pre_transfer_cb(spi_transaction_t *trans) {
+	uint32_t user = (uint32_t)(uintptr_t)trans->user;
+
+	/* user field packs the d/c gpio (bits 31-1) and level (bit 0) */
+	gpio_set_level((gpio_num_t)(user >> 1), user & 0x01);
+}
+
+/**
+ * @brief SSD1306 SPI write transaction.
+ * 
+ * @note Buffers are framed with I2C control bytes by the drawing code. The
+ * control bytes are decoded into command and data runs, each run is copied
+ * into the DMA buffer and queued as one SPI transaction with the matching D/C
+ * level.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param buffer Buffer to write for write transaction.
+ * @param size Length of buffer to write for write transaction.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t ssd1306_spi_write(ssd1306_handle_t handle, const uint8_t *buffer, const size_t size) {
+	spi_transaction_t *trans = handle->spi_trans;
+	spi_transaction_t *result;
+	uint8_t seg_count = 0;
+	size_t index = 0;
+	size_t out_index = 0;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( handle && buffer );
+
+	/* decoded runs never exceed the framed buffer */
+	if (size > handle->spi_buffer_size) return ESP_ERR_INVALID_SIZE;
+
+	memset(trans, 0, sizeof(spi_transaction_t) * SSD1306_SPI_MAX_SEGMENTS);
+
+	while (index < size) {
+		uint8_t control = buffer[index++];
+		uint32_t dc = (control & SSD1306_CONTROL_BYTE_DATA_STREAM) ? 1 : 0;
+		size_t len = (control & SSD1306_CONTROL_BYTE_CMD_SINGLE) ? 1 : size - index;
+
+		if (index + len > size) return ESP_ERR_INVALID_SIZE;
+
+		/* start a new run when the d/c level changes */
+		if (seg_count == 0 || ((uint32_t)(uintptr_t)trans[seg_count - 1].user & 0x01) != dc) {
+			if (seg_count >= SSD1306_SPI_MAX_SEGMENTS) return ESP_ERR_INVALID_SIZE;
+			trans[seg_count].tx_buffer = &handle->spi_buffer[out_index];
+			trans[seg_count].user = (void *)(uintptr_t)(((uint32_t)handle->spi_config.dc_io_num << 1) | dc);
+			seg_count++;
+		}
+
+		memcpy(&handle->spi_buffer[out_index], &buffer[index], len);
+		trans[seg_count - 1].length += len * 8;
+		out_index += len;
+		index += len;
+	}
+
+	/* queue every run before waiting so dma transfers go back to back */
+	for (uint8_t seg = 0; seg < seg_count; seg++) {
+		ESP_RETURN_ON_ERROR( spi_device_queue_trans(handle->spi_handle, &trans[seg], portMAX_DELAY), TAG, "spi_device_queue_trans, spi write failed" );
+	}
+
+	for (uint8_t seg = 0; seg < seg_count; seg++) {
+		ESP_RETURN_ON_ERROR( spi_device_get_trans_result(handle->spi_handle, &result, portMAX_DELAY), TAG, "spi_device_get_trans_result, spi write failed" );
+	}
+
+	return ESP_OK;
+}
+
+/**
+ * @brief SSD1306 SPI device removal from bus.
+ * 
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t ssd1306_spi_remove(ssd1306_handle_t handle) {
+	return spi_bus_remove_device(handle->spi_handle);
+}
+
+/**
+ * @brief SSD1306 transports, indexed by `ssd1306_transport_types_t`.
+ */
+static const ssd1306_transport_t ssd1306_transports[] = {
+	{ .write = ssd1306_i2c_write, .remove = ssd1306_i2c_remove },
+	{ .write = ssd1306_spi_write, .remove = ssd1306_spi_remove }
+};
+
+/**
+ * @brief SSD1306 write transaction through the transport of the handle.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param buffer Buffer, framed with control bytes, to write for write transaction.
+ * @param size Length of buffer to write for write transaction.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t ssd1306_write(ssd1306_handle_t handle, const uint8_t *buffer, const size_t size) {
+    /* validate arguments */
+    ESP_ARG_CHECK( handle );
+
+	return handle->transport->write(handle, buffer, size);
+}
+
+
+/**
+ * @brief Marks a segment range of a page as changed since it was last sent to the panel.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param page Index of page.
+ * @param start Index of first changed segment.
+ * @param end Index of last changed segment.
+ */
+static inline void ssd1306_mark_dirty(ssd1306_handle_t handle, uint8_t page, uint8_t start, uint8_t end) {
+	uint16_t mask = (uint16_t)(1U << page);
+
+	if (handle->dirty_pages & mask) {
+		if (start < handle->dirty_start[page]) handle->dirty_start[page] = start;
+		if (end > handle->dirty_end[page]) handle->dirty_end[page] = end;
+	} else {
+		handle->dirty_pages |= mask;
+		handle->dirty_start[page] = start;
+		handle->dirty_end[page] = end;
+	}
+}
+
+/**
+ * @brief Marks every page segment of the panel as changed.
+ * 
+ * @param handle SSD1306 device handle.
+ */
+static inline void ssd1306_mark_dirty_all(ssd1306_handle_t handle) {
+	for (uint8_t page = 0; page < handle->pages; page++) {
+		ssd1306_mark_dirty(handle, page, 0, handle->width - 1);
+	}
+}
+
+/**
+ * @brief Clears the changed state of a page when the segments sent cover its dirty range.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param page Index of page.
+ * @param start Index of first segment sent.
+ * @param end Index of last segment sent.
+ */
+static inline void ssd1306_clear_dirty(ssd1306_handle_t handle, uint8_t page, uint8_t start, uint8_t end) {
+	uint16_t mask = (uint16_t)(1U << page);
+
+	if ((handle->dirty_pages & mask) && start <= handle->dirty_start[page] && end >= handle->dirty_end[page]) {
+		handle->dirty_pages &= ~mask;
+	}
+}
+
+/**
+ * @brief Records page segments sent by a command list, their dirty state is cleared once the list is submitted.
+ * 
+ * @note A second range that does not touch the recorded one is not kept, the page stays dirty and is resent.
+ * 
+ * @param list SSD1306 command list.
+ * @param page Index of page.
+ * @param start Index of first segment sent.
+ * @param end Index of last segment sent.
+ */
+static inline void ssd1306_cmd_list_mark_sent(ssd1306_cmd_list_t *list, uint8_t page, uint8_t start, uint8_t end) {
+	uint16_t mask = (uint16_t)(1U << page);
+
+	if (!(list->sent_pages & mask)) {
+		list->sent_pages |= mask;
+		list->sent_start[page] = start;
+		list->sent_end[page]   = end;
+	} else if (start <= list->sent_end[page] + 1 && end + 1 >= list->sent_start[page]) {
+		if (start < list->sent_start[page]) list->sent_start[page] = start;
+		if (end > list->sent_end[page]) list->sent_end[page] = end;
+	}
+}
+
+/**
+ * @brief Closes the open transaction of a command list, the next record starts a new transaction.
+ * 
+ * @param list SSD1306 command list.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t ssd1306_cmd_list_close_xfer(ssd1306_cmd_list_t *list) {
+	if (list->xfer_count > 0 && list->xfer_end[list->xfer_count - 1] == list->length) return ESP_OK;
+	if (list->xfer_count >= SSD1306_CMD_LIST_MAX_XFERS) return ESP_ERR_INVALID_SIZE;
+
+	list->xfer_end[list->xfer_count++] = list->length;
+	list->data_open = false;
+
+	return ESP_OK;
+}
+
+/**
+ * @brief Expands 1-bit page segment data into the 4-bit grayscale buffer of an SSD1327 panel.
+ * 
+ * @note Two columns are expanded per byte, each pair of bits selects one of four nibble pairs.
+ * 
+ * @param handle SSD1306 device handle with a grayscale buffer.
+ * @param page Index of page.
+ * @param start Index of first segment, aligned down to an even column.
+ * @param end Index of last segment, aligned up to an odd column.
+ */
+static void ssd1327_expand_page(ssd1306_handle_t handle, uint8_t page, uint8_t start, uint8_t end) {
+	const uint8_t fg = handle->gray_level & 0x0F;
+	const uint8_t lut[4] = { 0x00, fg, (uint8_t)(fg << 4), (uint8_t)((fg << 4) | fg) };
+	const uint8_t *seg = handle->page[page].segment;
+
+	start &= ~0x01;
+	end |= 0x01;
+
+	for (uint8_t bit = 0; bit < 8; bit++) {
+		uint8_t *row = &handle->gray_buffer[((page * 8) + bit) * SSD1327_ROW_BYTES];
+		for (uint16_t x = start; x <= end; x += 2) {
+			row[x >> 1] = lut[(((seg[x] >> bit) & 0x01) << 1) | ((seg[x + 1] >> bit) & 0x01)];
+		}
+	}
+}
+
+/**
+ * @brief Expands every page of an SSD1327 panel after page segment data was written directly, no-op on 1-bit panels.
+ * 
+ * @param handle SSD1306 device handle.
+ */
+static inline void ssd1327_expand_pages(ssd1306_handle_t handle) {
+	if (handle->gray_buffer == NULL) return;
+
+	for (uint8_t page = 0; page < handle->pages; page++) {
+		ssd1327_expand_page(handle, page, 0, handle->width - 1);
+	}
+}
+
+/**
+ * @brief Writes segment data into a page, only the segments that change are marked dirty.
+ * 
+ * @note Grayscale panels are marked and expanded over the whole range, the 1-bit page does not hold their levels.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param page Index of page.
+ * @param segment Index of first segment.
+ * @param data Segment data to write.
+ * @param width Number of segments.
+ */
+static void ssd1306_write_segments(ssd1306_handle_t handle, uint8_t page, uint8_t segment, const uint8_t *data, uint8_t width) {
+	uint8_t *dst = &handle->page[page].segment[segment];
+	int16_t first = -1;
+	int16_t last = -1;
+
+	for (uint8_t i = 0; i < width; i++) {
+		if (dst[i] != data[i] || handle->gray_buffer) {
+			if (first < 0) first = i;
+			last = i;
+			dst[i] = data[i];
+		}
+	}
+
+	if (first < 0) return;
+
+	ssd1306_mark_dirty(handle, page, segment + first, segment + last);
+	if (handle->gray_buffer) {
+		ssd1327_expand_page(handle, page, segment + first, segment + last);
+	}
+}
+
+/**
+ * @brief Records a grayscale window of an SSD1327 panel into a command list.
+ * 
+ * @param list SSD1306 command list.
+ * @param x0 X-axis start position, aligned down to an even column.
+ * @param y0 Y-axis start position.
+ * @param x1 X-axis end position, aligned up to an odd column.
+ * @param y1 Y-axis end position.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t ssd1327_cmd_list_add_window(ssd1306_cmd_list_t *list, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+	ssd1306_handle_t handle = list->handle;
+	uint8_t col0 = x0 >> 1;
+	uint8_t col1 = x1 >> 1;
+	uint8_t col_offset = handle->dev_config.offset_x >> 1;
+	size_t row_len = col1 - col0 + 1;
+
+	const uint8_t cmds[] = {
+		SSD1327_CMD_SET_COLUMN_RANGE, (uint8_t)(col0 + col_offset), (uint8_t)(col1 + col_offset),
+		SSD1327_CMD_SET_ROW_RANGE, y0, y1
+	};
+
+	if (list->length + (sizeof(cmds) * 2) + 1 + (row_len * (y1 - y0 + 1)) > list->size) return ESP_ERR_INVALID_SIZE;
+
+	ESP_RETURN_ON_ERROR(ssd1306_cmd_list_add_command(list, cmds, sizeof(cmds)), TAG, "command list window addressing failed");
+
+	list->buffer[list->length++] = SSD1306_CONTROL_BYTE_DATA_STREAM;
+	list->data_open = true;
+
+	for (uint16_t y = y0; y <= y1; y++) {
+		memcpy(&list->buffer[list->length], &handle->gray_buffer[(y * SSD1327_ROW_BYTES) + col0], row_len);
+		list->length += row_len;
+	}
+
+	/* pages fully covered by the window are clean once submitted */
+	for (uint16_t page = (y0 + 7) / 8; (page * 8) + 7 <= y1; page++) {
+		ssd1306_cmd_list_mark_sent(list, page, col0 * 2, (col1 * 2) + 1);
+	}
+
+	return ssd1306_cmd_list_close_xfer(list);
+}
+
+/**
+ * @brief Sends a grayscale window of an SSD1327 panel.
+ * 
+ * @param handle SSD1306 device handle with a grayscale buffer.
+ * @param x0 X-axis start position.
+ * @param y0 Y-axis start position.
+ * @param x1 X-axis end position.
+ * @param y1 Y-axis end position.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t ssd1327_display_window(ssd1306_handle_t handle, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+	esp_err_t ret = ESP_OK;
+	ssd1306_cmd_list_t list;
+	size_t out_size = SSD1327_CMD_LIST_WINDOW_SIZE(x1 - x0 + 2, y1 - y0 + 1);
+
+	uint8_t *out_buf = malloc(out_size);
+	if (out_buf == NULL) {
+		ESP_LOGE(TAG, "malloc for grayscale window failed");
+		return ESP_ERR_NO_MEM;
+	}
+
+	ESP_GOTO_ON_ERROR(ssd1306_cmd_list_init(handle, &list, out_buf, out_size), err, TAG, "command list init for grayscale window failed");
+	ESP_GOTO_ON_ERROR(ssd1327_cmd_list_add_window(&list, x0 & ~0x01, y0, x1 | 0x01, y1), err, TAG, "command list grayscale window failed");
+	ESP_GOTO_ON_ERROR(ssd1306_cmd_list_submit(&list), err, TAG, "write grayscale window failed");
+
+	err:
+		free(out_buf);
+		return ret;
+}
+
+esp_err_t ssd1306_cmd_list_init(ssd1306_handle_t handle, ssd1306_cmd_list_t *list, uint8_t *buffer, size_t size) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle && list && buffer && size );
+
+	list->handle = handle;
+	list->buffer = buffer;
+	list->size   = size;
+
+	ssd1306_cmd_list_reset(list);
+
+	return ESP_OK;
+}
+
+void ssd1306_cmd_list_reset(ssd1306_cmd_list_t *list) {
+	list->length     = 0;
+	list->xfer_count = 0;
+	list->data_open  = false;
+	list->sent_pages = 0;
+}
+
+esp_err_t ssd1306_cmd_list_add_command(ssd1306_cmd_list_t *list, const uint8_t *cmds, size_t len) {
+	/* validate parameters */
+	ESP_ARG_CHECK( list && cmds );
+
+	/* a data stream runs to the end of its transaction, commands start a new one */
+	if (list->data_open) {
+		ESP_RETURN_ON_ERROR(ssd1306_cmd_list_close_xfer(list), TAG, "command list transaction limit reached");
+	}
+
+	if (list->length + (len * 2) > list->size) return ESP_ERR_INVALID_SIZE;
+
+	/* single command control bytes keep the transaction open for a trailing data stream */
+	for (size_t i = 0; i < len; i++) {
+		list->buffer[list->length++] = SSD1306_CONTROL_BYTE_CMD_SINGLE;
+		list->buffer[list->length++] = cmds[i];
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_cmd_list_add_data(ssd1306_cmd_list_t *list, const uint8_t *data, size_t len) {
+	/* validate parameters */
+	ESP_ARG_CHECK( list && data );
+
+	size_t hdr = list->data_open ? 0 : 1;
+
+	if (list->length + hdr + len > list->size) return ESP_ERR_INVALID_SIZE;
+
+	if (!list->data_open) {
+		list->buffer[list->length++] = SSD1306_CONTROL_BYTE_DATA_STREAM;
+		list->data_open = true;
+	}
+
+	memcpy(&list->buffer[list->length], data, len);
+	list->length += len;
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_cmd_list_add_contrast(ssd1306_cmd_list_t *list, uint8_t contrast) {
+	const uint8_t cmds[] = { SSD1306_CMD_SET_CONTRAST, contrast };
+
+	return ssd1306_cmd_list_add_command(list, cmds, sizeof(cmds));
+}
+
+esp_err_t ssd1306_cmd_list_add_image(ssd1306_cmd_list_t *list, uint8_t page, uint8_t segment, const uint8_t *image, uint8_t width) {
+	/* validate parameters */
+	ESP_ARG_CHECK( list && image );
+
+	ssd1306_handle_t handle = list->handle;
+
+	if (page >= handle->pages) return ESP_ERR_INVALID_SIZE;
+	if (segment >= handle->width) return ESP_ERR_INVALID_SIZE;
+	if (segment + width > handle->width) return ESP_ERR_INVALID_SIZE;
+
+	/* grayscale panels expand the image and send it as a row and column window */
+	if (handle->gray_buffer) {
+		memmove(&handle->page[page].segment[segment], image, width);
+		ssd1327_expand_page(handle, page, segment, segment + width - 1);
+		return ssd1327_cmd_list_add_window(list, segment & ~0x01, page * 8, (segment + width - 1) | 0x01, (page * 8) + 7);
+	}
+
+	/* software flip is only used when the controller cannot re-map segments and COM scan direction */
+	bool sw_flip = handle->dev_config.flip_enabled && !handle->hw_flip;
+
+	uint8_t _seg = segment + handle->dev_config.offset_x;
+	uint8_t _page = page;
+	if (sw_flip) {
+		_seg  = (handle->width - segment - width) + handle->dev_config.offset_x;
+		_page = (handle->pages - page) - 1;
+	}
+
+	const uint8_t cmds[] = {
+		(0x00 + (_seg & 0x0F)),			// Set Lower Column Start Address for Page Addressing Mode
+		(0x10 + ((_seg >> 4) & 0x0F)),	// Set Higher Column Start Address for Page Addressing Mode
+		(0xB0 | _page)					// Set Page Start Address for Page Addressing Mode
+	};
+
+	if (list->length + (sizeof(cmds) * 2) + 1 + width > list->size) return ESP_ERR_INVALID_SIZE;
+
+	ESP_RETURN_ON_ERROR(ssd1306_cmd_list_add_command(list, cmds, sizeof(cmds)), TAG, "command list page addressing for image failed");
+
+	list->buffer[list->length++] = SSD1306_CONTROL_BYTE_DATA_STREAM;
+	list->data_open = true;
+
+	if (sw_flip) {
+		for (uint8_t i = 0; i < width; i++) {
+			list->buffer[list->length++] = ssd1306_rotate_byte(image[width - i - 1]);
+		}
+	} else {
+		memcpy(&list->buffer[list->length], image, width);
+		list->length += width;
+	}
+
+	/* page segment data may be the image source */
+	memmove(&handle->page[page].segment[segment], image, width);
+	ssd1306_cmd_list_mark_sent(list, page, segment, segment + width - 1);
+
+	/* page addressing commands can not follow the data stream */
+	return ssd1306_cmd_list_close_xfer(list);
+}
+
+esp_err_t ssd1306_cmd_list_add_pages(ssd1306_cmd_list_t *list) {
+	/* validate parameters */
+	ESP_ARG_CHECK( list );
+
+	ssd1306_handle_t handle = list->handle;
+	bool sw_flip = handle->dev_config.flip_enabled && !handle->hw_flip;
+	uint8_t col_start = handle->dev_config.offset_x;
+
+	/* a grayscale frame is 4 times larger, use dirty windows instead */
+	if (handle->gray_buffer) return ESP_ERR_NOT_SUPPORTED;
+
+	/* horizontal addressing over the panel window streams every page in one data transfer */
+	const uint8_t cmds[] = {
+		SSD1306_CMD_SET_MEMORY_ADDR_MODE, SSD1306_CMD_SET_HORI_ADDR_MODE,
+		SSD1306_CMD_SET_COLUMN_RANGE, col_start, (uint8_t)(col_start + handle->width - 1),
+		SSD1306_CMD_SET_PAGE_RANGE, 0x00, (uint8_t)(handle->pages - 1)
+	};
+	const uint8_t restore[] = { SSD1306_CMD_SET_MEMORY_ADDR_MODE, SSD1306_CMD_SET_PAGE_ADDR_MODE };
+	size_t frame_len = (size_t)handle->pages * handle->width;
+
+	if (list->length + ((sizeof(cmds) + sizeof(restore)) * 2) + 1 + frame_len > list->size) return ESP_ERR_INVALID_SIZE;
+
+	ESP_RETURN_ON_ERROR(ssd1306_cmd_list_add_command(list, cmds, sizeof(cmds)), TAG, "command list addressing window for pages failed");
+
+	list->buffer[list->length++] = SSD1306_CONTROL_BYTE_DATA_STREAM;
+	list->data_open = true;
+
+	if (sw_flip) {
+		/* reversing the whole frame rotates it 180 degrees */
+		for (int8_t page = handle->pages - 1; page >= 0; page--) {
+			for (int16_t seg = handle->width - 1; seg >= 0; seg--) {
+				list->buffer[list->length++] = ssd1306_rotate_byte(handle->page[page].segment[seg]);
+			}
+		}
+	} else {
+		for (uint8_t page = 0; page < handle->pages; page++) {
+			memcpy(&list->buffer[list->length], handle->page[page].segment, handle->width);
+			list->length += handle->width;
+		}
+	}
+
+	for (uint8_t page = 0; page < handle->pages; page++) {
+		ssd1306_cmd_list_mark_sent(list, page, 0, handle->width - 1);
+	}
+
+	/* return to page addressing for the page based drawing functions */
+	return ssd1306_cmd_list_add_command(list, restore, sizeof(restore));
+}
+
+esp_err_t ssd1306_cmd_list_submit(ssd1306_cmd_list_t *list) {
+	esp_err_t ret = ESP_OK;
+	size_t start = 0;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( list );
+
+	if (list->length > 0) {
+		ESP_GOTO_ON_ERROR(ssd1306_cmd_list_close_xfer(list), err, TAG, "command list transaction limit reached");
+	}
+
+	for (uint8_t xfer = 0; xfer < list->xfer_count; xfer++) {
+		ESP_GOTO_ON_ERROR(ssd1306_write(list->handle, &list->buffer[start], list->xfer_end[xfer] - start), err, TAG, "write command list transaction %d failed", xfer);
+		start = list->xfer_end[xfer];
+	}
+
+	/* recorded segments reached the panel, a failed list leaves them dirty for the next flush */
+	for (uint8_t page = 0; page < 16; page++) {
+		if (list->sent_pages & (1U << page)) {
+			ssd1306_clear_dirty(list->handle, page, list->sent_start[page], list->sent_end[page]);
+		}
+	}
+
+	err:
+		ssd1306_cmd_list_reset(list);
+		return ret;
+}
+
+esp_err_t ssd1306_load_bitmap_font(const uint8_t *font, int encoding, uint8_t *bitmap, ssd1306_bdf_font_t *const bdf_font) {
+	ESP_LOGI(TAG, "encoding=%d", encoding);
+	int index = 2;
+	while (1) {
+		ESP_LOGD(TAG, "font[%d]=%d size=%d", index, font[index], font[index+6]);
+		if (font[index+6] == 0) break;
+		if (font[index] == encoding) {
+			bdf_font->encoding = font[index];
+			bdf_font->width = font[index+1];
+			bdf_font->bbw = font[index+2];
+			bdf_font->bbh = font[index+3];
+			bdf_font->bbx = font[index+4];
+			bdf_font->bby = font[index+5];
+			bdf_font->num_data = font[index+6];
+			bdf_font->y_start = font[index+7];
+			bdf_font->y_end = font[index+8];
+			for (int i=0;i<font[index+6];i++) {
+				ESP_LOGD(TAG, "font[%d]=0x%x", index+9+i, font[index+9+i]);
+				bitmap[i] = font[index+9+i];
+			}
+			return ESP_OK;
+		}
+		index = index + font[index+6] + 9;;
+	} // end while
+	return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t ssd1306_display_bdf_text(ssd1306_handle_t handle, const uint8_t *font, const char *text, int xpos, int ypos) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	if (strnlen(text, SSD1306_TEXT_DISPLAY_MAX_LEN + 1) > SSD1306_TEXT_DISPLAY_MAX_LEN) return ESP_ERR_INVALID_SIZE;
+
+	int fontboundingbox_width = font[0];
+	int fontboundingbox_height = font[1];
+	size_t bitmap_size = ((fontboundingbox_width + 7) / 8) * fontboundingbox_height;
+	ESP_LOGD(TAG, "fontboundingbox_width=%d fontboundingbox_height=%d bitmap_size=%d",
+		fontboundingbox_width, fontboundingbox_height, bitmap_size);
+	uint8_t *bitmap = malloc(bitmap_size);
+	if (bitmap == NULL) {
+		ESP_LOGE(TAG, "malloc fail");
+		return ESP_ERR_NO_MEM;
+	}
+	ssd1306_bdf_font_t bdf_font;
+	int _xpos = xpos;
+	for (int i=0;i<strnlen(text, SSD1306_TEXT_DISPLAY_MAX_LEN);i++) {
+		memset(bitmap, 0, bitmap_size);
+		int ch = text[i];
+		esp_err_t err = ssd1306_load_bitmap_font(font, ch, bitmap, &bdf_font);
+		if (err != ESP_OK) {
+			ESP_LOGE(TAG, "font not found [%d]", ch);
+			continue;
+		}
+		//ESP_LOG_BUFFER_HEXDUMP(tag, bitmap, bdf_font.num_data, ESP_LOG_INFO);
+		ESP_LOGD(TAG, "bdf_font.width=%d", bdf_font.width);
+		ESP_LOGD(TAG, "bdf_font.bbx=%d, bby=%d", bdf_font.bbx, bdf_font.bby);
+		ESP_LOGD(TAG, "bdf_font.y_start=%d, y_end=%d", bdf_font.y_start, bdf_font.y_end);
+		int bitmap_height = bdf_font.y_end - bdf_font.y_start + 1;
+		int bitmap_width = bdf_font.num_data / bitmap_height;
+		ESP_LOGD(TAG, "bitmap_width=%d bitmap_height=%d", bitmap_width, bitmap_height);
+		ssd1306_set_bitmap(handle, _xpos, ypos+bdf_font.y_start, bitmap, bitmap_width*8, bitmap_height, false);
+		_xpos = _xpos + bdf_font.width;
+	}
+	ESP_RETURN_ON_ERROR(ssd1306_display_pages(handle), TAG, "display pages for display bdf text failed");
+	free(bitmap);
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_display_bdf_code(ssd1306_handle_t handle, const uint8_t *font, int code, int xpos, int ypos) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	int fontboundingbox_width = font[0];
+	int fontboundingbox_height = font[1];
+	size_t bitmap_size = ((fontboundingbox_width + 7) / 8) * fontboundingbox_height;
+	ESP_LOGD(TAG, "fontboundingbox_width=%d fontboundingbox_height=%d bitmap_size=%d",
+		fontboundingbox_width, fontboundingbox_height, bitmap_size);
+	uint8_t *bitmap = malloc(bitmap_size);
+	if (bitmap == NULL) {
+		ESP_LOGE(TAG, "malloc fail");
+		return ESP_ERR_NO_MEM;
+	}
+	ssd1306_bdf_font_t bdf_font;
+	memset(bitmap, 0, bitmap_size);
+	esp_err_t err = ssd1306_load_bitmap_font(font, code, bitmap, &bdf_font);
+	if (err != ESP_OK) {
+		ESP_LOGE(TAG, "font not found [%d]", code);
+		return err;
+	}
+	//ESP_LOG_BUFFER_HEXDUMP(tag, bitmap, bdf_font.num_data, ESP_LOG_INFO);
+	ESP_LOGD(TAG, "bdf_font.width=%d", bdf_font.width);
+	ESP_LOGD(TAG, "bdf_font.bbx=%d, bby=%d", bdf_font.bbx, bdf_font.bby);
+	ESP_LOGD(TAG, "bdf_font.y_start=%d, y_end=%d", bdf_font.y_start, bdf_font.y_end);
+	int bitmap_height = bdf_font.y_end - bdf_font.y_start + 1;
+	int bitmap_width = bdf_font.num_data / bitmap_height;
+	ESP_LOGD(TAG, "bitmap_width=%d bitmap_height=%d", bitmap_width, bitmap_height);
+	ESP_LOG_BUFFER_HEXDUMP(TAG, bitmap, bdf_font.num_data, ESP_LOG_DEBUG);
+	ssd1306_display_bitmap(handle, xpos, ypos+bdf_font.y_start, bitmap, bitmap_width*8, bitmap_height, false);
+	free(bitmap);
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_set_pixel(ssd1306_handle_t handle, uint8_t xpos, uint8_t ypos, bool invert) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+    if (
+		xpos >= handle->width ||
+		ypos >= handle->height
+	) {
+		/* Error */
+		return ESP_ERR_INVALID_SIZE;
+	}
+
+	uint8_t _page = (ypos / 8);
+	uint8_t _bits = (ypos % 8);
+	uint8_t _seg = xpos;
+	uint8_t wk0 = handle->page[_page].segment[_seg];
+	uint8_t wk1 = 1 << _bits;
+
+	ESP_LOGD(TAG, "ypos=%d _page=%d _bits=%d wk0=0x%02x wk1=0x%02x", ypos, _page, _bits, wk0, wk1);
+
+	if (invert) {
+		wk0 = wk0 & ~wk1;
+	} else {
+		wk0 = wk0 | wk1;
+	}
+
+	ESP_LOGD(TAG, "wk0=0x%02x wk1=0x%02x", wk0, wk1);
+
+	handle->page[_page].segment[_seg] = wk0;
+	ssd1306_mark_dirty(handle, _page, _seg, _seg);
+
+	if (handle->gray_buffer) {
+		uint8_t *px = &handle->gray_buffer[(ypos * SSD1327_ROW_BYTES) + (xpos >> 1)];
+		uint8_t level = invert ? 0x00 : (handle->gray_level & 0x0F);
+		*px = (xpos & 0x01) ? ((*px & 0xF0) | level) : ((*px & 0x0F) | (level << 4));
+	}
+
+	return ESP_OK;
+}
+
+
+esp_err_t ssd1306_set_gray_level(ssd1306_handle_t handle, uint8_t level) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle && level <= 0x0F );
+
+	handle->gray_level = level;
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_set_gray_pixel(ssd1306_handle_t handle, uint8_t xpos, uint8_t ypos, uint8_t level) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle && level <= 0x0F );
+
+	if (handle->gray_buffer == NULL) return ESP_ERR_NOT_SUPPORTED;
+
+	if (xpos >= handle->width || ypos >= handle->height) return ESP_ERR_INVALID_SIZE;
+
+	uint8_t *px = &handle->gray_buffer[(ypos * SSD1327_ROW_BYTES) + (xpos >> 1)];
+	*px = (xpos & 0x01) ? ((*px & 0xF0) | level) : ((*px & 0x0F) | (level << 4));
+
+	/* keep the 1-bit page view in step for readers such as get pages */
+	if (level) {
+		handle->page[ypos / 8].segment[xpos] |= (1 << (ypos % 8));
+	} else {
+		handle->page[ypos / 8].segment[xpos] &= ~(1 << (ypos % 8));
+	}
+	ssd1306_mark_dirty(handle, ypos / 8, xpos, xpos);
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_set_line(ssd1306_handle_t handle, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1,  bool invert) {
+	int16_t dx, dy, sx, sy, err, e2, i, tmp; 
+
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	/* Check for overflow */
+	if (x0 >= handle->width) {
+		x0 = handle->width - 1;
+	}
+	if (x1 >= handle->width) {
+		x1 = handle->width - 1;
+	}
+	if (y0 >= handle->height) {
+		y0 = handle->height - 1;
+	}
+	if (y1 >= handle->height) {
+		y1 = handle->height - 1;
+	}
+	
+	dx = (x0 < x1) ? (x1 - x0) : (x0 - x1); 
+	dy = (y0 < y1) ? (y1 - y0) : (y0 - y1); 
+	sx = (x0 < x1) ? 1 : -1; 
+	sy = (y0 < y1) ? 1 : -1; 
+	err = ((dx > dy) ? dx : -dy) / 2; 
+
+	if (dx == 0) {
+		if (y1 < y0) {
+			tmp = y1;
+			y1 = y0;
+			y0 = tmp;
+		}
+		
+		if (x1 < x0) {
+			tmp = x1;
+			x1 = x0;
+			x0 = tmp;
+		}
+		
+		/* Vertical line */
+		for (i = y0; i <= y1; i++) {
+			ssd1306_set_pixel(handle, x0, i, invert);
+		}
+		
+		/* Return from function */
+		return ESP_OK;
+	}
+	
+	if (dy == 0) {
+		if (y1 < y0) {
+			tmp = y1;
+			y1 = y0;
+			y0 = tmp;
+		}
+		
+		if (x1 < x0) {
+			tmp = x1;
+			x1 = x0;
+			x0 = tmp;
+		}
+		
+		/* Horizontal line */
+		for (i = x0; i <= x1; i++) {
+			ssd1306_set_pixel(handle, i, y0, invert);
+		}
+		
+		/* Return from function */
+		return ESP_OK;
+	}
+	
+	while (1) {
+		ssd1306_set_pixel(handle, x0, y0, invert);
+		if (x0 == x1 && y0 == y1) {
+			break;
+		}
+		e2 = err; 
+		if (e2 > -dx) {
+			err -= dy;
+			x0 += sx;
+		} 
+		if (e2 < dy) {
+			err += dx;
+			y0 += sy;
+		} 
+	}
+
+	return ESP_OK;
+}
+
+
+esp_err_t ssd1306_set_circle(ssd1306_handle_t handle, uint8_t x0, uint8_t y0, uint8_t r, bool invert) {
+	int16_t f = 1 - r;
+	int16_t ddF_x = 1;
+	int16_t ddF_y = -2 * r;
+	int16_t x = 0;
+	int16_t y = r;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+    ssd1306_set_pixel(handle, x0, y0 + r, invert);
+    ssd1306_set_pixel(handle, x0, y0 - r, invert);
+    ssd1306_set_pixel(handle, x0 + r, y0, invert);
+    ssd1306_set_pixel(handle, x0 - r, y0, invert);
+
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+
+        ssd1306_set_pixel(handle, x0 + x, y0 + y, invert);
+        ssd1306_set_pixel(handle, x0 - x, y0 + y, invert);
+        ssd1306_set_pixel(handle, x0 + x, y0 - y, invert);
+        ssd1306_set_pixel(handle, x0 - x, y0 - y, invert);
+
+        ssd1306_set_pixel(handle, x0 + y, y0 + x, invert);
+        ssd1306_set_pixel(handle, x0 - y, y0 + x, invert);
+        ssd1306_set_pixel(handle, x0 + y, y0 - x, invert);
+        ssd1306_set_pixel(handle, x0 - y, y0 - x, invert);
+    }
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_display_circle(ssd1306_handle_t handle, uint8_t x0, uint8_t y0, uint8_t r, bool invert) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+    ESP_RETURN_ON_ERROR(ssd1306_set_circle(handle, x0, y0, r, invert), TAG, "set circle for display circle failed");
+
+    ESP_RETURN_ON_ERROR(ssd1306_display_pages(handle), TAG, "display pages for circle failed");
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_display_filled_circle(ssd1306_handle_t handle, uint8_t x0, uint8_t y0, uint8_t r, bool invert) {
+	int16_t f = 1 - r;
+	int16_t ddF_x = 1;
+	int16_t ddF_y = -2 * r;
+	int16_t x = 0;
+	int16_t y = r;
+
+    /* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+    ssd1306_set_pixel(handle, x0, y0 + r, invert);
+    ssd1306_set_pixel(handle, x0, y0 - r, invert);
+    ssd1306_set_pixel(handle, x0 + r, y0, invert);
+    ssd1306_set_pixel(handle, x0 - r, y0, invert);
+    ssd1306_set_line(handle, x0 - r, y0, x0 + r, y0, invert);
+
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+
+        ssd1306_set_line(handle, x0 - (uint8_t)x, y0 + (uint8_t)y, x0 + (uint8_t)x, y0 + (uint8_t)y, invert);
+        ssd1306_set_line(handle, x0 + (uint8_t)x, y0 - (uint8_t)y, x0 - (uint8_t)x, y0 - (uint8_t)y, invert);
+
+        ssd1306_set_line(handle, x0 + (uint8_t)y, y0 + (uint8_t)x, x0 - (uint8_t)y, y0 + (uint8_t)x, invert);
+        ssd1306_set_line(handle, x0 + (uint8_t)y, y0 - (uint8_t)x, x0 - (uint8_t)y, y0 - (uint8_t)x, invert);
+    }
+
+    ESP_RETURN_ON_ERROR(ssd1306_display_pages(handle), TAG, "display pages for filled circle failed");
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_set_rectangle(ssd1306_handle_t handle, uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool invert) {
+    /* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+    /* Check input parameters */
+	if (
+		x >= handle->width ||
+		y >= handle->height
+	) {
+		/* Return error */
+		return ESP_ERR_INVALID_SIZE;
+	}
+	
+	/* Check width and height */
+	if ((x + w) >= handle->width) {
+		w = handle->width - x;
+	}
+	if ((y + h) >= handle->height) {
+		h = handle->height - y;
+	}
+
+    /* Set 4 lines */
+	ssd1306_set_line(handle, x, y, x + w, y, invert);         /* Top line */
+	ssd1306_set_line(handle, x, y + h, x + w, y + h, invert); /* Bottom line */
+	ssd1306_set_line(handle, x, y, x, y + h, invert);         /* Left line */
+	ssd1306_set_line(handle, x + w, y, x + w, y + h, invert); /* Right line */
+
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_display_rectangle(ssd1306_handle_t handle, uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool invert) {
+    /* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+    ESP_RETURN_ON_ERROR(ssd1306_set_rectangle(handle, x, y, w, h, invert), TAG, "set rectangle for display rectangle failed");
+
+    ESP_RETURN_ON_ERROR(ssd1306_display_pages(handle), TAG, "display pages for rectangle failed");
+
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_display_filled_rectangle(ssd1306_handle_t handle, uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool invert) {
+    /* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+    /* Check input parameters */
+	if (
+		x >= handle->width ||
+		y >= handle->height
+	) {
+		/* Return error */
+		return ESP_ERR_INVALID_SIZE;
+	}
+	
+	/* Check width and height */
+	if ((x + w) >= handle->width) {
+		w = handle->width - x;
+	}
+	if ((y + h) >= handle->height) {
+		h = handle->height - y;
+	}
+
+    /* Set lines */
+	for (uint8_t i = 0; i <= h; i++) {
+		/* Set line */
+		ssd1306_set_line(handle, x, y + i, x + w, y + i, invert);
+	}
+
+    ESP_RETURN_ON_ERROR(ssd1306_display_pages(handle), TAG, "display pages for rectangle failed");
+
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_enable_display(ssd1306_handle_t handle) {
+	uint8_t out_buf[2];
+	uint8_t out_index = 0;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	out_buf[out_index++] = SSD1306_CONTROL_BYTE_CMD_STREAM; // 00
+	out_buf[out_index++] = SSD1306_CMD_DISPLAY_ON; // AF
+
+	ESP_RETURN_ON_ERROR(ssd1306_write(handle, out_buf, out_index), TAG, "write contrast configuration failed");
+
+	/* set handle parameter */
+	handle->dev_config.display_enabled = true;
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_disable_display(ssd1306_handle_t handle) {
+	uint8_t out_buf[2];
+	uint8_t out_index = 0;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	out_buf[out_index++] = SSD1306_CONTROL_BYTE_CMD_STREAM; // 00
+	out_buf[out_index++] = SSD1306_CMD_DISPLAY_OFF; // AE
+
+	ESP_RETURN_ON_ERROR(ssd1306_write(handle, out_buf, out_index), TAG, "write contrast configuration failed");
+
+	/* set handle parameter */
+	handle->dev_config.display_enabled = false;
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_display_pages(ssd1306_handle_t handle) {
+	esp_err_t ret = ESP_OK;
+	ssd1306_cmd_list_t list;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	/* grayscale panels send the frame as page windows */
+	if (handle->gray_buffer) {
+		ssd1306_mark_dirty_all(handle);
+		return ssd1306_flush(handle);
+	}
+
+	size_t out_size = SSD1306_CMD_LIST_FRAME_SIZE(handle->pages);
+	uint8_t *out_buf = malloc(out_size);
+	if (out_buf == NULL) {
+		ESP_LOGE(TAG, "malloc for display pages failed");
+		return ESP_ERR_NO_MEM;
+	}
+
+	ESP_GOTO_ON_ERROR(ssd1306_cmd_list_init(handle, &list, out_buf, out_size), err, TAG, "command list init for display pages failed");
+	ESP_GOTO_ON_ERROR(ssd1306_cmd_list_add_pages(&list), err, TAG, "command list pages for display pages failed");
+	ESP_GOTO_ON_ERROR(ssd1306_cmd_list_submit(&list), err, TAG, "show buffer failed");
+
+	err:
+		free(out_buf);
+		return ret;
+}
+
+/**
+ * @brief Sends the dirty segment range of a page to the panel.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param page Index of a dirty page.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t ssd1306_flush_page(ssd1306_handle_t handle, uint8_t page) {
+	uint8_t start = handle->dirty_start[page];
+	uint8_t width = handle->dirty_end[page] - start + 1;
+
+	/* grayscale buffer is already up to date, it may hold pixels the 1-bit pages can not */
+	if (handle->gray_buffer) {
+		return ssd1327_display_window(handle, start, page * 8, handle->dirty_end[page], (page * 8) + 7);
+	}
+
+	return ssd1306_display_image(handle, page, start, &handle->page[page].segment[start], width);
+}
+
+/**
+ * @brief Sends the dirty segment ranges of a run of pages to the panel, other pages stay dirty.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param first Index of first page.
+ * @param count Number of pages.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t ssd1306_flush_pages(ssd1306_handle_t handle, uint8_t first, uint8_t count) {
+	for (uint8_t page = first; page < first + count && page < handle->pages; page++) {
+		if (handle->dirty_pages & (1U << page)) {
+			ESP_RETURN_ON_ERROR(ssd1306_flush_page(handle, page), TAG, "flush page %d failed", page);
+		}
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_flush(ssd1306_handle_t handle) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	while (handle->dirty_pages) {
+		uint8_t page = (uint8_t)__builtin_ctz(handle->dirty_pages);
+		ESP_RETURN_ON_ERROR(ssd1306_flush_page(handle, page), TAG, "flush page %d failed", page);
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_scheduler_init(ssd1306_scheduler_t *scheduler) {
+	/* validate parameters */
+	ESP_ARG_CHECK( scheduler );
+
+	memset(scheduler, 0, sizeof(*scheduler));
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_scheduler_add_panel(ssd1306_scheduler_t *scheduler, ssd1306_handle_t handle) {
+	/* validate parameters */
+	ESP_ARG_CHECK( scheduler && handle );
+
+	if (scheduler->panel_count >= SSD1306_SCHEDULER_MAX_PANELS) return ESP_ERR_NO_MEM;
+
+	scheduler->panel[scheduler->panel_count++] = handle;
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_scheduler_flush(ssd1306_scheduler_t *scheduler) {
+	/* validate parameters */
+	ESP_ARG_CHECK( scheduler );
+
+	bool progress = true;
+
+	/* one dirty page per panel per turn bounds the wait of every panel to one page of each other panel */
+	while (progress) {
+		progress = false;
+		for (uint8_t turn = 0; turn < scheduler->panel_count; turn++) {
+			ssd1306_handle_t handle = scheduler->panel[scheduler->next_panel];
+			scheduler->next_panel = (scheduler->next_panel + 1) % scheduler->panel_count;
+
+			if (handle->dirty_pages == 0) continue;
+
+			/* a panel inside a frame of another task keeps its turn for the next round, the caller's own frame
+			 * is flushed as is since taking the non-recursive mutex again would fail */
+			bool take = handle->frame_lock && xSemaphoreGetMutexHolder(handle->frame_lock) != xTaskGetCurrentTaskHandle();
+			if (take && xSemaphoreTake(handle->frame_lock, 0) != pdTRUE) continue;
+
+			uint8_t page = (uint8_t)__builtin_ctz(handle->dirty_pages);
+			esp_err_t ret = ssd1306_flush_page(handle, page);
+
+			if (take) xSemaphoreGive(handle->frame_lock);
+
+			ESP_RETURN_ON_ERROR(ret, TAG, "scheduler flush page %d failed", page);
+
+			progress = true;
+		}
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_set_pages(ssd1306_handle_t handle, uint8_t *buffer) {
+	size_t index = 0;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	for (uint8_t page = 0; page < handle->pages; page++) {
+		memcpy(&handle->page[page].segment, &buffer[index], 128);
+		index = index + 128;
+	}
+
+	ssd1327_expand_pages(handle);
+	ssd1306_mark_dirty_all(handle);
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_get_pages(ssd1306_handle_t handle, uint8_t *buffer) {
+	size_t index = 0;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	for (uint8_t page = 0; page < handle->pages; page++) {
+		memcpy(&buffer[index], &handle->page[page].segment, 128);
+		index = index + 128;
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_set_bitmap(ssd1306_handle_t handle, uint8_t xpos, uint8_t ypos, const uint8_t *bitmap, uint8_t width, uint8_t height, bool invert) {
+	uint8_t byte_width = (width + 7) / 8;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	for (uint8_t j = 0; j < height; j++) {
+        for (uint8_t i = 0; i < width; i++) {
+            if (*(bitmap + j * byte_width + i / 8) & (128 >> (i & 7))) {
+                ssd1306_set_pixel(handle, xpos + i, ypos + j, invert);
+            }
+        }
+    }
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_display_bitmap(ssd1306_handle_t handle, uint8_t xpos, uint8_t ypos, const uint8_t *bitmap, uint8_t width, uint8_t height, bool invert) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	ESP_RETURN_ON_ERROR(ssd1306_set_bitmap(handle, xpos, ypos, bitmap, width, height, invert), TAG, "set bitmap for display bitmap failed");
+
+	ESP_RETURN_ON_ERROR(ssd1306_display_pages(handle), TAG, "display pages for bitmap failed");
+
+	return ESP_OK;
+}
+
+/**
+ * @brief Stores one page-major image byte into the page segments, merging across two pages when not page aligned.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param xpos X-axis position of the segment, clipped when outside the panel.
+ * @param page Index of the first page touched.
+ * @param shift Bit offset of the image row within the page.
+ * @param data Image byte, bit 0 is the top pixel.
+ * @param mask Image rows held by the byte.
+ */
+static inline void ssd1306_blit_segment(ssd1306_handle_t handle, uint16_t xpos, uint16_t page, uint8_t shift, uint8_t data, uint8_t mask) {
+	if (xpos >= handle->width) return;
+
+	if (page < handle->pages) {
+		uint8_t *seg = &handle->page[page].segment[xpos];
+		uint8_t m = (uint8_t)(mask << shift);
+		*seg = (*seg & ~m) | ((uint8_t)(data << shift) & m);
+	}
+
+	if (shift && page + 1 < handle->pages) {
+		uint8_t *seg = &handle->page[page + 1].segment[xpos];
+		uint8_t m = mask >> (8 - shift);
+		*seg = (*seg & ~m) | ((data >> (8 - shift)) & m);
+	}
+}
+
+esp_err_t ssd1306_set_rle_image(ssd1306_handle_t handle, uint8_t xpos, uint8_t ypos, const uint8_t *rle, bool invert) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle && rle );
+
+	if (xpos >= handle->width || ypos >= handle->height) return ESP_ERR_INVALID_SIZE;
+
+	const uint8_t width = rle[0];
+	const uint8_t height = rle[1];
+	const uint8_t *src = &rle[SSD1306_RLE_HEADER_SIZE];
+	const uint8_t inv = invert ? 0xFF : 0x00;
+	const uint8_t shift = ypos % 8;
+	const uint8_t first = ypos / 8;
+	const uint8_t pages = (height + 7) / 8;
+	const uint8_t last_mask = (height % 8) ? (uint8_t)((1U << (height % 8)) - 1) : 0xFF;
+	const uint32_t total = (uint32_t)width * pages;
+	uint32_t pos = 0;
+	uint8_t col = 0, page = 0;
+
+	if (width == 0 || height == 0) return ESP_ERR_INVALID_ARG;
+
+	/* runs may cross page boundaries, the column and page cursors advance per byte */
+	while (pos < total) {
+		const uint8_t ctrl = *src++;
+		const uint8_t count = (ctrl & SSD1306_RLE_COUNT_MASK) + 1;
+		const bool repeat = (ctrl & SSD1306_RLE_REPEAT) != 0;
+
+		if (pos + count > total) return ESP_ERR_INVALID_SIZE;
+
+		for (uint8_t i = 0; i < count; i++) {
+			const uint8_t mask = (page == pages - 1) ? last_mask : 0xFF;
+			ssd1306_blit_segment(handle, xpos + col, first + page, shift, (repeat ? src[0] : src[i]) ^ inv, mask);
+			if (++col == width) {
+				col = 0;
+				page++;
+			}
+		}
+
+		src += repeat ? 1 : count;
+		pos += count;
+	}
+
+	/* record the touched rectangle, clipped to the panel */
+	const uint8_t end_x = (xpos + width - 1 < handle->width) ? (uint8_t)(xpos + width - 1) : (uint8_t)(handle->width - 1);
+	const uint16_t end_y = ypos + height - 1;
+	const uint8_t end_page = (end_y < handle->height) ? (uint8_t)(end_y / 8) : (uint8_t)(handle->pages - 1);
+
+	for (uint8_t p = first; p <= end_page; p++) {
+		ssd1306_mark_dirty(handle, p, xpos, end_x);
+		if (handle->gray_buffer) {
+			ssd1327_expand_page(handle, p, xpos, end_x);
+		}
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_display_rle_image(ssd1306_handle_t handle, uint8_t xpos, uint8_t ypos, const uint8_t *rle, bool invert) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle && rle );
+
+	ESP_RETURN_ON_ERROR(ssd1306_set_rle_image(handle, xpos, ypos, rle, invert), TAG, "set rle image for display rle image failed");
+
+	ESP_RETURN_ON_ERROR(ssd1306_flush(handle), TAG, "flush for rle image failed");
+
+	return ESP_OK;
+}
+
+/* this works fine for a 128x32 but the pages repeat after page 3, e.g. pages 0-3 and 4-7 are the same */
+esp_err_t ssd1306_display_bitmap__(ssd1306_handle_t handle, uint8_t xpos, uint8_t ypos, const uint8_t *bitmap, uint8_t width, uint8_t height, bool invert) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	if ( (width % 8) != 0) {
+		ESP_LOGE(TAG, "width must be a multiple of 8");
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	uint8_t _width = width / 8;
+	uint8_t wk0;
+	uint8_t wk1;
+	uint8_t wk2;
+	uint8_t page = (ypos / 8);
+	uint8_t _seg = xpos;
+	uint8_t dstBits = (ypos % 8);
+	uint8_t offset = 0;
+
+	ESP_LOGD(TAG, "ypos=%d page=%d dstBits=%d", ypos, page, dstBits);
+
+	for(uint8_t _height = 0; _height < height; _height++) {
+		for (uint8_t index = 0; index < _width; index++) {
+			for (int8_t srcBits=7; srcBits>=0; srcBits--) {
+				wk0 = handle->page[page].segment[_seg];
+
+				wk1 = bitmap[index+offset];
+				if (invert) {
+					wk1 = ~wk1; 
+				}
+
+				wk2 = ssd1306_copy_bit(wk1, srcBits, wk0, dstBits);
+
+				ESP_LOGD(TAG, "index=%d offset=%d page=%d _seg=%d, wk2=%02x", index, offset, page, _seg, wk2);
+				handle->page[page].segment[_seg] = wk2;
+				_seg++;
+			}
+		}
+		vTaskDelay(1);
+		offset = offset + _width;
+		dstBits++;
+		_seg = xpos;
+		if (dstBits == 8) {
+			page++;
+			dstBits=0;
+		}
+	}
+
+	/* grayscale panels send the frame from the expanded buffer */
+	if (handle->gray_buffer && height > 0 && width > 0) {
+		uint16_t x1 = (uint16_t)xpos + (width - 1);
+		for (uint16_t p = ypos / 8; p <= (ypos + height - 1) / 8 && p < handle->pages; p++) {
+			ssd1327_expand_page(handle, (uint8_t)p, xpos, (uint8_t)(x1 < handle->width ? x1 : handle->width - 1));
+		}
+	}
+
+	ESP_RETURN_ON_ERROR(ssd1306_display_pages(handle), TAG, "display pages for bitmap failed");
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_display_image(ssd1306_handle_t handle, uint8_t page, uint8_t segment, const uint8_t *image, uint8_t width) {
+	uint8_t out_buf[SSD1306_CMD_LIST_IMAGE_SIZE];
+	ssd1306_cmd_list_t list;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	if (handle->gray_buffer) {
+		if (page >= handle->pages) return ESP_ERR_INVALID_SIZE;
+		if (segment >= handle->width || segment + width > handle->width) return ESP_ERR_INVALID_SIZE;
+
+		memmove(&handle->page[page].segment[segment], image, width);
+		ssd1327_expand_page(handle, page, segment, segment + width - 1);
+
+		return ssd1327_display_window(handle, segment, page * 8, segment + width - 1, (page * 8) + 7);
+	}
+
+	ESP_RETURN_ON_ERROR(ssd1306_cmd_list_init(handle, &list, out_buf, sizeof(out_buf)), TAG, "command list init for image display failed");
+
+	/* page address and image data go out as a single transaction */
+	ESP_RETURN_ON_ERROR(ssd1306_cmd_list_add_image(&list, page, segment, image, width), TAG, "command list image for image display failed");
+
+	ESP_RETURN_ON_ERROR(ssd1306_cmd_list_submit(&list), TAG, "write image for image display failed");
+
+	return ESP_OK;
+}
+
+/**
+ * @brief Decodes the next UTF-8 code point of a text and advances the text past it.
+ * 
+ * @note Malformed, overlong and surrogate sequences decode to '?' and advance by one byte.
+ * 
+ * @param text Text position, advanced past the decoded code point.
+ * @return uint32_t Unicode code point.
+ */
+static uint32_t ssd1306_utf8_next(const char **text) {
+	const uint8_t *s = (const uint8_t *)*text;
+	uint32_t code;
+	uint8_t len;
+
+	if (s[0] < 0x80) {
+		*text += 1;
+		return s[0];
+	} else if ((s[0] & 0xE0) == 0xC0) {
+		code = s[0] & 0x1F; len = 2;
+	} else if ((s[0] & 0xF0) == 0xE0) {
+		code = s[0] & 0x0F; len = 3;
+	} else if ((s[0] & 0xF8) == 0xF0) {
+		code = s[0] & 0x07; len = 4;
+	} else {
+		*text += 1;
+		return '?';
+	}
+
+	for (uint8_t i = 1; i < len; i++) {
+		if ((s[i] & 0xC0) != 0x80) {
+			*text += 1;
+			return '?';
+		}
+		code = (code << 6) | (s[i] & 0x3F);
+	}
+
+	/* overlong encodings, surrogates and code points past U+10FFFF are malformed */
+	static const uint32_t min_code[5] = { 0, 0, 0x80, 0x800, 0x10000 };
+	if (code < min_code[len] || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF)) {
+		*text += 1;
+		return '?';
+	}
+
+	*text += len;
+
+	return code;
+}
+
+/**
+ * @brief Counts the UTF-8 code points of a text, stopping once the count exceeds a maximum.
+ * 
+ * @note Counts as `ssd1306_utf8_next` decodes, each malformed byte is one '?' glyph.
+ * 
+ * @param text UTF-8 text.
+ * @param max_len Maximum number of code points.
+ * @return size_t Number of code points, max_len + 1 when the text is longer.
+ */
+static size_t ssd1306_utf8_strnlen(const char *text, size_t max_len) {
+	size_t len = 0;
+
+	while (*text && len <= max_len) {
+		ssd1306_utf8_next(&text);
+		len++;
+	}
+
+	return len;
+}
+
+/**
+ * @brief Gets the 8x8 glyph of a code point, latin code points come from the built-in font and others
+ * from the sparse glyph table by binary search.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param code Unicode code point.
+ * @return const uint8_t* 90 degree transposed 8x8 glyph, '?' when the code point has no glyph.
+ */
+static const uint8_t *ssd1306_get_glyph(ssd1306_handle_t handle, uint32_t code) {
+	const ssd1306_glyph_table_t *table = handle->glyph_table;
+
+	if (code <= 0xFF) return font_latin_8x8_tr[code];
+
+	if (table) {
+		uint16_t lo = 0, hi = table->count;
+		while (lo < hi) {
+			uint16_t mid = lo + ((hi - lo) / 2);
+			if (table->code_points[mid] < code) {
+				lo = mid + 1;
+			} else if (table->code_points[mid] > code) {
+				hi = mid;
+			} else {
+				return table->glyphs[mid];
+			}
+		}
+	}
+
+	return font_latin_8x8_tr['?'];
+}
+
+esp_err_t ssd1306_set_glyph_table(ssd1306_handle_t handle, const ssd1306_glyph_table_t *glyph_table) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	handle->glyph_table = glyph_table;
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_bdf_metrics_init(const uint8_t *font, ssd1306_bdf_metrics_t *metrics) {
+	/* validate parameters */
+	ESP_ARG_CHECK( font && metrics );
+
+	memset(metrics, 0, sizeof(*metrics));
+	metrics->font = font;
+	metrics->bbw  = font[0];
+	metrics->bbh  = font[1];
+
+	/* glyph records: encoding, width, bbw, bbh, bbx, bby, num_data, y_start, y_end, data */
+	for (size_t index = 2; font[index + 6] != 0; index += font[index + 6] + 9) {
+		if (index > UINT16_MAX) return ESP_ERR_INVALID_SIZE;
+		metrics->offset[font[index]]  = (uint16_t)index;
+		metrics->advance[font[index]] = font[index + 1];
+	}
+
+	return ESP_OK;
+}
+
+/**
+ * @brief Gets the kerning adjustment of a glyph pair by binary search.
+ * 
+ * @param layout BDF text layout.
+ * @param left Encoding of the left glyph.
+ * @param right Encoding of the right glyph.
+ * @return int8_t Advance adjustment in pixels.
+ */
+static int8_t ssd1306_bdf_kerning(const ssd1306_bdf_layout_t *layout, uint8_t left, uint8_t right) {
+	const uint16_t key = (uint16_t)((left << 8) | right);
+	uint16_t lo = 0, hi = layout->kern_count;
+
+	while (lo < hi) {
+		uint16_t mid = lo + ((hi - lo) / 2);
+		uint16_t pair = (uint16_t)((layout->kern_pairs[mid].left << 8) | layout->kern_pairs[mid].right);
+		if (pair < key) {
+			lo = mid + 1;
+		} else if (pair > key) {
+			hi = mid;
+		} else {
+			return layout->kern_pairs[mid].adjust;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Decodes the next glyph encoding of a text for a BDF font.
+ * 
+ * @param metrics BDF font metrics.
+ * @param text Text position, advanced past the decoded code point.
+ * @param encoding Glyph encoding.
+ * @return bool True when the font has a glyph for the code point.
+ */
+static inline bool ssd1306_bdf_next(const ssd1306_bdf_metrics_t *metrics, const char **text, uint8_t *encoding) {
+	uint32_t code = ssd1306_utf8_next(text);
+
+	if (code > 0xFF || metrics->offset[code] == 0) return false;
+	*encoding = (uint8_t)code;
+
+	return true;
+}
+
+esp_err_t ssd1306_measure_bdf_text(const ssd1306_bdf_layout_t *layout, const char *text, uint16_t *const width) {
+	/* validate parameters */
+	ESP_ARG_CHECK( layout && layout->metrics && text && width );
+
+	const ssd1306_bdf_metrics_t *metrics = layout->metrics;
+	int32_t x = 0;
+	bool first = true;
+	uint8_t prev = 0, enc;
+
+	while (*text) {
+		if (!ssd1306_bdf_next(metrics, &text, &enc)) continue;
+		if (!first) x += layout->tracking + (layout->kern_pairs ? ssd1306_bdf_kerning(layout, prev, enc) : 0);
+		x += metrics->advance[enc];
+		prev = enc;
+		first = false;
+	}
+
+	*width = (x > 0) ? (uint16_t)x : 0;
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_set_bdf_text(ssd1306_handle_t handle, const ssd1306_bdf_layout_t *layout, const char *text) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle && layout && layout->metrics && text );
+
+	const ssd1306_bdf_metrics_t *metrics = layout->metrics;
+	const uint8_t *font = metrics->font;
+
+	/* clip box intersected with the panel */
+	const int16_t clip_x0 = (layout->box_x > 0) ? layout->box_x : 0;
+	const int16_t clip_y0 = (layout->box_y > 0) ? layout->box_y : 0;
+	const int16_t clip_x1 = ((layout->box_x + layout->box_width) < handle->width) ? (layout->box_x + layout->box_width) : handle->width;
+	const int16_t clip_y1 = ((layout->box_y + layout->box_height) < handle->height) ? (layout->box_y + layout->box_height) : handle->height;
+
+	if (clip_x0 >= clip_x1 || clip_y0 >= clip_y1) return ESP_OK;
+
+	int32_t x = layout->box_x;
+	if (layout->align != SSD1306_BDF_ALIGN_LEFT) {
+		uint16_t width;
+		ESP_RETURN_ON_ERROR(ssd1306_measure_bdf_text(layout, text, &width), TAG, "measure bdf text for layout failed");
+		x += (layout->align == SSD1306_BDF_ALIGN_RIGHT) ? (layout->box_width - width) : ((layout->box_width - width) / 2);
+	}
+
+	int16_t drawn_x0 = clip_x1, drawn_x1 = clip_x0 - 1;
+	bool first = true;
+	uint8_t prev = 0, enc;
+
+	while (*text && x < clip_x1) {
+		if (!ssd1306_bdf_next(metrics, &text, &enc)) continue;
+		if (!first) x += layout->tracking + (layout->kern_pairs ? ssd1306_bdf_kerning(layout, prev, enc) : 0);
+		prev = enc;
+		first = false;
+
+		const uint8_t *glyph = &font[metrics->offset[enc]];
+		const uint8_t rows = glyph[8] - glyph[7] + 1;
+		const uint8_t row_bytes = glyph[6] / rows;
+		const uint8_t *data = &glyph[9];
+		const int32_t glyph_y = layout->box_y + glyph[7];
+
+		/* only glyphs reaching into the clip box are drawn */
+		if (x + (row_bytes * 8) > clip_x0) {
+			for (uint8_t row = 0; row < rows; row++) {
+				const int32_t y = glyph_y + row;
+				if (y < clip_y0 || y >= clip_y1) continue;
+				uint8_t *seg = handle->page[y / 8].segment;
+				const uint8_t bit = (uint8_t)(1 << (y % 8));
+				for (uint8_t col = 0; col < row_bytes * 8; col++) {
+					const int32_t px = x + col;
+					if (px < clip_x0 || px >= clip_x1) continue;
+					if (!(data[(row * row_bytes) + (col / 8)] & (0x80 >> (col % 8)))) continue;
+					seg[px] = layout->invert ? (seg[px] & ~bit) : (seg[px] | bit);
+					if (px < drawn_x0) drawn_x0 = (int16_t)px;
+					if (px > drawn_x1) drawn_x1 = (int16_t)px;
+				}
+			}
+		}
+
+		x += metrics->advance[enc];
+	}
+
+	/* record the touched columns of the pages covered by the clip box */
+	if (drawn_x0 <= drawn_x1) {
+		for (uint8_t page = clip_y0 / 8; page <= (clip_y1 - 1) / 8; page++) {
+			ssd1306_mark_dirty(handle, page, (uint8_t)drawn_x0, (uint8_t)drawn_x1);
+			if (handle->gray_buffer) {
+				ssd1327_expand_page(handle, page, (uint8_t)drawn_x0, (uint8_t)drawn_x1);
+			}
+		}
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_set_text(ssd1306_handle_t handle, uint8_t page, const char *text, bool invert) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle && text );
+
+	if (page >= handle->pages) return ESP_ERR_INVALID_SIZE;
+
+	size_t len = ssd1306_utf8_strnlen(text, SSD1306_TEXT_DISPLAY_MAX_LEN);
+	if (len > SSD1306_TEXT_DISPLAY_MAX_LEN || len * 8 > handle->width) return ESP_ERR_INVALID_SIZE;
+
+	uint8_t seg = 0;
+	uint8_t image[8];
+
+	while (*text) {
+		memcpy(image, ssd1306_get_glyph(handle, ssd1306_utf8_next(&text)), 8);
+		if (invert) ssd1306_invert_buffer(image, 8);
+		ssd1306_write_segments(handle, page, seg, image, 8);
+		seg = seg + 8;
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_display_text(ssd1306_handle_t handle, uint8_t page, const char *text, bool invert) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	ESP_RETURN_ON_ERROR(ssd1306_set_text(handle, page, text, invert), TAG, "set text for display text failed");
+
+	/* the line goes out as one transaction */
+	ESP_RETURN_ON_ERROR(ssd1306_flush_pages(handle, page, 1), TAG, "flush page for display text failed");
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_set_text_x2(ssd1306_handle_t handle, uint8_t page, const char *text, bool invert) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle && text );
+
+	if (page + 1 >= handle->pages) return ESP_ERR_INVALID_SIZE;
+
+	size_t len = ssd1306_utf8_strnlen(text, SSD1306_TEXT_X2_DISPLAY_MAX_LEN);
+	if (len > SSD1306_TEXT_X2_DISPLAY_MAX_LEN || len * 16 > handle->width) return ESP_ERR_INVALID_SIZE;
+
+	uint8_t seg = 0;
+
+	while (*text) {
+		uint8_t const * const in_columns = ssd1306_get_glyph(handle, ssd1306_utf8_next(&text));
+
+		// make the character 2x as high
+		ssd1306_out_column_t out_columns[8];
+		memset(out_columns, 0, sizeof(out_columns));
+
+		for (uint8_t xx = 0; xx < 8; xx++) { // for each column (x-direction)
+			uint32_t in_bitmask = 0b1;
+			uint32_t out_bitmask = 0b11;
+
+			for (uint8_t yy = 0; yy < 8; yy++) { // for pixel (y-direction)
+				if (in_columns[xx] & in_bitmask) {
+					out_columns[xx].u32 |= out_bitmask;
+				}
+				in_bitmask <<= 1;
+				out_bitmask <<= 2;
+			}
+		}
+
+		// render character in 8 column high pieces, making them 2x as wide
+		for (uint8_t yy = 0; yy < 2; yy++)	{ // for each group of 8 pixels high (y-direction)
+			uint8_t image[16];
+			for (uint8_t xx = 0; xx < 8; xx++) { // for each column (x-direction)
+				image[xx*2+0] = 
+				image[xx*2+1] = out_columns[xx].u8[yy];
+			}
+			if (invert) ssd1306_invert_buffer(image, 16);
+
+			ssd1306_write_segments(handle, page+yy, seg, image, 16);
+		}
+		seg = seg + 16;
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_display_text_x2(ssd1306_handle_t handle, uint8_t page, const char *text, bool invert) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	ESP_RETURN_ON_ERROR(ssd1306_set_text_x2(handle, page, text, invert), TAG, "set text x2 for display text x2 failed");
+	ESP_RETURN_ON_ERROR(ssd1306_flush_pages(handle, page, 2), TAG, "flush pages for display text x2 failed");
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_set_text_x3(ssd1306_handle_t handle, uint8_t page, const char *text, bool invert) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle && text );
+
+	if (page + 2 >= handle->pages) return ESP_ERR_INVALID_SIZE;
+
+	size_t len = ssd1306_utf8_strnlen(text, SSD1306_TEXT_X3_DISPLAY_MAX_LEN);
+	if (len > SSD1306_TEXT_X3_DISPLAY_MAX_LEN || len * 24 > handle->width) return ESP_ERR_INVALID_SIZE;
+
+	uint8_t seg = 0;
+
+	while (*text) {
+		uint8_t const * const in_columns = ssd1306_get_glyph(handle, ssd1306_utf8_next(&text));
+
+		// make the character 3x as high
+		ssd1306_out_column_t out_columns[8];
+		memset(out_columns, 0, sizeof(out_columns));
+
+		for (uint8_t xx = 0; xx < 8; xx++) { // for each column (x-direction)
+			uint32_t in_bitmask = 0b1;
+			uint32_t out_bitmask = 0b111;
+
+			for (uint8_t yy = 0; yy < 8; yy++) { // for pixel (y-direction)
+				if (in_columns[xx] & in_bitmask) {
+					out_columns[xx].u32 |= out_bitmask;
+				}
+				in_bitmask <<= 1;
+				out_bitmask <<= 3;
+			}
+		}
+
+		// render character in 8 column high pieces, making them 3x as wide
+		for (uint8_t yy = 0; yy < 3; yy++)	{ // for each group of 8 pixels high (y-direction)
+			uint8_t image[24];
+			for (uint8_t xx = 0; xx < 8; xx++) { // for each column (x-direction)
+				image[xx*3+0] = 
+				image[xx*3+1] = 
+				image[xx*3+2] = out_columns[xx].u8[yy];
+			}
+			if (invert) ssd1306_invert_buffer(image, 24);
+
+			ssd1306_write_segments(handle, page+yy, seg, image, 24);
+		}
+		seg = seg + 24;
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_display_text_x3(ssd1306_handle_t handle, uint8_t page, const char *text, bool invert) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	ESP_RETURN_ON_ERROR(ssd1306_set_text_x3(handle, page, text, invert), TAG, "set text x3 for display text x3 failed");
+	ESP_RETURN_ON_ERROR(ssd1306_flush_pages(handle, page, 3), TAG, "flush pages for display text x3 failed");
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_display_textbox_banner(ssd1306_handle_t handle, uint8_t page, uint8_t segment, const char *text, uint8_t box_width, bool invert, uint8_t delay) {
+	if (page >= handle->pages) return ESP_ERR_INVALID_SIZE;
+	uint8_t text_box_pixel = box_width * 8;
+	if (segment + text_box_pixel > handle->width) return ESP_ERR_INVALID_SIZE;
+	if (ssd1306_utf8_strnlen(text, SSD1306_TEXTBOX_DISPLAY_MAX_LEN) > SSD1306_TEXTBOX_DISPLAY_MAX_LEN) return ESP_ERR_INVALID_SIZE;
+
+	uint8_t _seg = segment;
+	uint8_t image[8];
+
+	for (uint8_t i = 0; i < box_width; i++) {
+		memcpy(image, *text ? ssd1306_get_glyph(handle, ssd1306_utf8_next(&text)) : font_latin_8x8_tr[' '], 8);
+		if (invert) ssd1306_invert_buffer(image, 8);
+		ssd1306_display_image(handle, page, _seg, image, 8);
+		_seg = _seg + 8;
+	}
+	vTaskDelay(delay / portTICK_PERIOD_MS);
+
+	// Horizontally scroll inside the box
+	while (*text) {
+		memcpy(image, ssd1306_get_glyph(handle, ssd1306_utf8_next(&text)), 8);
+		if (invert) ssd1306_invert_buffer(image, 8);
+		for (uint8_t _bit=0;_bit<8;_bit++) {
+			for (int _pixel=0;_pixel<text_box_pixel;_pixel++) {
+				//ESP_LOGI(TAG, "_text=%d _bit=%d _pixel=%d", _text, _bit, _pixel);
+				handle->page[page].segment[_pixel+segment] = handle->page[page].segment[_pixel+segment+1];
+			}
+			handle->page[page].segment[segment+text_box_pixel-1] = image[_bit];
+			ssd1306_display_image(handle, page, segment, &handle->page[page].segment[segment], text_box_pixel);
+			vTaskDelay(delay / portTICK_PERIOD_MS);
+		}
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_display_textbox_ticker(ssd1306_handle_t handle, uint8_t page, uint8_t segment, const char *text, uint8_t box_width, bool invert, uint8_t delay) {
+	if (page >= handle->pages) return ESP_ERR_INVALID_SIZE;
+	uint8_t text_box_pixel = box_width * 8;
+	if (segment + text_box_pixel > handle->width) return ESP_ERR_INVALID_SIZE;
+    if (ssd1306_utf8_strnlen(text, SSD1306_TEXTBOX_DISPLAY_MAX_LEN) > SSD1306_TEXTBOX_DISPLAY_MAX_LEN) return ESP_ERR_INVALID_SIZE;
+
+	uint8_t _seg = segment;
+	uint8_t image[8];
+
+    // fill box with spaces
+	for (uint8_t i = 0; i < box_width; i++) {
+		memcpy(image, font_latin_8x8_tr[21], 8);
+		if (invert) ssd1306_invert_buffer(image, 8);
+		ssd1306_display_image(handle, page, _seg, image, 8);
+		_seg = _seg + 8;
+	}
+	vTaskDelay(delay / portTICK_PERIOD_MS);
+
+	// Horizontally scroll inside the box
+	while (*text) {
+		memcpy(image, ssd1306_get_glyph(handle, ssd1306_utf8_next(&text)), 8);
+		if (invert) ssd1306_invert_buffer(image, 8);
+		for (uint8_t _bit=0;_bit<8;_bit++) {
+			for (uint8_t _pixel=0;_pixel<text_box_pixel;_pixel++) {
+				//ESP_LOGI(TAG, "_text=%d _bit=%d _pixel=%d", _text, _bit, _pixel);
+				handle->page[page].segment[_pixel+segment] = handle->page[page].segment[_pixel+segment+1];
+			}
+			handle->page[page].segment[segment+text_box_pixel-1] = image[_bit];
+			ssd1306_display_image(handle, page, segment, &handle->page[page].segment[segment], text_box_pixel);
+			vTaskDelay(delay / portTICK_PERIOD_MS);
+		}
+	}
+
+    // Horizontally scroll inside the box
+	for (uint8_t _text=0; _text<box_width; _text++) {
+		memcpy(image, font_latin_8x8_tr[21], 8);
+		if (invert) ssd1306_invert_buffer(image, 8);
+		for (uint8_t _bit=0;_bit<8;_bit++) {
+			for (uint8_t _pixel=0;_pixel<text_box_pixel;_pixel++) {
+				//ESP_LOGI(TAG, "_text=%d _bit=%d _pixel=%d", _text, _bit, _pixel);
+				handle->page[page].segment[_pixel+segment] = handle->page[page].segment[_pixel+segment+1];
+			}
+			handle->page[page].segment[segment+text_box_pixel-1] = image[_bit];
+			ssd1306_display_image(handle, page, segment, &handle->page[page].segment[segment], text_box_pixel);
+			vTaskDelay(delay / portTICK_PERIOD_MS);
+		}
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_clear_display_page(ssd1306_handle_t handle, uint8_t page, bool invert) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	ESP_RETURN_ON_ERROR(ssd1306_display_text(handle, page, "                ", invert), TAG, "display text for clear line failed");
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_clear_pages(ssd1306_handle_t handle, bool invert) {
+	uint8_t blank[SSD1306_PAGE_SEGMENT_SIZE];
+
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	memset(blank, invert ? 0xFF : 0x00, sizeof(blank));
+
+	for (uint8_t page = 0; page < handle->pages; page++) {
+		ssd1306_write_segments(handle, page, 0, blank, handle->width);
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_clear_display(ssd1306_handle_t handle, bool invert) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	for (uint8_t page = 0; page < handle->pages; page++) {
+		ESP_RETURN_ON_ERROR(ssd1306_clear_display_page(handle, page, invert), TAG, "clear line for clear screen failed");
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_set_contrast(ssd1306_handle_t handle, uint8_t contrast) {
+	uint8_t out_buf[3];
+	uint8_t out_index = 0;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	out_buf[out_index++] = SSD1306_CONTROL_BYTE_CMD_STREAM; // 00
+	out_buf[out_index++] = SSD1306_CMD_SET_CONTRAST; // 81
+	out_buf[out_index++] = contrast;
+
+	ESP_RETURN_ON_ERROR(ssd1306_write(handle, out_buf, out_index), TAG, "write contrast configuration failed");
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_set_software_scroll(ssd1306_handle_t handle, uint8_t start, uint8_t end) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	ESP_LOGD(TAG, "software_scroll start=%d end=%d _pages=%d", start, end, handle->pages);
+	
+	if (start >= handle->pages || end >= handle->pages) {
+		handle->scroll_enabled = false;
+	} else {
+		handle->scroll_enabled = true;
+		handle->scroll_start = start;
+		handle->scroll_end = end;
+		handle->scroll_direction = 1;
+		if (start > end ) handle->scroll_direction = -1;
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_display_software_scroll_text(ssd1306_handle_t handle, const char *text, bool invert) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	if (ssd1306_utf8_strnlen(text, SSD1306_TEXT_DISPLAY_MAX_LEN) > SSD1306_TEXT_DISPLAY_MAX_LEN) return ESP_ERR_INVALID_SIZE;
+
+	ESP_LOGD(TAG, "ssd1306_handle->dev_params->scroll_enabled=%d", handle->scroll_enabled);
+	if (handle->scroll_enabled == false) return ESP_ERR_INVALID_ARG;
+
+	uint16_t srcIndex = handle->scroll_end - handle->scroll_direction;
+	while(1) {
+		uint16_t dstIndex = srcIndex + handle->scroll_direction;
+		ESP_LOGD(TAG, "srcIndex=%u dstIndex=%u", srcIndex,dstIndex);
+		for(uint16_t seg = 0; seg < handle->width; seg++) {
+			handle->page[dstIndex].segment[seg] = handle->page[srcIndex].segment[seg];
+		}
+		ESP_RETURN_ON_ERROR(ssd1306_display_image(handle, dstIndex, 0, handle->page[dstIndex].segment, sizeof(handle->page[dstIndex].segment)), TAG, "display image for scroll text failed");
+		if (srcIndex == handle->scroll_start) break;
+		srcIndex = srcIndex - handle->scroll_direction;
+	}
+	
+	ESP_RETURN_ON_ERROR(ssd1306_display_text(handle, srcIndex, text, invert), TAG, "display text for scroll text failed");
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_clear_display_software_scroll(ssd1306_handle_t handle) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	ESP_LOGD(TAG, "ssd1306_handle->dev_params->scroll_enabled=%d", handle->scroll_enabled);
+	ESP_RETURN_ON_FALSE(handle->scroll_enabled, ESP_ERR_INVALID_ARG, TAG, "software scroll not enabled");
+
+	uint16_t srcIndex = handle->scroll_end - handle->scroll_direction;
+	while(1) {
+		uint16_t dstIndex = srcIndex + handle->scroll_direction;
+		ESP_LOGD(TAG, "srcIndex=%u dstIndex=%u", srcIndex,dstIndex);
+		ESP_RETURN_ON_ERROR(ssd1306_clear_display_page(handle, dstIndex, false), TAG, "clear display page for scroll clear failed");
+		if (dstIndex == handle->scroll_start) break;
+		srcIndex = srcIndex - handle->scroll_direction;
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_set_hardware_scroll(ssd1306_handle_t handle, ssd1306_scroll_types_t scroll, ssd1306_scroll_frames_t frame_frequency) {
+    uint8_t out_buf[15];
+    uint8_t out_index = 0;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	if(handle->dev_config.panel_size == SSD1306_PANEL_128x128) {
+		return ESP_ERR_NOT_SUPPORTED;
+	}
+
+	out_buf[out_index++] = SSD1306_CONTROL_BYTE_CMD_STREAM; // 00
+
+	if (scroll == SSD1306_SCROLL_RIGHT) {
+		out_buf[out_index++] = SSD1306_CMD_HORIZONTAL_RIGHT; // 26
+		out_buf[out_index++] = 0x00; // Dummy byte
+		out_buf[out_index++] = 0x00; // Define start page address
+		out_buf[out_index++] = (uint8_t)frame_frequency; // Frame frequency
+		out_buf[out_index++] = 0x01; // Define end page address
+		out_buf[out_index++] = 0x00; // Dummy byte 0x00
+		out_buf[out_index++] = 0xFF; // Dummy byte 0xFF
+		out_buf[out_index++] = SSD1306_CMD_ACTIVE_SCROLL; // 2F
+	} 
+
+	if (scroll == SSD1306_SCROLL_LEFT) {
+		out_buf[out_index++] = SSD1306_CMD_HORIZONTAL_LEFT; // 27
+		out_buf[out_index++] = 0x00; // Dummy byte
+		out_buf[out_index++] = 0x00; // Define start page address
+		out_buf[out_index++] = (uint8_t)frame_frequency; // Frame frequency
+		out_buf[out_index++] = 0x01; // Define end page address
+		out_buf[out_index++] = 0x00; //
+		out_buf[out_index++] = 0xFF; //
+		out_buf[out_index++] = SSD1306_CMD_ACTIVE_SCROLL; // 2F
+	} 
+
+	if (scroll == SSD1306_SCROLL_DOWN) {
+		out_buf[out_index++] = SSD1306_CMD_CONTINUOUS_SCROLL; // 29
+		out_buf[out_index++] = 0x00; // Dummy byte
+		out_buf[out_index++] = 0x00; // Define start page address
+		out_buf[out_index++] = (uint8_t)frame_frequency; // Frame frequency
+		out_buf[out_index++] = 0x00; // Define end page address
+		out_buf[out_index++] = 0x3F; // Vertical scrolling offset
+
+		out_buf[out_index++] = SSD1306_CMD_VERTICAL; // A3
+		out_buf[out_index++] = 0x00;
+		if (handle->height == 128)
+			out_buf[out_index++] = 0x80;
+		if (handle->height == 64)
+			out_buf[out_index++] = 0x40;
+		if (handle->height == 32)
+			out_buf[out_index++] = 0x20;
+		out_buf[out_index++] = SSD1306_CMD_ACTIVE_SCROLL; // 2F
+	}
+
+	if (scroll == SSD1306_SCROLL_UP) {
+		out_buf[out_index++] = SSD1306_CMD_CONTINUOUS_SCROLL; // 29
+		out_buf[out_index++] = 0x00; // Dummy byte
+		out_buf[out_index++] = 0x00; // Define start page address
+		out_buf[out_index++] = (uint8_t)frame_frequency; // Frame frequency
+		out_buf[out_index++] = 0x00; // Define end page address
+		out_buf[out_index++] = 0x01; // Vertical scrolling offset
+
+		out_buf[out_index++] = SSD1306_CMD_VERTICAL; // A3
+		out_buf[out_index++] = 0x00;
+		if (handle->height == 128)
+			out_buf[out_index++] = 0x80;
+		if (handle->height == 64)
+			out_buf[out_index++] = 0x40;
+		if (handle->height == 32)
+			out_buf[out_index++] = 0x20;
+		out_buf[out_index++] = SSD1306_CMD_ACTIVE_SCROLL; // 2F
+	}
+
+	if (scroll == SSD1306_SCROLL_STOP) {
+		out_buf[out_index++] = SSD1306_CMD_DEACTIVE_SCROLL; // 2E
+	}
+
+	ESP_RETURN_ON_ERROR(ssd1306_write(handle, out_buf, out_index), TAG, "write hardware scroll configuration failed");
+
+	return ESP_OK;
+}
+
+// delay = 0 : display with no wait
+// delay > 0 : display with wait
+// delay < 0 : no display
+esp_err_t ssd1306_display_wrap_around(ssd1306_handle_t handle, ssd1306_scroll_types_t scroll, uint8_t start, uint8_t end, int8_t delay) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	if (scroll == SSD1306_SCROLL_RIGHT) {
+		uint8_t _start = start; // 0 to 7
+		uint8_t _end = end; // 0 to 7
+		if (_end >= handle->pages) _end = handle->pages - 1;
+		uint8_t wk;
+		for (uint8_t page = _start; page <= _end;page++) {
+			wk = handle->page[page].segment[127];
+			for (uint8_t seg = 127; seg > 0; seg--) {
+				handle->page[page].segment[seg] = handle->page[page].segment[seg-1];
+			}
+			handle->page[page].segment[0] = wk;
+		}
+	} else if (scroll == SSD1306_SCROLL_LEFT) {
+		uint8_t _start = start; // 0 to 7
+		uint8_t _end = end; // 0 to 7
+		if (_end >= handle->pages) _end = handle->pages - 1;
+		uint8_t wk;
+		for (uint8_t page=_start;page<=_end;page++) {
+			wk = handle->page[page].segment[0];
+			for (uint8_t seg = 0; seg < 127; seg++) {
+				handle->page[page].segment[seg] = handle->page[page].segment[seg+1];
+			}
+			handle->page[page].segment[127] = wk;
+		}
+
+	} else if (scroll == SSD1306_SCROLL_UP) {
+		uint8_t _start = start; // 0 to {width-1}
+		uint8_t _end = end; // 0 to {width-1}
+		if (_end >= handle->width) _end = handle->width - 1;
+		uint8_t wk0;
+		uint8_t wk1;
+		uint8_t wk2;
+		uint8_t save[128];
+		// Save pages 0
+		for (uint8_t seg = 0; seg < 128; seg++) {
+			save[seg] = handle->page[0].segment[seg];
+		}
+		// Page0 to Page6
+		for (uint8_t page=0; page < handle->pages-1; page++) {
+			for (uint8_t seg = _start; seg <= _end; seg++) {
+				wk0 = handle->page[page].segment[seg];
+				wk1 = handle->page[page+1].segment[seg];
+				if (seg == 0) {
+					ESP_LOGD(TAG, "b page=%d wk0=%02x wk1=%02x", page, wk0, wk1);
+				}
+				wk0 = wk0 >> 1;
+				wk1 = wk1 & 0x01;
+				wk1 = wk1 << 7;
+				wk2 = wk0 | wk1;
+				if (seg == 0) {
+					ESP_LOGD(TAG, "a page=%d wk0=%02x wk1=%02x wk2=%02x", page, wk0, wk1, wk2);
+				}
+				handle->page[page].segment[seg] = wk2;
+			}
+		}
+		// Page7
+		uint8_t pages = handle->pages-1;
+		for (uint8_t seg = _start; seg <= _end; seg++) {
+			wk0 = handle->page[pages].segment[seg];
+			wk1 = save[seg];
+			wk0 = wk0 >> 1;
+			wk1 = wk1 & 0x01;
+			wk1 = wk1 << 7;
+			wk2 = wk0 | wk1;
+			handle->page[pages].segment[seg] = wk2;
+		}
+
+	} else if (scroll == SSD1306_SCROLL_DOWN) {
+		uint8_t _start = start; // 0 to {width-1}
+		uint8_t _end = end; // 0 to {width-1}
+		if (_end >= handle->width) _end = handle->width - 1;
+		uint8_t wk0;
+		uint8_t wk1;
+		uint8_t wk2;
+		uint8_t save[128];
+		// Save pages 7
+		uint8_t pages = handle->pages-1;
+		for (uint8_t seg = 0; seg < 128; seg++) {
+			save[seg] = handle->page[pages].segment[seg];
+		}
+		// Page7 to Page1
+		for (uint8_t page = pages; page > 0; page--) {
+			for (uint8_t seg = _start; seg <= _end; seg++) {
+				wk0 = handle->page[page].segment[seg];
+				wk1 = handle->page[page-1].segment[seg];
+				if (seg == 0) {
+					ESP_LOGD(TAG, "b page=%d wk0=%02x wk1=%02x", page, wk0, wk1);
+				}
+				wk0 = wk0 << 1;
+				wk1 = wk1 & 0x80;
+				wk1 = wk1 >> 7;
+				wk2 = wk0 | wk1;
+				if (seg == 0) {
+					ESP_LOGD(TAG, "a page=%d wk0=%02x wk1=%02x wk2=%02x", page, wk0, wk1, wk2);
+				}
+				handle->page[page].segment[seg] = wk2;
+			}
+		}
+		// Page0
+		for (uint8_t seg = _start; seg <= _end; seg++) {
+			wk0 = handle->page[0].segment[seg];
+			wk1 = save[seg];
+			wk0 = wk0 << 1;
+			wk1 = wk1 & 0x80;
+			wk1 = wk1 >> 7;
+			wk2 = wk0 | wk1;
+			handle->page[0].segment[seg] = wk2;
+		}
+
+	}
+
+	ssd1327_expand_pages(handle);
+	ssd1306_mark_dirty_all(handle);
+
+	if(delay >= 0) {
+		for (uint8_t page = 0; page < handle->pages; page++) {
+			ESP_RETURN_ON_ERROR(ssd1306_display_image(handle, page, 0, handle->page[page].segment, 128), TAG, "display image for wrap around failed");
+			if (delay) vTaskDelay(delay / portTICK_PERIOD_MS);;
+		}
+	}
+
+	return ESP_OK;
+}
+
+void ssd1306_invert_buffer(uint8_t *buf, size_t blen) {
+	uint8_t wk;
+	for(uint16_t i = 0; i < blen; i++) {
+		wk = buf[i];
+		buf[i] = ~wk;
+	}
+}
+
+uint8_t ssd1306_copy_bit(uint8_t src, uint8_t src_bits, uint8_t dst, uint8_t dst_bits) {
+	ESP_LOGD(TAG, "src=%02x src_bits=%d dst=%02x dst_bits=%d", src, src_bits, dst, dst_bits);
+
+	uint8_t smask = 0x01 << src_bits;
+	uint8_t dmask = 0x01 << dst_bits;
+	uint8_t _src = src & smask;
+	uint8_t _dst;
+
+	if (_src != 0) {
+		_dst = dst | dmask; // set bit
+	} else {
+		_dst = dst & ~(dmask); // clear bit
+	}
+
+	return _dst;
+}
+
+// Flip upside down
+void ssd1306_flip_buffer(uint8_t *buf, size_t blen) {
+	for(uint16_t i = 0; i < blen; i++) {
+		buf[i] = ssd1306_rotate_byte(buf[i]);
+	}
+}
+
+
+uint8_t ssd1306_rotate_byte(uint8_t ch1) {
+	uint8_t ch2 = 0;
+
+	for (int8_t j = 0; j < 8; j++) {
+		ch2 = (ch2 << 1) + (ch1 & 0x01);
+		ch1 = ch1 >> 1;
+	}
+
+	return ch2;
+}
+
+esp_err_t ssd1306_display_fadeout(ssd1306_handle_t handle) {
+	uint8_t image[1];
+
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	for(uint8_t page = 0; page < handle->pages; page++) {
+		image[0] = 0xFF;
+		for(uint8_t line=0; line<8; line++) {
+			image[0] = image[0] << 1;
+			for(uint8_t seg = 0; seg < 128; seg++) {
+				ESP_RETURN_ON_ERROR(ssd1306_display_image(handle, page, seg, image, 1), TAG, "display image for fadeout failed");
+				handle->page[page].segment[seg] = image[0];
+			}
+		}
+	}
+
+	return ESP_OK;
+}
+
+static inline esp_err_t ssd1306_setup(ssd1306_handle_t handle) {
+	uint8_t	out_buf[40];
+	uint8_t	out_index = 0;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	out_buf[out_index++] = SSD1306_CONTROL_BYTE_CMD_STREAM;
+	out_buf[out_index++] = SSD1306_CMD_DISPLAY_OFF;	         // AE
+	out_buf[out_index++] = SSD1306_CMD_SET_MUX_RATIO;           // A8
+	if (handle->height == 128) out_buf[out_index++] = 0x7F;
+	if (handle->height == 64) out_buf[out_index++] = 0x3F;
+	if (handle->height == 32) out_buf[out_index++] = 0x1F;
+	out_buf[out_index++] = SSD1306_CMD_SET_DISPLAY_OFFSET;      // D3
+	out_buf[out_index++] = 0x00;
+	out_buf[out_index++] = SSD1306_CMD_SET_DISPLAY_START_LINE;	 // 40
+	if (handle->hw_flip) {
+		/* rotate 180 degrees in hardware, framebuffer stays in canonical orientation */
+		out_buf[out_index++] = SSD1306_CMD_SET_SEGMENT_REMAP_0; // A0
+		out_buf[out_index++] = SSD1306_CMD_SET_COM_SCAN_NORMAL;	// C0
+	} else {
+		out_buf[out_index++] = SSD1306_CMD_SET_SEGMENT_REMAP_1;  // A1
+		out_buf[out_index++] = SSD1306_CMD_SET_COM_SCAN_REMAP;	// C8
+	}
+	out_buf[out_index++] = SSD1306_CMD_SET_DISPLAY_CLK_DIV;		// D5
+	out_buf[out_index++] = 0x80;
+	out_buf[out_index++] = SSD1306_CMD_SET_COM_PIN_MAP;			// DA 0x12 if height > 32 else 0x02
+	if (handle->height == 128) out_buf[out_index++] = 0x12;
+	if (handle->height == 64) out_buf[out_index++] = 0x12;
+	if (handle->height == 32) out_buf[out_index++] = 0x02;
+	out_buf[out_index++] = SSD1306_CMD_SET_CONTRAST;			// 81
+	out_buf[out_index++] = 0xFF;
+	out_buf[out_index++] = SSD1306_CMD_DISPLAY_RAM;				// A4
+	out_buf[out_index++] = SSD1306_CMD_SET_VCOMH_DESELCT;		// DB
+	out_buf[out_index++] = 0x40;
+	out_buf[out_index++] = SSD1306_CMD_SET_MEMORY_ADDR_MODE;	// 20
+	out_buf[out_index++] = SSD1306_CMD_SET_PAGE_ADDR_MODE;		// 02
+	// Set Lower Column Start Address for Page Addressing Mode
+	out_buf[out_index++] = 0x00;
+	// Set Higher Column Start Address for Page Addressing Mode
+	out_buf[out_index++] = 0x10;
+	out_buf[out_index++] = SSD1306_CMD_SET_CHARGE_PUMP;			// 8D
+	out_buf[out_index++] = 0x14;
+	out_buf[out_index++] = SSD1306_CMD_DEACTIVE_SCROLL;			// 2E
+	out_buf[out_index++] = SSD1306_CMD_DISPLAY_NORMAL;			// A6
+	out_buf[out_index++] = SSD1306_CMD_DISPLAY_ON;				// AF
+
+	ESP_RETURN_ON_ERROR(ssd1306_write(handle, out_buf, out_index), TAG, "write setup configuration failed");
+
+	handle->dev_config.display_enabled = true;
+
+	return ESP_OK;
+}
+
+static inline esp_err_t ssd1327_setup(ssd1306_handle_t handle) {
+	uint8_t	out_buf[40];
+	uint8_t	out_index = 0;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	out_buf[out_index++] = SSD1306_CONTROL_BYTE_CMD_STREAM;
+	out_buf[out_index++] = SSD1327_CMD_SET_COMMAND_LOCK;		// FD
+	out_buf[out_index++] = 0x12;
+	out_buf[out_index++] = SSD1306_CMD_DISPLAY_OFF;				// AE
+	out_buf[out_index++] = SSD1327_CMD_SET_COLUMN_RANGE;		// 15
+	out_buf[out_index++] = 0x00;
+	out_buf[out_index++] = SSD1327_ROW_BYTES - 1;
+	out_buf[out_index++] = SSD1327_CMD_SET_ROW_RANGE;			// 75
+	out_buf[out_index++] = 0x00;
+	out_buf[out_index++] = handle->height - 1;
+	out_buf[out_index++] = SSD1306_CMD_SET_CONTRAST;			// 81
+	out_buf[out_index++] = 0x80;
+	out_buf[out_index++] = SSD1327_CMD_SET_REMAP;				// A0
+	out_buf[out_index++] = handle->hw_flip ? SSD1327_REMAP_FLIPPED : SSD1327_REMAP_NORMAL;
+	out_buf[out_index++] = SSD1327_CMD_SET_START_LINE;			// A1
+	out_buf[out_index++] = 0x00;
+	out_buf[out_index++] = SSD1327_CMD_SET_DISPLAY_OFFSET;		// A2
+	out_buf[out_index++] = 0x00;
+	out_buf[out_index++] = SSD1306_CMD_DISPLAY_RAM;				// A4
+	out_buf[out_index++] = SSD1306_CMD_SET_MUX_RATIO;			// A8
+	out_buf[out_index++] = handle->height - 1;
+	out_buf[out_index++] = SSD1327_CMD_SET_FUNCTION_A;			// AB
+	out_buf[out_index++] = 0x01;
+	out_buf[out_index++] = SSD1327_CMD_SET_PHASE_LENGTH;		// B1
+	out_buf[out_index++] = 0xF1;
+	out_buf[out_index++] = SSD1327_CMD_SET_CLK_DIV;				// B3
+	out_buf[out_index++] = 0x00;
+	out_buf[out_index++] = SSD1327_CMD_SET_PRECHARGE2;			// B6
+	out_buf[out_index++] = 0x0F;
+	out_buf[out_index++] = SSD1327_CMD_SET_VCOMH;				// BE
+	out_buf[out_index++] = 0x0F;
+	out_buf[out_index++] = SSD1327_CMD_SET_PRECHARGE_VOLTAGE;	// BC
+	out_buf[out_index++] = 0x08;
+	out_buf[out_index++] = SSD1327_CMD_SET_FUNCTION_B;			// D5
+	out_buf[out_index++] = 0x62;
+	out_buf[out_index++] = SSD1306_CMD_DISPLAY_ON;				// AF
+
+	ESP_RETURN_ON_ERROR(ssd1306_write(handle, out_buf, out_index), TAG, "write ssd1327 setup configuration failed");
+
+	handle->dev_config.display_enabled = true;
+
+	return ESP_OK;
+}
+
+/**
+ * @brief SSD1306 panel properties, page buffer, frame lock and display setup shared by every transport.
+ * 
+ * @param handle SSD1306 device handle with its transport attached.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t ssd1306_init_panel(ssd1306_handle_t handle) {
+    /* set panel properties */
+	handle->width  = ssd1306_panel_properties[handle->dev_config.panel_size].width;
+	handle->height = ssd1306_panel_properties[handle->dev_config.panel_size].height;
+	handle->pages  = ssd1306_panel_properties[handle->dev_config.panel_size].pages;
+	/* the ssd1327 grayscale window path has no software flip, it always re-maps */
+	handle->hw_flip = handle->dev_config.flip_enabled && ssd1306_panel_properties[handle->dev_config.panel_size].remap_supported &&
+					  (!handle->dev_config.remap_disabled || handle->dev_config.panel_size == SSD1306_PANEL_128x128);
+
+    /* initialize page and segment buffer */
+	for (uint8_t i = 0; i < handle->pages; i++) {
+		memset(handle->page[i].segment, 0, SSD1306_PAGE_SEGMENT_SIZE);
+	}
+
+	/* create frame lock when the handle is shared between tasks */
+	if (handle->dev_config.frame_lock_enabled) {
+		handle->frame_lock = xSemaphoreCreateMutex();
+		ESP_RETURN_ON_FALSE(handle->frame_lock, ESP_ERR_NO_MEM, TAG, "no memory for ssd1306 frame lock, init failed");
+	}
+
+	/* the 128x128 panel is an ssd1327 with a 4-bit grayscale frame */
+	if (handle->dev_config.panel_size == SSD1306_PANEL_128x128) {
+		handle->gray_buffer = calloc(handle->height, SSD1327_ROW_BYTES);
+		ESP_RETURN_ON_FALSE(handle->gray_buffer, ESP_ERR_NO_MEM, TAG, "no memory for ssd1327 grayscale buffer, init failed");
+		handle->gray_level = 0x0F;
+
+		ESP_RETURN_ON_ERROR(ssd1327_setup(handle), TAG, "panel setup for init failed");
+
+		return ESP_OK;
+	}
+
+	/* attempt to setup display */
+	ESP_RETURN_ON_ERROR(ssd1306_setup(handle), TAG, "panel setup for init failed");
+
+	return ESP_OK;
+}
+
+/**
+ * @brief SSD1306 handle resources release, the transport device is removed by the caller.
+ * 
+ * @param handle SSD1306 device handle.
+ */
+static void ssd1306_free_handle(ssd1306_handle_t handle) {
+	if (handle->frame_lock) {
+		vSemaphoreDelete(handle->frame_lock);
+	}
+	if (handle->spi_buffer) {
+		heap_caps_free(handle->spi_buffer);
+	}
+	free(handle->gray_buffer);
+	free(handle);
+}
+
+/**
+ * @brief Writes a pattern into the first display rows at the current I2C clock, every transaction must be acknowledged.
+ * 
+ * @note The controller has no I2C read path, a clock is verified by acknowledged pattern writes.
+ * Display RAM is overwritten and must be restored by the caller.
+ * 
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t ssd1306_i2c_verify_clock(ssd1306_handle_t handle) {
+	uint8_t buffer[1 + SSD1306_PAGE_SEGMENT_SIZE];
+	const uint8_t ssd1306_cmds[] = {
+		SSD1306_CONTROL_BYTE_CMD_STREAM,
+		0x00, 0x10, 0xB0							// column 0, page 0
+	};
+	const uint8_t ssd1327_cmds[] = {
+		SSD1306_CONTROL_BYTE_CMD_STREAM,
+		SSD1327_CMD_SET_COLUMN_RANGE, 0x00, SSD1327_ROW_BYTES - 1,
+		SSD1327_CMD_SET_ROW_RANGE, 0x00, 0x01		// rows 0 and 1
+	};
+	const uint8_t *cmds = handle->gray_buffer ? ssd1327_cmds : ssd1306_cmds;
+	const size_t cmds_size = handle->gray_buffer ? sizeof(ssd1327_cmds) : sizeof(ssd1306_cmds);
+
+	buffer[0] = SSD1306_CONTROL_BYTE_DATA_STREAM;
+
+	for (uint8_t round = 0; round < I2C_CLK_VERIFY_ROUNDS; round++) {
+		/* alternating bits mixed with a per round counter toggle every data line state */
+		for (uint8_t i = 0; i < SSD1306_PAGE_SEGMENT_SIZE; i++) {
+			buffer[1 + i] = (uint8_t)((0x55 << ((i + round) & 0x01)) ^ (i * 37) ^ round);
+		}
+		ESP_RETURN_ON_ERROR(i2c_master_transmit(handle->i2c_handle, cmds, cmds_size, I2C_XFR_TIMEOUT_MS), TAG, "i2c verify commands failed");
+		ESP_RETURN_ON_ERROR(i2c_master_transmit(handle->i2c_handle, buffer, sizeof(buffer), I2C_XFR_TIMEOUT_MS), TAG, "i2c verify pattern failed");
+	}
+
+	return ESP_OK;
+}
+
+/**
+ * @brief Probes faster I2C clocks after the configured one and keeps the fastest verified clock.
+ * 
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t ssd1306_i2c_negotiate_clock(ssd1306_handle_t handle) {
+	uint32_t clock_speed = handle->i2c_clock_speed;
+
+	for (uint8_t i = 0; i < sizeof(ssd1306_i2c_clock_speeds) / sizeof(ssd1306_i2c_clock_speeds[0]); i++) {
+		if (ssd1306_i2c_clock_speeds[i] <= clock_speed) continue;
+		if (ssd1306_i2c_set_clock_speed(handle, ssd1306_i2c_clock_speeds[i]) != ESP_OK) break;
+		if (ssd1306_i2c_verify_clock(handle) != ESP_OK) break;
+		clock_speed = ssd1306_i2c_clock_speeds[i];
+	}
+
+	if (handle->i2c_clock_speed != clock_speed) {
+		ESP_RETURN_ON_ERROR(ssd1306_i2c_set_clock_speed(handle, clock_speed), TAG, "i2c restore verified clock failed");
+	}
+
+	ESP_LOGI(TAG, "i2c clock negotiated at %" PRIu32 " Hz", clock_speed);
+
+	/* restore display ram overwritten by the verify pattern */
+	ESP_RETURN_ON_ERROR(ssd1306_display_pages(handle), TAG, "display pages after clock negotiation failed");
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_init(i2c_master_bus_handle_t master_handle, const ssd1306_config_t *ssd1306_config, ssd1306_handle_t *ssd1306_handle) {
+	/* validate arguments */
+	ESP_ARG_CHECK( master_handle && ssd1306_config );
+
+	/* validate device exists on the master bus */
+    esp_err_t ret = i2c_master_probe(master_handle, ssd1306_config->i2c_address, I2C_XFR_TIMEOUT_MS);
+    ESP_GOTO_ON_ERROR(ret, err, TAG, "device does not exist at address 0x%02x, ssd1306 device handle initialization failed", ssd1306_config->i2c_address);
+
+	/* validate memory availability for handle */
+	ssd1306_handle_t out_handle;
+    out_handle = (ssd1306_handle_t)calloc(1, sizeof(*out_handle));
+    ESP_GOTO_ON_FALSE(out_handle, ESP_ERR_NO_MEM, err, TAG, "no memory for i2c ssd1306 device, init failed");
+
+	/* copy configuration */
+    out_handle->dev_config = *ssd1306_config;
+	out_handle->transport  = &ssd1306_transports[SSD1306_TRANSPORT_I2C];
+#if CONFIG_SSD1306_I2C_STATS
+	out_handle->i2c_stats_start_us = esp_timer_get_time();
+#endif
+
+	/* add device to the master bus at the configured clock */
+	out_handle->i2c_bus_handle = master_handle;
+	ESP_GOTO_ON_ERROR(ssd1306_i2c_set_clock_speed(out_handle, out_handle->dev_config.i2c_clock_speed), err_handle, TAG, "i2c new bus for init failed");
+
+	/* attempt to setup panel */
+	ESP_GOTO_ON_ERROR(ssd1306_init_panel(out_handle), err_handle, TAG, "panel init for i2c init failed");
+
+	/* attempt to settle on the fastest verified clock */
+	if (out_handle->dev_config.clock_negotiation_enabled) {
+		ESP_GOTO_ON_ERROR(ssd1306_i2c_negotiate_clock(out_handle), err_handle, TAG, "i2c clock negotiation for init failed");
+	}
+
+	/* set device handle */
+    *ssd1306_handle = out_handle;
+
+    return ESP_OK;
+
+    err_handle:
+        if (out_handle && out_handle->i2c_handle) {
+            i2c_master_bus_rm_device(out_handle->i2c_handle);
+        }
+        ssd1306_free_handle(out_handle);
+    err:
+        return ret;
+}
+
+esp_err_t ssd1306_spi_init(spi_host_device_t host, const ssd1306_spi_config_t *spi_config, const ssd1306_config_t *ssd1306_config, ssd1306_handle_t *ssd1306_handle) {
+	esp_err_t ret = ESP_OK;
+
+	/* validate arguments */
+	ESP_ARG_CHECK( spi_config && ssd1306_config && spi_config->dc_io_num >= 0 );
+
+	/* validate memory availability for handle */
+	ssd1306_handle_t out_handle;
+    out_handle = (ssd1306_handle_t)calloc(1, sizeof(*out_handle));
+    ESP_GOTO_ON_FALSE(out_handle, ESP_ERR_NO_MEM, err, TAG, "no memory for spi ssd1306 device, init failed");
+
+	/* copy configuration */
+    out_handle->dev_config = *ssd1306_config;
+	out_handle->spi_config = *spi_config;
+	out_handle->transport  = &ssd1306_transports[SSD1306_TRANSPORT_SPI];
+
+	/* dma buffer holds the largest decoded transaction, a full frame */
+	out_handle->spi_buffer_size = SSD1306_CMD_LIST_FRAME_SIZE(ssd1306_panel_properties[ssd1306_config->panel_size].pages);
+	out_handle->spi_buffer = heap_caps_malloc(out_handle->spi_buffer_size, MALLOC_CAP_DMA);
+	ESP_GOTO_ON_FALSE(out_handle->spi_buffer, ESP_ERR_NO_MEM, err_handle, TAG, "no memory for spi ssd1306 dma buffer, init failed");
+
+	/* configure d/c and optional reset lines */
+	gpio_config_t io_conf = {
+		.pin_bit_mask = (1ULL << spi_config->dc_io_num),
+		.mode         = GPIO_MODE_OUTPUT,
+	};
+	if (spi_config->rst_io_num >= 0) {
+		io_conf.pin_bit_mask |= (1ULL << spi_config->rst_io_num);
+	}
+	ESP_GOTO_ON_ERROR(gpio_config(&io_conf), err_handle, TAG, "gpio config for spi init failed");
+
+	if (spi_config->rst_io_num >= 0) {
+		gpio_set_level(spi_config->rst_io_num, 0);
+		vTaskDelay(pdMS_TO_TICKS(10));
+		gpio_set_level(spi_config->rst_io_num, 1);
+		vTaskDelay(pdMS_TO_TICKS(10));
+	}
+
+	/* set device configuration */
+	const spi_device_interface_config_t spi_dev_conf = {
+		.mode           = 0,
+		.clock_speed_hz = spi_config->clock_speed_hz,
+		.spics_io_num   = spi_config->cs_io_num,
+		.queue_size     = SSD1306_SPI_MAX_SEGMENTS,
+		.pre_cb         = ssd1306_spi_pre_transfer_cb,
+	};
+
+	ESP_GOTO_ON_ERROR(spi_bus_add_device(host, &spi_dev_conf, &out_handle->spi_handle), err_handle, TAG, "spi add device for init failed");
+
+	/* attempt to setup panel */
+	ESP_GOTO_ON_ERROR(ssd1306_init_panel(out_handle), err_handle, TAG, "panel init for spi init failed");
+
+	/* set device handle */
+    *ssd1306_handle = out_handle;
+
+    return ESP_OK;
+
+    err_handle:
+        if (out_handle && out_handle->spi_handle) {
+            spi_bus_remove_device(out_handle->spi_handle);
+        }
+        ssd1306_free_handle(out_handle);
+    err:
+        return ret;
+}
+
+esp_err_t ssd1306_begin_frame(ssd1306_handle_t handle, uint32_t timeout_ms) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	/* handles without a frame lock are owned by a single task */
+	if (handle->frame_lock == NULL) return ESP_OK;
+
+	if (xSemaphoreTake(handle->frame_lock, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+		return ESP_ERR_TIMEOUT;
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_end_frame(ssd1306_handle_t handle) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	if (handle->frame_lock == NULL) return ESP_OK;
+
+	/* giving a mutex held by another task asserts in FreeRTOS, check the holder first */
+	ESP_RETURN_ON_FALSE(xSemaphoreGetMutexHolder(handle->frame_lock) == xTaskGetCurrentTaskHandle(), ESP_ERR_INVALID_STATE, TAG, "frame lock not held by caller");
+
+	xSemaphoreGive(handle->frame_lock);
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_get_i2c_clock_speed(ssd1306_handle_t handle, uint32_t *const clock_speed) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle && clock_speed );
+
+	*clock_speed = handle->i2c_clock_speed;
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_get_i2c_stats(ssd1306_handle_t handle, ssd1306_i2c_stats_t *stats) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle && stats );
+
+#if CONFIG_SSD1306_I2C_STATS
+	*stats = handle->i2c_stats;
+	stats->clock_speed = handle->i2c_clock_speed;
+	stats->clock_fallbacks = handle->i2c_clock_fallbacks;
+	stats->window_us = (uint64_t)(esp_timer_get_time() - handle->i2c_stats_start_us);
+	stats->busy_percent = (stats->window_us > 0) ? (100.0f * (float)stats->busy_us) / (float)stats->window_us : 0.0f;
+
+	return ESP_OK;
+#else
+	return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t ssd1306_reset_i2c_stats(ssd1306_handle_t handle) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+#if CONFIG_SSD1306_I2C_STATS
+	memset(&handle->i2c_stats, 0, sizeof(handle->i2c_stats));
+	handle->i2c_stats_start_us = esp_timer_get_time();
+
+	return ESP_OK;
+#else
+	return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t ssd1306_dump_i2c_stats(ssd1306_handle_t handle) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+#if CONFIG_SSD1306_I2C_STATS
+	ssd1306_i2c_stats_t stats;
+
+	ESP_RETURN_ON_ERROR(ssd1306_get_i2c_stats(handle, &stats), TAG, "get i2c stats for dump failed");
+
+	printf("ssd1306 0x%02x @ %" PRIu32 " Hz (%" PRIu32 " fallbacks): %" PRIu32 " xfers, %" PRIu32 " bytes, %" PRIu32 " failures, %" PRIu32 " retries, busy %.2f%% of %" PRIu64 " ms, max %" PRIu32 " us\n",
+		(unsigned)handle->dev_config.i2c_address, stats.clock_speed, stats.clock_fallbacks, stats.transactions, stats.bytes, stats.failures, stats.retries,
+		stats.busy_percent, stats.window_us / 1000, stats.latency_max_us);
+	for (uint8_t i = 0; i < SSD1306_I2C_STATS_LATENCY_BUCKETS; i++) {
+		if (stats.latency_hist[i] == 0) continue;
+		printf("  %6" PRIu32 " us%s: %" PRIu32 "\n", UINT32_C(1) << i, (i == SSD1306_I2C_STATS_LATENCY_BUCKETS - 1) ? "+" : " ", stats.latency_hist[i]);
+	}
+
+	return ESP_OK;
+#else
+	return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t ssd1306_remove(ssd1306_handle_t handle) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+    return handle->transport->remove(handle);
+}
+
+esp_err_t ssd1306_delete(ssd1306_handle_t handle) {
+	/* validate arguments */
+    ESP_ARG_CHECK( handle );
+
+    /* remove device from bus */
+    ESP_RETURN_ON_ERROR( ssd1306_remove(handle), TAG, "unable to remove device from bus, delete handle failed" );
+
+    /* free handle, the bus device handle is released by the removal */
+    ssd1306_free_handle(handle);
+
+    return ESP_OK;
+}
+
+const char* ssd1306_get_fw_version(void) {
+    return SSD1306_FW_VERSION_STR;
+}
+
+int32_t ssd1306_get_fw_version_number(void) {
+    return SSD1306_FW_VERSION_INT32;
+}
\ No newline at end of file
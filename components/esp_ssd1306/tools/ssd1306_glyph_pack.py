@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+#
+# The MIT License (MIT)
+#
+# Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+#
+# Host glyph table builder for the ssd1306 driver.
+#
+# Builds a sparse 8x8 glyph table holding only the code points the firmware
+# uses.  Code points are sorted ascending so `ssd1306_get_glyph` finds them by
+# binary search, flash use scales with the subset rather than the font.
+# Code points U+0000 to U+00FF are served by the built-in latin font and are
+# never packed.
+#
+# Glyphs come from a BDF font with glyphs of at most 8x8 pixels (e.g. misaki
+# or unifont-8x8 style fonts) and are stored 90 degree transposed, one byte
+# per column with bit 0 as the top pixel, like `font_latin_8x8_tr`.
+#
+# Code points are taken from `--text` strings and from the string literals of
+# `--scan` source files (UTF-8).
+#
+# Usage:
+#   ssd1306_glyph_pack.py --font font.bdf [--scan main/main.c ...] [--text "°C µs 温度"]
+#                         [--name site_glyphs] [-o site_glyphs.h]
+#
+
+import argparse
+import re
+import sys
+
+LATIN_LAST = 0xFF
+CELL = 8
+
+
+def read_bdf(path):
+    """Reads a BDF font into {code point: 8 transposed column bytes}."""
+    glyphs = {}
+    ascent = CELL
+    with open(path, encoding='latin-1') as f:
+        lines = iter(f.read().splitlines())
+    for line in lines:
+        if line.startswith('FONT_ASCENT'):
+            ascent = int(line.split()[1])
+        if not line.startswith('STARTCHAR'):
+            continue
+        code, bbx, rows = None, (0, 0, 0, 0), []
+        for line in lines:
+            if line.startswith('ENCODING'):
+                code = int(line.split()[1])
+            elif line.startswith('BBX'):
+                bbx = tuple(int(v) for v in line.split()[1:5])
+            elif line.startswith('BITMAP'):
+                for line in lines:
+                    if line.startswith('ENDCHAR'):
+                        break
+                    rows.append(int(line, 16) if line.strip() else 0)
+                break
+        if code is None or code < 0:
+            continue
+        w, h, xoff, yoff = bbx
+        row_bits = ((w + 7) // 8) * 8
+        columns = [0] * CELL
+        top = ascent - (yoff + h)
+        for r, bits in enumerate(rows):
+            y = top + r
+            if y < 0 or y >= CELL:
+                continue
+            for c in range(w):
+                x = xoff + c
+                if 0 <= x < CELL and (bits >> (row_bits - 1 - c)) & 1:
+                    columns[x] |= 1 << y
+        glyphs[code] = columns
+    return glyphs
+
+
+def scan_literals(path):
+    """Collects the code points used in the string literals of a source file."""
+    with open(path, encoding='utf-8') as f:
+        text = f.read()
+    used = set()
+    for literal in re.findall(r'"((?:[^"\\\n]|\\.)*)"', text):
+        used.update(ord(ch) for ch in literal)
+    return used
+
+
+def emit(name, table, missing):
+    guard = '__%s_H__' % name.upper()
+    lines = [
+        '/**',
+        ' * @file %s.h' % name,
+        ' * @defgroup drivers ssd1306',
+        ' * @{',
+        ' *',
+        ' * sparse 8x8 glyph table for `ssd1306_set_glyph_table`',
+        ' *',
+        ' * Generated by tools/ssd1306_glyph_pack.py, do not edit.',
+        ' */',
+        '',
+        '#ifndef %s' % guard,
+        '#define %s' % guard,
+        '',
+        '#include <stdint.h>',
+        '#include "ssd1306.h"',
+        '',
+        '#ifdef __cplusplus',
+        'extern "C" {',
+        '#endif',
+        '',
+    ]
+    if missing:
+        lines.append('/* code points without a glyph, drawn as \'?\': %s */' % ' '.join('U+%04X' % c for c in missing))
+        lines.append('')
+    lines.append('static const uint32_t %s_code_points[] = {' % name)
+    for code, _ in table:
+        lines.append('\t0x%04X,' % code)
+    lines.append('};')
+    lines.append('')
+    lines.append('static const uint8_t %s_glyphs[][8] = {' % name)
+    for code, columns in table:
+        lines.append('\t{ %s },   // U+%04X (%s)' % (', '.join('0x%02X' % b for b in columns), code, chr(code)))
+    lines.append('};')
+    lines.append('')
+    lines += [
+        'static const ssd1306_glyph_table_t %s = {' % name,
+        '\t.code_points = %s_code_points,' % name,
+        '\t.glyphs      = %s_glyphs,' % name,
+        '\t.count       = %d,' % len(table),
+        '};',
+        '',
+        '#ifdef __cplusplus',
+        '}',
+        '#endif',
+        '',
+        '/**@}*/',
+        '',
+        '#endif /* %s */' % guard,
+        '',
+    ]
+    return '\n'.join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Build a sparse 8x8 glyph table for the ssd1306 driver.')
+    parser.add_argument('--font', required=True, help='BDF font with glyphs of at most 8x8 pixels')
+    parser.add_argument('--scan', nargs='*', default=[], help='source files whose string literals are scanned')
+    parser.add_argument('--text', nargs='*', default=[], help='additional UTF-8 text to include')
+    parser.add_argument('--name', default='site_glyphs', help='name of the generated table')
+    parser.add_argument('-o', '--output', help='output header, stdout when omitted')
+    args = parser.parse_args()
+
+    used = set()
+    for path in args.scan:
+        used |= scan_literals(path)
+    for text in args.text:
+        used.update(ord(ch) for ch in text)
+    if not args.scan and not args.text:
+        parser.error('nothing to pack, give --scan and/or --text')
+
+    font = read_bdf(args.font)
+    wanted = sorted(c for c in used if c > LATIN_LAST)
+    table = [(c, font[c]) for c in wanted if c in font]
+    missing = [c for c in wanted if c not in font]
+    for c in missing:
+        sys.stderr.write('warning: no glyph for U+%04X\n' % c)
+
+    out = emit(args.name, table, missing)
+    if args.output:
+        with open(args.output, 'w', encoding='utf-8') as f:
+            f.write(out)
+    else:
+        sys.stdout.write(out)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
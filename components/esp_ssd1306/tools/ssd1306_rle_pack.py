@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+#
+# The MIT License (MIT)
+#
+# Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+#
+# Host asset packer for the ssd1306 driver.
+#
+# Converts 1-bit images into page-major, run-length compressed arrays that
+# `ssd1306_set_rle_image` blits straight into the page segment buffer.
+#
+# Encoded layout:
+#   byte 0      width in pixels
+#   byte 1      height in pixels
+#   byte 2..    runs over page-major segment bytes (page 0 columns 0..w-1,
+#               page 1 columns 0..w-1, ...), bit 0 is the top pixel of a page
+#     0x00-0x7F literal run, (c + 1) segment bytes follow
+#     0x80-0xFF repeat run, next segment byte is repeated (c - 0x80 + 1) times
+#
+# Inputs:
+#   PBM images (P1 or P4), one array per file named after the file
+#   C headers holding row-major, MSB first bitmaps named <name>_<w>x<h>[],
+#   such as include/bitmap_icon.h
+#
+# Usage:
+#   ssd1306_rle_pack.py [-o out.h] [--guard NAME] input.pbm|input.h ...
+#
+
+import argparse
+import os
+import re
+import sys
+
+MAX_RUN = 128
+
+
+def rows_to_pages(rows, width, height):
+    """Converts row-major pixel rows into page-major segment bytes."""
+    pages = (height + 7) // 8
+    out = bytearray(width * pages)
+    for y in range(height):
+        row = rows[y]
+        page, bit = divmod(y, 8)
+        for x in range(width):
+            if row[x]:
+                out[page * width + x] |= 1 << bit
+    return bytes(out)
+
+
+def rle_encode(data):
+    """Encodes segment bytes into literal and repeat runs."""
+    out = bytearray()
+    literal = bytearray()
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and data[i + run] == data[i] and run < MAX_RUN:
+            run += 1
+        if run >= 3:
+            if literal:
+                out.append(len(literal) - 1)
+                out += literal
+                literal.clear()
+            out.append(0x80 | (run - 1))
+            out.append(data[i])
+            i += run
+        else:
+            literal.append(data[i])
+            i += 1
+            if len(literal) == MAX_RUN:
+                out.append(len(literal) - 1)
+                out += literal
+                literal.clear()
+    if literal:
+        out.append(len(literal) - 1)
+        out += literal
+    return bytes(out)
+
+
+def read_pbm(path):
+    """Reads a P1 or P4 portable bitmap into rows of pixels (1 is set)."""
+    with open(path, 'rb') as f:
+        raw = f.read()
+    tokens = []
+    pos = 0
+    # magic, width and height are whitespace separated, comments start with #
+    while len(tokens) < 3:
+        m = re.compile(rb'\s*(#[^\n]*\n\s*)*(\S+)').match(raw, pos)
+        if m is None:
+            raise ValueError('%s: truncated pbm header' % path)
+        tokens.append(m.group(2))
+        pos = m.end()
+    magic, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+    if magic == b'P4':
+        data = raw[pos + 1:]
+        stride = (width + 7) // 8
+        rows = [[(data[y * stride + x // 8] >> (7 - (x % 8))) & 1 for x in range(width)] for y in range(height)]
+    elif magic == b'P1':
+        bits = [int(c) for c in re.sub(rb'#[^\n]*', b'', raw[pos:]).decode() if c in '01']
+        rows = [bits[y * width:(y + 1) * width] for y in range(height)]
+    else:
+        raise ValueError('%s: unsupported pbm type %r' % (path, magic))
+    name = re.sub(r'\W', '_', os.path.splitext(os.path.basename(path))[0])
+    return [(name, width, height, rows)]
+
+
+def read_c_header(path):
+    """Reads row-major bitmaps named <name>_<w>x<h>[] from a C header."""
+    with open(path) as f:
+        text = re.sub(r'/\*.*?\*/', '', f.read(), flags=re.S)
+    images = []
+    for m in re.finditer(r'static\s+const\s+uint8_t\s+(\w+?_(\d+)x(\d+))\s*\[\]\s*=\s*\{(.*?)\};', text, flags=re.S):
+        name, width, height = m.group(1), int(m.group(2)), int(m.group(3))
+        data = [int(v, 0) for v in re.findall(r'0[xX][0-9a-fA-F]+|0[bB][01]+|\d+', m.group(4))]
+        stride = (width + 7) // 8
+        if len(data) < stride * height:
+            raise ValueError('%s: %s holds %d bytes, expected %d' % (path, name, len(data), stride * height))
+        rows = [[(data[y * stride + x // 8] >> (7 - (x % 8))) & 1 for x in range(width)] for y in range(height)]
+        images.append((name, width, height, rows))
+    return images
+
+
+def emit(images, guard, filename):
+    lines = [
+        '/**',
+        ' * @file %s' % filename,
+        ' * @defgroup drivers ssd1306',
+        ' * @{',
+        ' *',
+        ' * page-major, run-length compressed images for `ssd1306_set_rle_image`',
+        ' *',
+        ' * Generated by tools/ssd1306_rle_pack.py, do not edit.',
+        ' */',
+        '',
+        '#ifndef %s' % guard,
+        '#define %s' % guard,
+        '',
+        '#include <stdint.h>',
+        '',
+        '#ifdef __cplusplus',
+        'extern "C" {',
+        '#endif',
+        '',
+    ]
+    for name, width, height, rows in images:
+        if width > 255 or height > 255:
+            raise ValueError('%s: %dx%d exceeds 255x255' % (name, width, height))
+        pages = rows_to_pages(rows, width, height)
+        packed = bytes([width, height]) + rle_encode(pages)
+        raw = ((width + 7) // 8) * height
+        lines.append('/* %s %dx%d, %d bytes (%d row-major) */' % (name, width, height, len(packed), raw))
+        lines.append('static const uint8_t %s_rle[] = {' % name)
+        for i in range(0, len(packed), 16):
+            lines.append('\t' + ' '.join('0x%02x,' % b for b in packed[i:i + 16]))
+        lines.append('};')
+        lines.append('')
+    lines += [
+        '#ifdef __cplusplus',
+        '}',
+        '#endif',
+        '',
+        '/**@}*/',
+        '',
+        '#endif /* %s */' % guard,
+        '',
+    ]
+    return '\n'.join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Pack 1-bit images into page-major RLE arrays for the ssd1306 driver.')
+    parser.add_argument('inputs', nargs='+', help='PBM images or C headers with row-major bitmaps')
+    parser.add_argument('-o', '--output', help='output header, stdout when omitted')
+    parser.add_argument('--guard', default='__BITMAP_RLE_H__', help='include guard of the output header')
+    args = parser.parse_args()
+
+    images = []
+    for path in args.inputs:
+        if path.endswith('.pbm'):
+            images += read_pbm(path)
+        else:
+            images += read_c_header(path)
+
+    out = emit(images, args.guard, os.path.basename(args.output) if args.output else 'bitmap_rle.h')
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(out)
+    else:
+        sys.stdout.write(out)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,29 @@
+/**
+ * @file adv_parse.c
+ * @brief Allocation-free advertising data walker for the sensor fast path.
+ */
+#include "adv_parse.h"
+
+const uint8_t *adv_find_mfg_data(const uint8_t *data, size_t len, uint16_t company_id,
+                                 uint8_t min_len, uint8_t max_len, uint8_t *mfg_len) {
+    const uint8_t id_lo = (uint8_t)(company_id & 0xFF);
+    const uint8_t id_hi = (uint8_t)(company_id >> 8);
+    size_t pos = 0;
+
+    // AD 结构: [length][type][length - 1 字节数据]
+    while (pos < len) {
+        const uint8_t field_len = data[pos];
+        if (field_len == 0) break;                      // 有效数据结束 (填充)
+        if (field_len > len - pos - 1) return NULL;     // 越界，整包丢弃
+
+        const uint8_t *field = &data[pos + 1];
+        if (field[0] == ADV_TYPE_MFG_DATA &&
+            field_len > min_len && field_len <= (size_t)max_len + 1 &&
+            field[1] == id_lo && field[2] == id_hi) {
+            *mfg_len = field_len - 1;
+            return &field[1];
+        }
+        pos += (size_t)field_len + 1;
+    }
+    return NULL;
+}
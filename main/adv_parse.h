@@ -0,0 +1,37 @@
+/**
+ * @file adv_parse.h
+ * @brief Allocation-free advertising data walker for the sensor fast path.
+ *
+ * Walks the AD structures of a legacy or extended advertisement and returns
+ * the first manufacturer-specific field (AD type 0xFF) with the expected
+ * company identifier and a payload length in the accepted range.  Every other AD type is skipped by
+ * its length byte without being decoded.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ADV_TYPE_MFG_DATA   0xFF
+
+/**
+ * Finds the first manufacturer data field whose little-endian company
+ * identifier equals @p company_id and whose length (company identifier
+ * included) lies within [@p min_len, @p max_len], @p min_len must be at
+ * least 2.
+ *
+ * Returns a pointer to the company identifier inside @p data and stores the
+ * field length in @p mfg_len, or returns NULL when there is no match or an AD
+ * structure runs past @p len.  The pointer is not aligned, copy the payload
+ * out before casting it.
+ */
+const uint8_t *adv_find_mfg_data(const uint8_t *data, size_t len, uint16_t company_id,
+                                 uint8_t min_len, uint8_t max_len, uint8_t *mfg_len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,88 @@
+/**
+ * @file fixed_fmt.c
+ * @brief Integer-only formatter for fixed-point sensor readings.
+ */
+#include "fixed_fmt.h"
+
+// 最大 32 位十进制位数 + 符号 + 小数点
+#define FIXED_FMT_DIGITS_MAX 12
+
+static void fixed_fmt_put(fixed_fmt_t *fmt, const char *src, size_t n) {
+    size_t room = fmt->size - 1 - fmt->len;
+    if (n > room) n = room;
+    for (size_t i = 0; i < n; i++) fmt->buf[fmt->len + i] = src[i];
+    fmt->len += n;
+    fmt->buf[fmt->len] = '\0';
+}
+
+// 将数字从右往左写入 tmp，返回首字符位置
+static char *fixed_fmt_digits(char *end, uint32_t value, uint8_t min_digits) {
+    char *p = end;
+    do {
+        *--p = (char)('0' + (value % 10));
+        value /= 10;
+        if (min_digits) min_digits--;
+    } while (value || min_digits);
+    return p;
+}
+
+static void fixed_fmt_put_padded(fixed_fmt_t *fmt, const char *src, size_t n, uint8_t width) {
+    if (width > n) fixed_fmt_fill(fmt, ' ', width - n);
+    fixed_fmt_put(fmt, src, n);
+}
+
+void fixed_fmt_begin(fixed_fmt_t *fmt, char *buf, size_t size) {
+    fmt->buf = buf;
+    fmt->size = size;
+    fmt->len = 0;
+    buf[0] = '\0';
+}
+
+void fixed_fmt_str(fixed_fmt_t *fmt, const char *str) {
+    size_t n = 0;
+    while (str[n]) n++;
+    fixed_fmt_put(fmt, str, n);
+}
+
+void fixed_fmt_fill(fixed_fmt_t *fmt, char ch, size_t count) {
+    size_t room = fmt->size - 1 - fmt->len;
+    if (count > room) count = room;
+    for (size_t i = 0; i < count; i++) fmt->buf[fmt->len + i] = ch;
+    fmt->len += count;
+    fmt->buf[fmt->len] = '\0';
+}
+
+void fixed_fmt_uint(fixed_fmt_t *fmt, uint32_t value, uint8_t width) {
+    char tmp[FIXED_FMT_DIGITS_MAX];
+    char *end = tmp + sizeof(tmp);
+    char *p = fixed_fmt_digits(end, value, 1);
+    fixed_fmt_put_padded(fmt, p, (size_t)(end - p), width);
+}
+
+void fixed_fmt_uint_zero(fixed_fmt_t *fmt, uint32_t value, uint8_t digits) {
+    char tmp[FIXED_FMT_DIGITS_MAX];
+    char *end = tmp + sizeof(tmp);
+    if (digits > FIXED_FMT_DIGITS_MAX) digits = FIXED_FMT_DIGITS_MAX;
+    char *p = fixed_fmt_digits(end, value, digits ? digits : 1);
+    fixed_fmt_put(fmt, p, (size_t)(end - p));
+}
+
+void fixed_fmt_int(fixed_fmt_t *fmt, int32_t value, uint8_t width) {
+    char tmp[FIXED_FMT_DIGITS_MAX];
+    char *end = tmp + sizeof(tmp);
+    uint32_t mag = (value < 0) ? (0u - (uint32_t)value) : (uint32_t)value;
+    char *p = fixed_fmt_digits(end, mag, 1);
+    if (value < 0) *--p = '-';
+    fixed_fmt_put_padded(fmt, p, (size_t)(end - p), width);
+}
+
+void fixed_fmt_centi(fixed_fmt_t *fmt, int32_t centi, uint8_t width) {
+    char tmp[FIXED_FMT_DIGITS_MAX];
+    char *end = tmp + sizeof(tmp);
+    uint32_t mag = (centi < 0) ? (0u - (uint32_t)centi) : (uint32_t)centi;
+    char *p = fixed_fmt_digits(end, mag % 100, 2);
+    *--p = '.';
+    p = fixed_fmt_digits(p, mag / 100, 1);
+    if (centi < 0) *--p = '-';
+    fixed_fmt_put_padded(fmt, p, (size_t)(end - p), width);
+}
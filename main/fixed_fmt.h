@@ -0,0 +1,51 @@
+/**
+ * @file fixed_fmt.h
+ * @brief Integer-only formatter for fixed-point sensor readings.
+ *
+ * Readings travel as centi-units (e.g. 2345 = 23.45 °C).  These helpers render
+ * them, plain integers, padding and unit strings straight into a caller buffer
+ * without newlib's float printf.  The buffer is always NUL-terminated and
+ * output that does not fit is truncated.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    char   *buf;    // 目标缓冲区
+    size_t  size;   // 缓冲区大小 (含结尾 '\0')
+    size_t  len;    // 已写入字节数
+} fixed_fmt_t;
+
+/** Starts a line in @p buf, which must hold at least one byte. */
+void fixed_fmt_begin(fixed_fmt_t *fmt, char *buf, size_t size);
+
+/** Appends a string. */
+void fixed_fmt_str(fixed_fmt_t *fmt, const char *str);
+
+/** Appends a single character @p count times. */
+void fixed_fmt_fill(fixed_fmt_t *fmt, char ch, size_t count);
+
+/** Appends an unsigned integer right-aligned to @p width columns, 0 for no padding. */
+void fixed_fmt_uint(fixed_fmt_t *fmt, uint32_t value, uint8_t width);
+
+/** Appends an unsigned integer zero-padded to at least @p digits digits. */
+void fixed_fmt_uint_zero(fixed_fmt_t *fmt, uint32_t value, uint8_t digits);
+
+/** Appends a signed integer right-aligned to @p width columns, 0 for no padding. */
+void fixed_fmt_int(fixed_fmt_t *fmt, int32_t value, uint8_t width);
+
+/** Appends a centi-unit value as "[-]I.FF" right-aligned to @p width columns, 0 for no padding. */
+void fixed_fmt_centi(fixed_fmt_t *fmt, int32_t centi, uint8_t width);
+
+/** Returns the NUL-terminated line. */
+static inline const char *fixed_fmt_cstr(const fixed_fmt_t *fmt) { return fmt->buf; }
+
+#ifdef __cplusplus
+}
+#endif
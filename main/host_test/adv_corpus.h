@@ -0,0 +1,82 @@
+/**
+ * @file adv_corpus.h
+ * @brief Advert corpus shared by the host tests: third-party adverts seen while scanning, our v1/v2/v3
+ * payloads and malformed variants.  The first CORPUS_THIRD_PARTY entries are third-party adverts.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "adv_parse.h"
+
+#define MANU_ID         0x02E5  // CUSTOM_MANU_ID
+#define PAYLOAD_MIN     9       // sizeof(adv_sensor_data_t)
+#define PAYLOAD_MAX     92      // ADV_PAYLOAD_MAX
+
+typedef struct {
+    const char    *name;
+    const uint8_t *data;
+    size_t         len;
+    int            offset;      // 期望的厂商数据位置 (公司 ID 首字节)，-1 为拒绝
+    uint8_t        mfg_len;
+} corpus_entry_t;
+
+// --- Advert corpus ---
+// 扫描时常见的第三方广播与本项目 v1/v2/v3 负载，以及格式错误的变体
+static const uint8_t ad_ibeacon[] = { 0x02, 0x01, 0x06, 0x1A, 0xFF, 0x4C, 0x00, 0x02, 0x15,
+    0xE2, 0xC5, 0x6D, 0xB5, 0xDF, 0xFB, 0x48, 0xD2, 0xB0, 0x60, 0xD0, 0xF5, 0xA7, 0x10, 0x96, 0xE0,
+    0x00, 0x01, 0x00, 0x02, 0xC5 };
+static const uint8_t ad_eddystone_url[] = { 0x02, 0x01, 0x06, 0x03, 0x03, 0xAA, 0xFE, 0x11, 0x16, 0xAA, 0xFE,
+    0x10, 0xEE, 0x03, 'e', 'x', 'a', 'm', 'p', 'l', 'e', '.', 'c', 'o', 'm' };
+static const uint8_t ad_apple_continuity[] = { 0x02, 0x01, 0x1A, 0x02, 0x0A, 0x0C, 0x0B, 0xFF, 0x4C, 0x00,
+    0x10, 0x06, 0x13, 0x1D, 0x8E, 0x2B, 0x63, 0x11, 0x05, 0x09, 'P', 'i', 'x', 'l' };
+static const uint8_t ad_microsoft_cdp[] = { 0x1E, 0xFF, 0x06, 0x00, 0x01, 0x09, 0x20, 0x02, 0x3A, 0x7C,
+    0x1B, 0x42, 0x90, 0x5E, 0x11, 0x8C, 0xB4, 0x2D, 0x0F, 0x77, 0x6A, 0x2B, 0x18, 0xC3, 0x50, 0x91,
+    0x04, 0x6E, 0x88, 0x1F, 0x3D };
+static const uint8_t ad_uuid128_tv[] = { 0x02, 0x01, 0x06, 0x11, 0x07, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+    0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x09, 0xFF, 0x75, 0x00, 0x42, 0x04,
+    0x01, 0x80, 0x60, 0x00 };
+static const uint8_t ad_v1[] = { 0x02, 0x01, 0x06, 0x0A, 0xFF, 0xE5, 0x02, 0x07, 0x29, 0x09, 0x10, 0x17,
+    0x2C, 0x01 };
+static const uint8_t ad_v2_after_name[] = { 0x02, 0x01, 0x06, 0x06, 0x09, 'n', 'o', 'd', 'e', '7',
+    0x0D, 0xFF, 0xE5, 0x02, 0x02, 0x07, 0x34, 0x12, 0x29, 0x09, 0x10, 0x17, 0x2C, 0x01 };
+static const uint8_t ad_v1_padded[] = { 0x0A, 0xFF, 0xE5, 0x02, 0x07, 0x29, 0x09, 0x10, 0x17, 0x2C, 0x01,
+    0x00, 0x00, 0x00, 0x00 };
+static const uint8_t ad_other_company_first[] = { 0x05, 0xFF, 0x59, 0x00, 0xAB, 0xCD,
+    0x0A, 0xFF, 0xE5, 0x02, 0x07, 0x29, 0x09, 0x10, 0x17, 0x2C, 0x01 };
+static const uint8_t ad_short_ours[] = { 0x02, 0x01, 0x06, 0x05, 0xFF, 0xE5, 0x02, 0x07, 0x29 };
+static const uint8_t ad_truncated[] = { 0x02, 0x01, 0x06, 0x1E, 0xFF, 0xE5, 0x02, 0x07 };
+static const uint8_t ad_after_padding[] = { 0x02, 0x01, 0x06, 0x00, 0x0A, 0xFF, 0xE5, 0x02, 0x07, 0x29,
+    0x09, 0x10, 0x17, 0x2C, 0x01 };
+static const uint8_t ad_type_only[] = { 0x01, 0xFF, 0x01, 0x09 };
+static uint8_t ad_v3_extended[3 + 2 + PAYLOAD_MAX];     // 扩展广播，最大 v3 负载
+static uint8_t ad_v3_too_long[3 + 2 + PAYLOAD_MAX + 1];
+
+static const corpus_entry_t corpus[] = {
+    { "ibeacon",              ad_ibeacon,             sizeof(ad_ibeacon),             -1, 0 },
+    { "eddystone url",        ad_eddystone_url,       sizeof(ad_eddystone_url),       -1, 0 },
+    { "apple continuity",     ad_apple_continuity,    sizeof(ad_apple_continuity),    -1, 0 },
+    { "microsoft cdp",        ad_microsoft_cdp,       sizeof(ad_microsoft_cdp),       -1, 0 },
+    { "uuid128 tv",           ad_uuid128_tv,          sizeof(ad_uuid128_tv),          -1, 0 },
+    { "v1",                   ad_v1,                  sizeof(ad_v1),                   5, 9 },
+    { "v2 after name",        ad_v2_after_name,       sizeof(ad_v2_after_name),       12, 12 },
+    { "v1 padded",            ad_v1_padded,           sizeof(ad_v1_padded),            2, 9 },
+    { "other company first",  ad_other_company_first, sizeof(ad_other_company_first),  8, 9 },
+    { "v3 extended",          ad_v3_extended,         sizeof(ad_v3_extended),          5, PAYLOAD_MAX },
+    { "short ours",           ad_short_ours,          sizeof(ad_short_ours),          -1, 0 },
+    { "truncated",            ad_truncated,           sizeof(ad_truncated),           -1, 0 },
+    { "after padding",        ad_after_padding,       sizeof(ad_after_padding),       -1, 0 },
+    { "type only",            ad_type_only,           sizeof(ad_type_only),           -1, 0 },
+    { "v3 too long",          ad_v3_too_long,         sizeof(ad_v3_too_long),         -1, 0 },
+};
+
+#define CORPUS_COUNT        (sizeof(corpus) / sizeof(corpus[0]))
+#define CORPUS_THIRD_PARTY  5
+
+static inline void build_v3(uint8_t *ad, size_t len) {
+    memset(ad, 0x11, len);
+    ad[0] = 0x02, ad[1] = 0x01, ad[2] = 0x06;
+    ad[3] = (uint8_t)(len - 4), ad[4] = ADV_TYPE_MFG_DATA;
+    ad[5] = MANU_ID & 0xFF, ad[6] = MANU_ID >> 8, ad[7] = 3;
+}
@@ -0,0 +1,18 @@
+/**
+ * @file host_test.h
+ * @brief Minimal check macros for the gateway host tests, a failed check is reported and counted.
+ */
+#pragma once
+
+#include <stdio.h>
+
+static int host_test_failures;
+
+#define CHECK(cond) do {                                                        \
+        if (!(cond)) {                                                          \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            host_test_failures++;                                               \
+        }                                                                       \
+    } while (0)
+
+#define HOST_TEST_RESULT(name) (printf("%s: %s\n", (name), host_test_failures ? "FAIL" : "PASS"), host_test_failures ? 1 : 0)
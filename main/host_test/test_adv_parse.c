@@ -0,0 +1,147 @@
+/**
+ * @file test_adv_parse.c
+ * @brief adv_find_mfg_data against a corpus of real-world advertising payloads and random bytes,
+ * benchmarked against a general parser that decodes every AD type like ble_hs_adv_parse_fields.
+ */
+#include <string.h>
+#include <time.h>
+#include "adv_corpus.h"
+#include "host_test.h"
+
+#define BENCH_ROUNDS    1000000
+
+// --- General parser ---
+// 与 ble_hs_adv_parse_fields 相同的做法: 清零字段结构并解码每一种 AD 类型
+typedef struct {
+    uint8_t        flags;
+    const uint8_t *uuids16;
+    uint8_t        num_uuids16;
+    const uint8_t *uuids128;
+    uint8_t        num_uuids128;
+    const uint8_t *name;
+    uint8_t        name_len;
+    int8_t         tx_pwr_lvl;
+    const uint8_t *svc_data;
+    uint8_t        svc_data_len;
+    const uint8_t *mfg_data;
+    uint8_t        mfg_data_len;
+    uint8_t        reserved[160];   // 其余字段 (uuid32、URI、间隔等)，与 NimBLE 结构大小相当
+} general_fields_t;
+
+static int general_parse(general_fields_t *fields, const uint8_t *data, size_t len) {
+    memset(fields, 0, sizeof(*fields));
+    size_t pos = 0;
+    while (pos < len) {
+        const uint8_t field_len = data[pos];
+        if (field_len == 0) return 0;
+        if (field_len > len - pos - 1) return -1;
+        const uint8_t *value = &data[pos + 2];
+        const uint8_t value_len = field_len - 1;
+        switch (data[pos + 1]) {
+        case 0x01: fields->flags = value[0]; break;
+        case 0x02: case 0x03: fields->uuids16 = value; fields->num_uuids16 = value_len / 2; break;
+        case 0x06: case 0x07: fields->uuids128 = value; fields->num_uuids128 = value_len / 16; break;
+        case 0x08: case 0x09: fields->name = value; fields->name_len = value_len; break;
+        case 0x0A: fields->tx_pwr_lvl = (int8_t)value[0]; break;
+        case 0x16: fields->svc_data = value; fields->svc_data_len = value_len; break;
+        case 0xFF: fields->mfg_data = value; fields->mfg_data_len = value_len; break;
+        default: break;
+        }
+        pos += (size_t)field_len + 1;
+    }
+    return 0;
+}
+
+// 通用解析之后再筛选本项目负载，只看最后一个厂商数据字段
+static const uint8_t *general_find(general_fields_t *fields, const uint8_t *data, size_t len) {
+    if (general_parse(fields, data, len) != 0 || fields->mfg_data == NULL) return NULL;
+    if (fields->mfg_data_len < PAYLOAD_MIN || fields->mfg_data_len > PAYLOAD_MAX) return NULL;
+    if (fields->mfg_data[0] != (MANU_ID & 0xFF) || fields->mfg_data[1] != (MANU_ID >> 8)) return NULL;
+    return fields->mfg_data;
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(void) {
+    uint8_t mfg_len;
+
+    build_v3(ad_v3_extended, sizeof(ad_v3_extended));
+    build_v3(ad_v3_too_long, sizeof(ad_v3_too_long));
+
+    // 语料: 只接受本公司 ID 且长度在范围内的厂商数据
+    for (size_t i = 0; i < CORPUS_COUNT; i++) {
+        const corpus_entry_t *e = &corpus[i];
+        mfg_len = 0;
+        const uint8_t *mfg = adv_find_mfg_data(e->data, e->len, MANU_ID, PAYLOAD_MIN, PAYLOAD_MAX, &mfg_len);
+        const int offset = mfg ? (int)(mfg - e->data) : -1;
+        if (offset != e->offset || (mfg && mfg_len != e->mfg_len)) {
+            fprintf(stderr, "corpus %s: offset %d length %u, expected %d length %u\n",
+                    e->name, offset, mfg_len, e->offset, e->mfg_len);
+            host_test_failures++;
+        }
+        static general_fields_t fields;
+        CHECK(general_find(&fields, e->data, e->len) == mfg);
+    }
+
+    // 随机字节: 结果要么为 NULL，要么完整落在缓冲区内且满足长度与公司 ID
+    uint32_t seed = 1;
+    uint8_t buf[255];
+    int matches = 0;
+    for (int round = 0; round < 1000000; round++) {
+        seed = seed * 1103515245u + 12345u;
+        const size_t len = (seed >> 16) % sizeof(buf);
+        for (size_t k = 0; k < len; k++) {
+            seed = seed * 1103515245u + 12345u;
+            buf[k] = (uint8_t)(seed >> 16);
+            // 提高命中本公司 ID 与厂商数据类型的概率
+            if ((seed >> 8 & 0x0F) == 0) buf[k] = k & 1 ? ADV_TYPE_MFG_DATA : MANU_ID & 0xFF;
+        }
+        // 半数缓冲区以本公司的厂商数据字段头开始，长度字节随机，可能越界
+        if ((round & 1) && len >= 4) {
+            buf[1] = ADV_TYPE_MFG_DATA, buf[2] = MANU_ID & 0xFF, buf[3] = MANU_ID >> 8;
+        }
+        const uint8_t *mfg = adv_find_mfg_data(buf, len, MANU_ID, PAYLOAD_MIN, PAYLOAD_MAX, &mfg_len);
+        if (mfg == NULL) continue;
+        matches++;
+        if (mfg < buf || mfg + mfg_len > buf + len || mfg_len < PAYLOAD_MIN || mfg_len > PAYLOAD_MAX ||
+            mfg[0] != (MANU_ID & 0xFF) || mfg[1] != (MANU_ID >> 8) || mfg[-1] != ADV_TYPE_MFG_DATA) {
+            fprintf(stderr, "random round %d: bad match\n", round);
+            host_test_failures++;
+            break;
+        }
+    }
+    printf("random buffers: %d of 1000000 matched\n", matches);
+    CHECK(matches > 0);
+
+    // 耗时对比，仅输出不判定: 扫描时绝大多数广播来自其他设备，应尽快拒绝
+    static general_fields_t fields;
+    volatile uintptr_t sink = 0;
+    double t0 = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        const corpus_entry_t *e = &corpus[r % CORPUS_THIRD_PARTY];
+        sink += (uintptr_t)adv_find_mfg_data(e->data, e->len, MANU_ID, PAYLOAD_MIN, PAYLOAD_MAX, &mfg_len);
+    }
+    double t1 = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        const corpus_entry_t *e = &corpus[r % CORPUS_THIRD_PARTY];
+        sink += (uintptr_t)general_find(&fields, e->data, e->len);
+    }
+    double t2 = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        sink += (uintptr_t)adv_find_mfg_data(ad_v2_after_name, sizeof(ad_v2_after_name), MANU_ID, PAYLOAD_MIN, PAYLOAD_MAX, &mfg_len);
+    }
+    double t3 = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        sink += (uintptr_t)general_find(&fields, ad_v2_after_name, sizeof(ad_v2_after_name));
+    }
+    double t4 = now_ns();
+    (void)sink;
+    printf("third-party adverts: walker %.1f ns, general parser %.1f ns\n", (t1 - t0) / BENCH_ROUNDS, (t2 - t1) / BENCH_ROUNDS);
+    printf("sensor advert:       walker %.1f ns, general parser %.1f ns\n", (t3 - t2) / BENCH_ROUNDS, (t4 - t3) / BENCH_ROUNDS);
+
+    return HOST_TEST_RESULT("adv_parse");
+}
@@ -0,0 +1,85 @@
+/**
+ * @file test_fixed_fmt.c
+ * @brief fixed_fmt renders exactly what newlib's printf would for every sensor reading, truncates safely,
+ * and is benchmarked against snprintf on the display and CSV lines it replaces.
+ */
+#include <string.h>
+#include <time.h>
+#include "fixed_fmt.h"
+#include "host_test.h"
+
+#define BENCH_LINES 2000000
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(void) {
+    char line[32], expect[32];
+    fixed_fmt_t fmt;
+    long mismatches = 0;
+
+    // 全部 int16/uint16 读数范围与 "%8.2f" 逐字节一致
+    for (int32_t v = INT16_MIN; v <= UINT16_MAX; v++) {
+        fixed_fmt_begin(&fmt, line, sizeof(line));
+        fixed_fmt_str(&fmt, "T: ");
+        fixed_fmt_centi(&fmt, v, 8);
+        fixed_fmt_str(&fmt, " C");
+        snprintf(expect, sizeof(expect), "T: %8.2f C", v / 100.0);
+        if (strcmp(line, expect) != 0) {
+            if (mismatches++ < 5) fprintf(stderr, "centi %ld: [%s] != [%s]\n", (long)v, line, expect);
+        }
+
+        fixed_fmt_begin(&fmt, line, sizeof(line));
+        fixed_fmt_int(&fmt, v, 7);
+        fixed_fmt_uint_zero(&fmt, (uint32_t)(v & 0xFFFF), 5);
+        snprintf(expect, sizeof(expect), "%7ld%05lu", (long)v, (unsigned long)(v & 0xFFFF));
+        if (strcmp(line, expect) != 0) {
+            if (mismatches++ < 5) fprintf(stderr, "int %ld: [%s] != [%s]\n", (long)v, line, expect);
+        }
+    }
+    CHECK(mismatches == 0);
+
+    // 32 位极值
+    fixed_fmt_begin(&fmt, line, sizeof(line));
+    fixed_fmt_int(&fmt, INT32_MIN, 0);
+    fixed_fmt_uint(&fmt, UINT32_MAX, 12);
+    CHECK(strcmp(line, "-2147483648  4294967295") == 0);
+    fixed_fmt_begin(&fmt, line, sizeof(line));
+    fixed_fmt_centi(&fmt, INT32_MIN, 0);
+    CHECK(strcmp(line, "-21474836.48") == 0);
+
+    // 放不下的输出被截断，缓冲区始终以 '\0' 结尾
+    memset(line, 'x', sizeof(line));
+    fixed_fmt_begin(&fmt, line, 6);
+    fixed_fmt_str(&fmt, "Temp: ");
+    fixed_fmt_centi(&fmt, 2345, 0);
+    fixed_fmt_fill(&fmt, ' ', 10);
+    CHECK(strcmp(line, "Temp:") == 0 && fmt.len == 5 && line[6] == 'x');
+    fixed_fmt_begin(&fmt, line, 1);
+    fixed_fmt_uint(&fmt, 12345, 8);
+    CHECK(line[0] == '\0');
+
+    // 显示行的耗时对比，仅输出不判定 (主机与 ESP32-S3 的 newlib 差异很大)
+    volatile char sink = 0;
+    double t0 = now_ns();
+    for (int i = 0; i < BENCH_LINES; i++) {
+        fixed_fmt_begin(&fmt, line, sizeof(line));
+        fixed_fmt_str(&fmt, "Temp: ");
+        fixed_fmt_centi(&fmt, (i % 9000) - 2000, 0);
+        fixed_fmt_str(&fmt, " C");
+        sink += line[7];
+    }
+    double t1 = now_ns();
+    for (int i = 0; i < BENCH_LINES; i++) {
+        snprintf(line, sizeof(line), "Temp: %.2f C", ((i % 9000) - 2000) / 100.0f);
+        sink += line[7];
+    }
+    double t2 = now_ns();
+    printf("display line: fixed_fmt %.1f ns, snprintf %%.2f %.1f ns\n", (t1 - t0) / BENCH_LINES, (t2 - t1) / BENCH_LINES);
+    (void)sink;
+
+    return HOST_TEST_RESULT("fixed_fmt");
+}
@@ -0,0 +1,201 @@
+/**
+ * @file test_node_mailbox.c
+ * @brief Node mailbox admission: token bucket, duplicates, node table limits, and a 10x flood where
+ * two chatty nodes must not crowd the quiet ones out of a consumer that keeps up with only a tenth of the offer.
+ */
+#include <string.h>
+#include "node_mailbox.h"
+#include "host_test.h"
+
+#define RATE_PER_MIN    120
+#define BURST           8
+
+// --- Flood simulation ---
+// 8 个节点: 节点 1、2 每 10 ms 一个新读数，其余每秒一个; 每个读数再重复广播一次。
+// 消费者每 50 ms 处理一条，只有总提供量的约十分之一
+#define SIM_NODES       8
+#define SIM_S           600
+#define SIM_CONSUMER_MS 50
+#define SIM_QUEUE_LEN   NODE_MAILBOX_MAX_NODES
+
+static const char *const sim_policy_name[] = { "coalesce", "drop newest", "drop oldest" };
+
+static uint16_t payload_seq(const uint8_t *payload) {
+    return (uint16_t)(payload[4] | payload[5] << 8);
+}
+
+// 主机上的环形队列，代替 main.c 中的 FreeRTOS 队列; 投递与消费用 main.c 同样的 node_mailbox_deliver/receive
+typedef struct {
+    uint8_t items[SIM_QUEUE_LEN][sizeof(node_mailbox_msg_t)];
+    size_t  item_size;
+    uint16_t head, count;
+} sim_queue_t;
+
+static bool sim_queue_send(void *queue, const void *item) {
+    sim_queue_t *q = queue;
+    if (q->count == SIM_QUEUE_LEN) return false;
+    memcpy(q->items[(q->head + q->count) % SIM_QUEUE_LEN], item, q->item_size);
+    q->count++;
+    return true;
+}
+
+static bool sim_queue_receive(void *queue, void *item, uint32_t timeout_ms) {
+    sim_queue_t *q = queue;
+    (void)timeout_ms;   // 虚拟时钟下不等待
+    if (q->count == 0) return false;
+    memcpy(item, q->items[q->head], q->item_size);
+    q->head = (q->head + 1) % SIM_QUEUE_LEN;
+    q->count--;
+    return true;
+}
+
+/**
+ * Runs the flood and returns the lowest ratio of recorded readings to the
+ * guaranteed share, min(offered, admission rate), over all nodes.
+ */
+static double sim_run(node_mailbox_policy_t policy, uint32_t rate_per_min) {
+    static node_mailbox_table_t table;
+    static node_mailbox_channel_t channel;
+    static sim_queue_t queue;
+    static node_mailbox_msg_t msg;
+    const uint8_t addr[6] = { 0 };
+    uint32_t offered[SIM_NODES] = { 0 };
+    uint32_t recorded[SIM_NODES] = { 0 };
+    int last_seq[SIM_NODES];
+    uint16_t seq[SIM_NODES] = { 0 };
+    double worst = 1e9;
+
+    memset(&queue, 0, sizeof(queue));
+    queue.item_size = node_mailbox_item_size(policy);
+    const node_mailbox_queue_t ops = { &queue, sim_queue_send, sim_queue_receive };
+    node_mailbox_init(&table, rate_per_min, BURST, NULL);
+    node_mailbox_channel_init(&channel, &table, policy, &ops);
+    for (int i = 0; i < SIM_NODES; i++) last_seq[i] = -1;
+
+    for (int64_t ms = 0; ms < SIM_S * 1000; ms++) {
+        const int64_t now_us = ms * 1000;
+        for (int i = 0; i < SIM_NODES; i++) {
+            const int period_ms = i < 2 ? 10 : 1000;
+            if ((ms + i * 37) % period_ms) continue;
+            seq[i]++;
+            offered[i]++;
+            uint8_t payload[12] = { 0xE5, 0x02, 2, (uint8_t)(i + 1), (uint8_t)seq[i], (uint8_t)(seq[i] >> 8) };
+            for (int repeat = 0; repeat < 2; repeat++) {
+                uint8_t slot;
+                if (node_mailbox_post(&table, (uint8_t)(i + 1), payload, sizeof(payload), now_us + repeat * 300,
+                                      addr, -50, &slot) == NODE_MAILBOX_NEW) {
+                    node_mailbox_deliver(&channel, slot);
+                }
+            }
+        }
+        if (ms % SIM_CONSUMER_MS == 0) {
+            if (node_mailbox_receive(&channel, &msg, 0)) {
+                const int node = table.box[msg.slot].node_id - 1;
+                const uint16_t msg_seq = payload_seq(msg.payload);
+                if (msg_seq != last_seq[node]) {
+                    recorded[node]++;
+                    last_seq[node] = msg_seq;
+                }
+            }
+        }
+    }
+
+    printf("%s, %s:\n", sim_policy_name[policy], rate_per_min ? "admission 2/s per node" : "no admission limit");
+    for (int i = 0; i < SIM_NODES; i++) {
+        const double off = offered[i] / (double)SIM_S;
+        const double rec = recorded[i] / (double)SIM_S;
+        double share = off;
+        if (rate_per_min && rate_per_min / 60.0 < share) share = rate_per_min / 60.0;
+        if (rec / share < worst) worst = rec / share;
+        const node_mailbox_t *box = &table.box[node_mailbox_find(&table, (uint8_t)(i + 1))];
+        printf("  node %d offered %6.2f/s recorded %5.2f/s  rate-limited %6u coalesced %6u queue full %6u evicted %6u\n",
+               i + 1, off, rec, (unsigned)box->drops[ADMIT_DROP_RATE], (unsigned)box->drops[ADMIT_DROP_COALESCED],
+               (unsigned)box->drops[ADMIT_DROP_QUEUE_FULL], (unsigned)box->drops[ADMIT_DROP_EVICTED]);
+    }
+
+    return worst;
+}
+
+static bool ignore_last_byte(const uint8_t *stored, const uint8_t *payload, uint8_t len) {
+    return memcmp(stored, payload, len - 1) == 0;
+}
+
+int main(void) {
+    static node_mailbox_table_t table;
+    static node_mailbox_t box;
+    const uint8_t addr[6] = { 1, 2, 3, 4, 5, 6 };
+    uint8_t payload[4] = { 0xE5, 0x02, 1, 0 };
+    uint8_t slot = 0xFF;
+
+    // 新节点以满桶开始: BURST 个变化立即准入，之后按速率补充
+    node_mailbox_init(&table, RATE_PER_MIN, BURST, NULL);
+    for (int i = 0; i < BURST; i++) {
+        payload[3] = (uint8_t)i;
+        CHECK(node_mailbox_post(&table, 7, payload, sizeof(payload), 0, addr, -60, &slot) == NODE_MAILBOX_NEW);
+    }
+    CHECK(slot == 0 && node_mailbox_count(&table) == 1);
+    payload[3] = BURST;
+    CHECK(node_mailbox_post(&table, 7, payload, sizeof(payload), 0, addr, -60, &slot) == NODE_MAILBOX_RATE_LIMITED);
+    CHECK(table.box[0].drops[ADMIT_DROP_RATE] == 1);
+    CHECK(table.box[0].payload[3] == BURST - 1);    // 被拒的数值不写入邮箱
+
+    // 重复广播不消耗令牌，只刷新接收时间和链路统计
+    payload[3] = BURST - 1;
+    CHECK(node_mailbox_post(&table, 7, payload, sizeof(payload), 100000, addr, -40, &slot) == NODE_MAILBOX_DUPLICATE);
+    CHECK(table.duplicates == 1);
+    CHECK(node_mailbox_rx_us(&table, 0) == 100000);
+    CHECK(table.box[0].data_rx_us == 0);
+
+    // 120/分钟 即每 500 ms 一个令牌; 节点重发被拒的数值时再次尝试准入
+    payload[3] = BURST;
+    CHECK(node_mailbox_post(&table, 7, payload, sizeof(payload), 499000, addr, -60, &slot) == NODE_MAILBOX_RATE_LIMITED);
+    CHECK(node_mailbox_post(&table, 7, payload, sizeof(payload), 500000, addr, -60, &slot) == NODE_MAILBOX_NEW);
+    CHECK(table.box[0].changes == BURST + 1);
+
+    // 桶容量封顶: 长时间空闲后仍只有 BURST 个令牌
+    int admitted = 0;
+    for (int i = 0; i < 2 * BURST; i++) {
+        payload[3] = (uint8_t)(100 + i);
+        admitted += node_mailbox_post(&table, 7, payload, sizeof(payload), 3600000000LL, addr, -60, &slot) == NODE_MAILBOX_NEW;
+    }
+    CHECK(admitted == BURST);
+
+    // RSSI 统计与快照
+    uint8_t quiet_slot;
+    CHECK(node_mailbox_post(&table, 9, payload, sizeof(payload), 0, addr, NODE_MAILBOX_RSSI_UNAVAIL, &quiet_slot) == NODE_MAILBOX_NEW);
+    CHECK(quiet_slot == 1 && node_mailbox_find(&table, 9) == 1 && node_mailbox_find(&table, 10) == -1);
+    node_mailbox_read(&table, 0, &box);
+    CHECK(box.node_id == 7 && box.rssi_min == -60 && box.rssi_max == -40 && box.rssi_count == table.box[0].rssi_count);
+    CHECK(memcmp(box.addr, addr, sizeof(addr)) == 0);
+    CHECK(table.box[1].rssi_count == 0);
+
+    // 节点表满后新节点的广播被丢弃
+    for (int id = 100; node_mailbox_count(&table) < NODE_MAILBOX_MAX_NODES; id++) {
+        node_mailbox_post(&table, (uint8_t)id, payload, sizeof(payload), 0, addr, -60, &slot);
+    }
+    CHECK(node_mailbox_post(&table, 250, payload, sizeof(payload), 0, addr, -60, &slot) == NODE_MAILBOX_OVERFLOW);
+    CHECK(table.overflow == 1);
+
+    // 速率为 0 不限速; 调用方的比较函数可忽略每次发送都变化的字段
+    node_mailbox_init(&table, 0, BURST, ignore_last_byte);
+    for (int i = 0; i < 4 * BURST; i++) {
+        payload[2] = (uint8_t)i;
+        CHECK(node_mailbox_post(&table, 7, payload, sizeof(payload), 0, addr, -60, &slot) == NODE_MAILBOX_NEW);
+    }
+    payload[3] = 0x55;
+    CHECK(node_mailbox_post(&table, 7, payload, sizeof(payload), 0, addr, -60, &slot) == NODE_MAILBOX_DUPLICATE);
+
+    // 10 倍过载: 每个节点都至少得到 min(提供量, 准入速率) 的 99%
+    for (node_mailbox_policy_t policy = NODE_MAILBOX_COALESCE; policy <= NODE_MAILBOX_DROP_OLDEST; policy++) {
+        double worst = sim_run(policy, RATE_PER_MIN);
+        printf("  worst node %.1f%% of min(offered, admission rate)\n", worst * 100.0);
+        CHECK(worst >= 0.99);
+    }
+
+    // 对照: 不限速时 FIFO 队列被两个高频节点占满，低频节点读数丢失
+    double starved = sim_run(NODE_MAILBOX_DROP_NEWEST, 0);
+    printf("  worst node %.1f%% of offered\n", starved * 100.0);
+    CHECK(starved < 0.5);
+
+    return HOST_TEST_RESULT("node_mailbox");
+}
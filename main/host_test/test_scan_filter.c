@@ -0,0 +1,264 @@
+/**
+ * @file test_scan_filter.c
+ * @brief Per-scan accept lists for a fleet larger than the controller's list, and a replay of the scan
+ * callback's fast path over the advert corpus with and without a modelled controller filter.
+ */
+#include <string.h>
+#include <time.h>
+#include "adv_corpus.h"
+#include "sensor_payload.h"
+#include "scan_sched.h"
+#include "scan_filter.h"
+#include "node_mailbox.h"
+#include "host_test.h"
+
+#define S_US            1000000LL
+#define LIST_MAX        15          // CONFIG_BT_NIMBLE_WHITELIST_SIZE
+
+// 固定的线性同余发生器，模拟结果与 libc 的 rand() 无关
+static uint32_t g_seed;
+
+static uint32_t sim_rand(void) {
+    g_seed = g_seed * 1103515245u + 12345u;
+    return g_seed >> 16;
+}
+
+static void node_addr(uint8_t node_id, uint8_t addr[6]) {
+    const uint8_t a[6] = { node_id, 0x5E, 0x45, 0x4E, 0x53, 0xC0 };   // 随机静态地址
+    memcpy(addr, a, 6);
+}
+
+// --- Replay ---
+// 36 个节点 (周期 1~4 s，v2 负载，每第三个节点发送 v3) 与 60 个第三方设备 (100~1000 ms 发送语料中的第三方广播)，
+// 扫描器与 test_scan_sched 的机队模拟相同。控制器过滤模型: 调度阶段的扫描只上报 scan_filter_build 列表中的地址。
+// 每次回调按 ble_central_on_advert 的顺序执行快速路径，并记录下来在模拟结束后重放计时
+#define SIM_NODES       36
+#define SIM_FOREIGN     60
+#define SIM_DEVICES     (SIM_NODES + SIM_FOREIGN)
+#define SIM_TOTAL_US    (300 * S_US)
+#define SIM_WARMUP_US   (60 * S_US)
+#define SIM_TICK_US     500
+#define SIM_SCAN_ITVL_US        60000       // SCAN_ITVL
+#define SIM_SCAN_WINDOW_US      30000       // SCAN_WINDOW
+#define SIM_CALLBACKS_MAX       200000
+#define REPLAY_ROUNDS           20
+
+typedef struct {
+    const uint8_t *data;
+    uint8_t        len;
+    uint8_t        addr[6];
+    int64_t        rx_us;
+} sim_callback_t;
+
+typedef struct {
+    scan_sched_t         sched;
+    scan_filter_t        filter;
+    node_mailbox_table_t mailbox;
+} fast_path_t;
+
+typedef struct {
+    double   callbacks_per_s;
+    double   own_per_s;         // 其中本项目节点的广播
+    double   foreign_scheduled_per_s;   // 调度阶段内的第三方广播
+    double   capture;           // 本项目节点广播的接收比例
+    double   ns_per_callback;
+    double   cpu_ppm;           // 快速路径占用的 CPU 时间 (每秒 µs)
+    uint32_t filtered_scans;
+    uint32_t unfiltered_scans;
+} replay_result_t;
+
+static uint8_t g_node_advert[SIM_NODES][sizeof(ad_v3_extended)];
+static sim_callback_t g_callbacks[SIM_CALLBACKS_MAX];
+
+static void fast_path_init(fast_path_t *fp) {
+    scan_sched_init(&fp->sched, 30 * S_US, 5 * S_US, LIST_MAX);
+    scan_filter_init(&fp->filter, LIST_MAX);
+    node_mailbox_init(&fp->mailbox, 120, 8, NULL);
+}
+
+// 与 ble_central_on_advert 相同: 查找负载，记录地址，更新调度，投递邮箱
+static bool fast_path(fast_path_t *fp, const uint8_t *data, uint8_t len, const uint8_t addr[6], int64_t rx_us) {
+    uint8_t mfg_len, node_id, slot;
+    const uint8_t *mfg = sensor_payload_find(data, len, &mfg_len, &node_id);
+    if (mfg == NULL) return false;
+    scan_filter_learn(&fp->filter, node_id, 1, addr);
+    scan_sched_observe(&fp->sched, node_id, rx_us);
+    node_mailbox_post(&fp->mailbox, node_id, mfg, mfg_len, rx_us, addr, -60, &slot);
+    return true;
+}
+
+static bool filter_accepts(const scan_filter_t *filter, const uint8_t addr[6]) {
+    for (int i = 0; i < filter->list_count; i++) {
+        if (memcmp(filter->list[i].val, addr, 6) == 0) return true;
+    }
+    return false;
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static replay_result_t replay_run(bool use_filter) {
+    static fast_path_t fp;
+    int64_t next_us[SIM_DEVICES], itvl_us[SIM_DEVICES];
+    uint8_t addr[SIM_DEVICES][6];
+    const corpus_entry_t *foreign[SIM_DEVICES];
+    int64_t scan_start_us = 0, own_sent = 0, own_got = 0, callbacks = 0, own_callbacks = 0, foreign_scheduled = 0;
+    scan_sched_step_t step = { 0 };
+    bool filtered = false;
+    replay_result_t result = { 0 };
+
+    g_seed = 11;
+    fast_path_init(&fp);
+    for (int i = 0; i < SIM_DEVICES; i++) {
+        if (i < SIM_NODES) {
+            itvl_us[i] = S_US + (sim_rand() % 4) * S_US;
+            node_addr((uint8_t)i, addr[i]);
+        } else {
+            itvl_us[i] = 100000 + (sim_rand() % 901) * 1000;
+            for (int k = 0; k < 6; k++) addr[i][k] = (uint8_t)sim_rand();
+            foreign[i] = &corpus[sim_rand() % CORPUS_THIRD_PARTY];
+        }
+        next_us[i] = sim_rand() % itvl_us[i];
+    }
+
+    for (int64_t t = 0; t < SIM_TOTAL_US; t += SIM_TICK_US) {
+        if (t >= step.end_us) {
+            scan_sched_step(&fp.sched, t, &step);
+            scan_start_us = t;
+            bool changed;
+            filtered = use_filter && step.scan && fp.sched.phase == SCAN_SCHED_PHASE_SCHEDULED &&
+                       scan_filter_build(&fp.filter, step.node_ids, step.node_count, &changed);
+            if (step.scan && t >= SIM_WARMUP_US) {
+                if (filtered) result.filtered_scans++;
+                else result.unfiltered_scans++;
+            }
+        }
+        bool on = step.scan && (step.full_duty || (t - scan_start_us) % SIM_SCAN_ITVL_US < SIM_SCAN_WINDOW_US);
+        for (int i = 0; i < SIM_DEVICES; i++) {
+            if (next_us[i] > t) continue;
+            next_us[i] += itvl_us[i] + sim_rand() % 10000;
+            const bool own = i < SIM_NODES;
+            const uint8_t *data = own ? g_node_advert[i] : foreign[i]->data;
+            const uint8_t len = own ? (i % 3 == 2 ? sizeof(ad_v3_extended) : sizeof(ad_v2_after_name)) : (uint8_t)foreign[i]->len;
+            if (own && t >= SIM_WARMUP_US) own_sent++;
+            if (!on || sim_rand() % 100 >= 95) continue;
+            if (filtered && !filter_accepts(&fp.filter, addr[i])) continue;    // 控制器丢弃，不产生回调
+
+            fast_path(&fp, data, len, addr[i], t);
+            if (t < SIM_WARMUP_US) continue;
+            callbacks++;
+            own_callbacks += own;
+            own_got += own;
+            foreign_scheduled += !own && fp.sched.phase == SCAN_SCHED_PHASE_SCHEDULED;
+            if (callbacks <= SIM_CALLBACKS_MAX) {
+                sim_callback_t *cb = &g_callbacks[callbacks - 1];
+                cb->data = data;
+                cb->len = len;
+                memcpy(cb->addr, addr[i], 6);
+                cb->rx_us = t;
+            }
+        }
+    }
+
+    // 重放计时: 只计回调内的快速路径，不含模拟本身
+    int64_t recorded = callbacks < SIM_CALLBACKS_MAX ? callbacks : SIM_CALLBACKS_MAX;
+    volatile int sink = 0;
+    double t0 = now_ns();
+    for (int r = 0; r < REPLAY_ROUNDS; r++) {
+        fast_path_init(&fp);
+        for (int64_t k = 0; k < recorded; k++) {
+            const sim_callback_t *cb = &g_callbacks[k];
+            sink += fast_path(&fp, cb->data, cb->len, cb->addr, cb->rx_us + r * SIM_TOTAL_US);
+        }
+    }
+    double t1 = now_ns();
+    (void)sink;
+
+    const double seconds = (double)(SIM_TOTAL_US - SIM_WARMUP_US) / S_US;
+    result.callbacks_per_s = callbacks / seconds;
+    result.own_per_s = own_callbacks / seconds;
+    result.foreign_scheduled_per_s = foreign_scheduled / seconds;
+    result.capture = (double)own_got / (double)own_sent;
+    result.ns_per_callback = recorded ? (t1 - t0) / REPLAY_ROUNDS / recorded : 0;
+    result.cpu_ppm = result.callbacks_per_s * result.ns_per_callback / 1000.0;
+    return result;
+}
+
+int main(void) {
+    static scan_filter_t filter;
+    uint8_t addr[6];
+    bool changed;
+
+    // 地址按节点记录，地址变化时更新
+    scan_filter_init(&filter, LIST_MAX);
+    node_addr(1, addr);
+    CHECK(scan_filter_learn(&filter, 1, 1, addr));
+    CHECK(!scan_filter_learn(&filter, 1, 1, addr));
+    addr[0] = 0x81;
+    CHECK(scan_filter_learn(&filter, 1, 1, addr));
+    CHECK(filter.count == 1 && filter.addrs[0].val[0] == 0x81);
+
+    // 整个机队 (36 个节点) 都能记录地址，控制器列表只有 15 项
+    for (uint8_t id = 0; id < SIM_NODES; id++) {
+        node_addr(id, addr);
+        scan_filter_learn(&filter, id, 1, addr);
+    }
+    CHECK(filter.count == SIM_NODES);
+    uint8_t ids[SIM_NODES];
+    for (uint8_t id = 0; id < SIM_NODES; id++) ids[id] = id;
+
+    // 放得下的节点集合生成列表，只有列表变化时才需要写入控制器
+    CHECK(scan_filter_build(&filter, ids, 3, &changed) && changed);
+    CHECK(filter.list_count == 3 && filter.list[2].val[0] == 2);
+    CHECK(scan_filter_build(&filter, ids, 3, &changed) && !changed);
+    CHECK(scan_filter_build(&filter, &ids[20], LIST_MAX, &changed) && changed);
+    CHECK(filter.list_count == LIST_MAX && filter.list[0].val[0] == 20);
+
+    // 放不下或地址未知: 不过滤并计数
+    CHECK(!scan_filter_build(&filter, ids, LIST_MAX + 1, &changed) && !changed);
+    const uint8_t unknown = 200;
+    CHECK(!scan_filter_build(&filter, &unknown, 1, &changed));
+    CHECK(filter.unfiltered == 2);
+    CHECK(filter.list_count == LIST_MAX);
+
+    // 快速路径重放
+    for (int i = 0; i < SIM_NODES; i++) {
+        build_v3(ad_v3_extended, sizeof(ad_v3_extended));
+        if (i % 3 == 2) {
+            memcpy(g_node_advert[i], ad_v3_extended, sizeof(ad_v3_extended));
+            g_node_advert[i][8] = (uint8_t)i;
+        } else {
+            memcpy(g_node_advert[i], ad_v2_after_name, sizeof(ad_v2_after_name));
+            g_node_advert[i][15] = (uint8_t)i;
+        }
+        uint8_t mfg_len, node_id;
+        CHECK(sensor_payload_find(g_node_advert[i], i % 3 == 2 ? sizeof(ad_v3_extended) : sizeof(ad_v2_after_name),
+                                  &mfg_len, &node_id) != NULL && node_id == i);
+    }
+    for (size_t i = 0; i < CORPUS_THIRD_PARTY; i++) {
+        uint8_t mfg_len, node_id;
+        CHECK(sensor_payload_find(corpus[i].data, corpus[i].len, &mfg_len, &node_id) == NULL);
+    }
+
+    replay_result_t open = replay_run(false);
+    replay_result_t listed = replay_run(true);
+    printf("unfiltered: %.1f callbacks/s (%.1f/s own, %.1f/s third-party in scheduled phases, capture %.1f%%), "
+           "%.1f ns each, CPU %.1f us/s, %u scans\n",
+           open.callbacks_per_s, open.own_per_s, open.foreign_scheduled_per_s, open.capture * 100.0,
+           open.ns_per_callback, open.cpu_ppm, open.unfiltered_scans);
+    printf("filtered:   %.1f callbacks/s (%.1f/s own, %.1f/s third-party in scheduled phases, capture %.1f%%), "
+           "%.1f ns each, CPU %.1f us/s, %u of %u scans filtered\n",
+           listed.callbacks_per_s, listed.own_per_s, listed.foreign_scheduled_per_s, listed.capture * 100.0,
+           listed.ns_per_callback, listed.cpu_ppm, listed.filtered_scans, listed.filtered_scans + listed.unfiltered_scans);
+
+    // 过滤只去掉第三方广播: 本项目节点的接收不变，调度阶段不再有第三方回调，只剩发现阶段的
+    CHECK(listed.capture >= open.capture - 0.01);
+    CHECK(listed.foreign_scheduled_per_s == 0.0);
+    CHECK(listed.callbacks_per_s < open.callbacks_per_s * 0.75);
+    CHECK(listed.filtered_scans > listed.unfiltered_scans);
+
+    return HOST_TEST_RESULT("scan_filter");
+}
@@ -0,0 +1,203 @@
+/**
+ * @file test_scan_sched.c
+ * @brief Scan window scheduler on a virtual clock: period learning, lock, missed adverts, window merging,
+ * and a simulated fleet where predicted windows must capture nearly every advert at a fraction of the radio time.
+ */
+#include <stdlib.h>
+#include "scan_sched.h"
+#include "host_test.h"
+
+#define S_US    1000000LL
+
+// 固定的线性同余发生器，模拟结果与 libc 的 rand() 无关
+static uint32_t g_seed;
+
+static uint32_t sim_rand(void) {
+    g_seed = g_seed * 1103515245u + 12345u;
+    return g_seed >> 16;
+}
+
+static void observe_periodic(scan_sched_t *sched, uint8_t node_id, int64_t first_us, int64_t period_us, int count) {
+    for (int i = 0; i < count; i++) scan_sched_observe(sched, node_id, first_us + i * period_us);
+}
+
+static const scan_sched_node_t *find_node(const scan_sched_t *sched, uint8_t node_id) {
+    for (int i = 0; i < sched->count; i++) {
+        if (sched->nodes[i].node_id == node_id) return &sched->nodes[i];
+    }
+    return NULL;
+}
+
+// --- Fleet simulation ---
+// 节点周期 1~4 s (±50 ppm 时钟误差) 加 0~10 ms advDelay，5% 射频丢包。
+// 扫描器按 scan_sched_step 运行: 30 s 调度阶段与 5 s 发现阶段交替; 连续扫描按 main.c 的
+// SCAN_WINDOW/SCAN_ITVL 只在每个扫描间隔的前 30 ms 接收，预测窗口为 100% 占空比。前 60 s 为学习期，不计入结果
+#define SIM_SCAN_ITVL_US        60000       // SCAN_ITVL
+#define SIM_SCAN_WINDOW_US      30000       // SCAN_WINDOW
+#define SIM_SCHEDULED_US        (30 * S_US) // SCAN_SCHEDULED_MS
+#define SIM_DISCOVERY_US        (5 * S_US)  // SCAN_DISCOVERY_MS
+
+typedef struct {
+    double capture;     // 收到的广播占比
+    double duty;        // 射频开启时间占比
+    int    locked;
+} fleet_result_t;
+
+static fleet_result_t fleet_run(int nodes) {
+    static scan_sched_t sched;
+    int64_t next_us[SCAN_SCHED_MAX_NODES];
+    int64_t itvl_us[SCAN_SCHED_MAX_NODES];
+    const int64_t total_us = 600 * S_US, warmup_us = 60 * S_US, tick_us = 500;
+    int64_t scan_start_us = 0, on_us = 0, sent = 0, got = 0;
+    scan_sched_step_t step = { 0 };
+    fleet_result_t result = { 0 };
+
+    g_seed = 7;
+    scan_sched_init(&sched, SIM_SCHEDULED_US, SIM_DISCOVERY_US, 0);
+    for (int i = 0; i < nodes; i++) {
+        itvl_us[i] = (S_US + (sim_rand() % 4) * S_US) * (1000000 + (int64_t)(sim_rand() % 101) - 50) / 1000000;
+        next_us[i] = sim_rand() % itvl_us[i];
+    }
+
+    for (int64_t t = 0; t < total_us; t += tick_us) {
+        if (t >= step.end_us) {
+            scan_sched_step(&sched, t, &step);
+            scan_start_us = t;
+        }
+        bool on = step.scan && (step.full_duty || (t - scan_start_us) % SIM_SCAN_ITVL_US < SIM_SCAN_WINDOW_US);
+        if (on && t >= warmup_us) on_us += tick_us;
+        for (int i = 0; i < nodes; i++) {
+            if (next_us[i] > t) continue;
+            bool rx = on && sim_rand() % 100 < 95;
+            if (t >= warmup_us) {
+                sent++;
+                got += rx;
+            }
+            if (rx) scan_sched_observe(&sched, (uint8_t)i, t);
+            next_us[i] += itvl_us[i] + sim_rand() % 10000;
+        }
+    }
+
+    result.capture = (double)got / (double)sent;
+    result.duty = (double)on_us / (double)(total_us - warmup_us);
+    for (int i = 0; i < sched.count; i++) result.locked += sched.nodes[i].confidence >= SCAN_SCHED_LOCK_COUNT;
+    return result;
+}
+
+int main(void) {
+    static scan_sched_t sched;
+    int64_t start_us;
+    uint32_t duration_us;
+
+    // 学习: 第一次到达只记录时间，第一个间隔作为周期估计，锁定前要求连续扫描
+    scan_sched_init(&sched, SIM_SCHEDULED_US, SIM_DISCOVERY_US, 0);
+    CHECK(!scan_sched_next(&sched, 0, &start_us, &duration_us));
+    observe_periodic(&sched, 1, 0, 2 * S_US, SCAN_SCHED_LOCK_COUNT + 1);
+    CHECK(find_node(&sched, 1)->period_us == 2 * S_US);
+    CHECK(find_node(&sched, 1)->confidence == SCAN_SCHED_LOCK_COUNT - 1);
+    CHECK(!scan_sched_next(&sched, SCAN_SCHED_LOCK_COUNT * 2 * S_US, &start_us, &duration_us));
+
+    // 锁定: 第 LOCK_COUNT 个符合估计的间隔之后按预测开窗，窗口以预测时刻为中心
+    int64_t last_us = (SCAN_SCHED_LOCK_COUNT + 1) * 2 * S_US;
+    scan_sched_observe(&sched, 1, last_us);
+    CHECK(find_node(&sched, 1)->confidence == SCAN_SCHED_LOCK_COUNT);
+    CHECK(scan_sched_next(&sched, last_us + 1000, &start_us, &duration_us));
+    int64_t guard_us = SCAN_SCHED_GUARD_US + ((2 * S_US) >> SCAN_SCHED_DRIFT_SHIFT);
+    CHECK(start_us == last_us + 2 * S_US - guard_us);
+    CHECK(duration_us == 2 * guard_us);
+
+    // 错过一次广播: 两个周期的间隔仍符合预测，周期不变，置信度继续增加
+    last_us += 2 * 2 * S_US + 3000;
+    scan_sched_observe(&sched, 1, last_us);
+    CHECK(find_node(&sched, 1)->confidence == SCAN_SCHED_LOCK_COUNT + 1);
+    CHECK(llabs((int64_t)find_node(&sched, 1)->period_us - 2 * S_US) < 1000);
+
+    // 预测窗口已过仍未收到: 下一个窗口移到再下一个周期，保护时间随周期数增加
+    CHECK(scan_sched_next(&sched, last_us + 3 * S_US, &start_us, &duration_us));
+    CHECK(start_us > last_us + 3 * S_US && start_us < last_us + 4 * S_US);
+    CHECK(duration_us > 2 * guard_us);
+
+    // 超过 MAX_MISSES 个周期未出现的节点不再开窗，也不要求连续扫描
+    CHECK(scan_sched_next(&sched, last_us + SCAN_SCHED_MAX_MISSES * 2 * S_US, &start_us, &duration_us));
+    CHECK(!scan_sched_next(&sched, last_us + (SCAN_SCHED_MAX_MISSES + 1) * 2 * S_US + S_US, &start_us, &duration_us));
+
+    // 间隔与预测不符: 重新学习，回到连续扫描
+    last_us += 2 * S_US + 400000;
+    scan_sched_observe(&sched, 1, last_us);
+    CHECK(find_node(&sched, 1)->confidence == 0);
+    CHECK(!scan_sched_next(&sched, last_us + 1000, &start_us, &duration_us));
+
+    // 合并: 预测时刻相距小于保护时间的两个节点共用一个窗口，较远的第三个节点留到下一个窗口
+    scan_sched_init(&sched, SIM_SCHEDULED_US, SIM_DISCOVERY_US, 0);
+    observe_periodic(&sched, 1, 0, S_US, SCAN_SCHED_LOCK_COUNT + 2);
+    observe_periodic(&sched, 2, 10000, S_US, SCAN_SCHED_LOCK_COUNT + 2);
+    observe_periodic(&sched, 3, 400000, S_US, SCAN_SCHED_LOCK_COUNT + 2);
+    const int64_t now_us = (SCAN_SCHED_LOCK_COUNT + 1) * S_US + 500000;
+    guard_us = SCAN_SCHED_GUARD_US + (S_US >> SCAN_SCHED_DRIFT_SHIFT);
+    CHECK(scan_sched_next(&sched, now_us, &start_us, &duration_us));
+    CHECK(start_us == (SCAN_SCHED_LOCK_COUNT + 2) * S_US - guard_us);
+    CHECK(start_us + duration_us == (SCAN_SCHED_LOCK_COUNT + 2) * S_US + 10000 + guard_us);
+
+    // 新节点在学习期内要求连续扫描，超过 LEARN_US 未再出现后不再影响调度
+    scan_sched_observe(&sched, 4, now_us);
+    CHECK(!scan_sched_next(&sched, now_us + 1000, &start_us, &duration_us));
+    observe_periodic(&sched, 1, (SCAN_SCHED_LOCK_COUNT + 2) * S_US, S_US, (int)(SCAN_SCHED_LEARN_US / S_US));
+    CHECK(scan_sched_next(&sched, now_us + SCAN_SCHED_LEARN_US, &start_us, &duration_us));
+
+    // 阶段: 先发现阶段后调度阶段; 全部锁定时调度阶段在窗口之间关闭射频，
+    // 发现阶段连续扫描但在预测窗口处切换到 100% 占空比
+    static scan_sched_t phased;
+    scan_sched_step_t step;
+    const int64_t discovery_us = 10 * S_US + 500000;
+    scan_sched_init(&phased, SIM_SCHEDULED_US, discovery_us, 0);
+    CHECK(scan_sched_step(&phased, 0, &step));
+    CHECK(phased.phase == SCAN_SCHED_PHASE_DISCOVERY && step.scan && !step.full_duty);
+    CHECK(step.end_us == discovery_us);
+    observe_periodic(&phased, 1, 0, S_US, SCAN_SCHED_LOCK_COUNT + 2);
+    const int64_t locked_us = (SCAN_SCHED_LOCK_COUNT + 1) * S_US;
+    guard_us = SCAN_SCHED_GUARD_US + (S_US >> SCAN_SCHED_DRIFT_SHIFT);
+    CHECK(!scan_sched_step(&phased, locked_us + 500000, &step));
+    CHECK(step.scan && !step.full_duty && step.end_us == locked_us + S_US - guard_us);
+    CHECK(!scan_sched_step(&phased, step.end_us, &step));
+    CHECK(step.scan && step.full_duty && step.end_us == locked_us + S_US + guard_us);
+    CHECK(scan_sched_step(&phased, discovery_us, &step));
+    guard_us = SCAN_SCHED_GUARD_US + 7 * (S_US >> SCAN_SCHED_DRIFT_SHIFT);
+    CHECK(phased.phase == SCAN_SCHED_PHASE_SCHEDULED && !step.scan);
+    CHECK(step.end_us == locked_us + 7 * S_US - guard_us);
+    CHECK(!scan_sched_step(&phased, step.end_us, &step));
+    CHECK(step.scan && step.full_duty && step.end_us == locked_us + 7 * S_US + guard_us);
+
+    // 窗口节点数上限: 三个重叠窗口在上限为 2 时拆成多次扫描，每次列出的节点不超过上限且不漏掉窗口
+    static scan_sched_t capped;
+    scan_sched_init(&capped, SIM_SCHEDULED_US, discovery_us, 2);
+    scan_sched_step(&capped, 0, &step);
+    observe_periodic(&capped, 1, 0, S_US, SCAN_SCHED_LOCK_COUNT + 2);
+    observe_periodic(&capped, 2, 10000, S_US, SCAN_SCHED_LOCK_COUNT + 2);
+    observe_periodic(&capped, 3, 20000, S_US, SCAN_SCHED_LOCK_COUNT + 2);
+    guard_us = SCAN_SCHED_GUARD_US + (S_US >> SCAN_SCHED_DRIFT_SHIFT);
+    scan_sched_step(&capped, locked_us + 500000, &step);
+    CHECK(!step.full_duty && step.end_us == locked_us + S_US - guard_us);
+    scan_sched_step(&capped, step.end_us, &step);
+    CHECK(step.full_duty && step.node_count == 2 && step.node_ids[0] == 1 && step.node_ids[1] == 2);
+    CHECK(step.end_us == locked_us + S_US + 20000 - guard_us);
+    scan_sched_step(&capped, step.end_us, &step);
+    CHECK(step.full_duty && step.node_count == 2 && step.node_ids[0] == 1 && step.node_ids[1] == 2);
+    CHECK(step.end_us == locked_us + S_US + guard_us);
+    scan_sched_step(&capped, step.end_us, &step);
+    CHECK(step.full_duty && step.node_count == 2 && step.node_ids[0] == 2 && step.node_ids[1] == 3);
+    CHECK(step.end_us == locked_us + S_US + 20000 + guard_us);
+
+    // 机队模拟: 5% 射频丢包下理想捕获率为 95%
+    static const int fleet[] = { 1, 4, 12, 36 };
+    static const double max_duty[] = { 0.15, 0.20, 0.30, 0.45 };
+    for (size_t i = 0; i < sizeof(fleet) / sizeof(fleet[0]); i++) {
+        fleet_result_t r = fleet_run(fleet[i]);
+        printf("%2d nodes: capture %.1f%% (ideal 95%%), radio duty %.1f%%, %d locked\n",
+               fleet[i], r.capture * 100.0, r.duty * 100.0, r.locked);
+        CHECK(r.capture >= 0.93);
+        CHECK(r.duty <= max_duty[i]);
+        CHECK(r.locked == fleet[i]);
+    }
+
+    return HOST_TEST_RESULT("scan_sched");
+}
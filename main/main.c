@@ -7,11 +7,13 @@
  * to provide clear feedback on system initialization, including error codes.
  */
 #include <stdio.h>
+#include <stddef.h>
 #include <string.h>
 #include <limits.h>
-#include <math.h>
+#include <inttypes.h>
 #include <time.h>
 #include <sys/stat.h>
+#include <sys/time.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
@@ -23,20 +25,30 @@
 #include "esp_sntp.h"
 #include "esp_vfs_fat.h"
 #include "driver/sdspi_host.h"
+#include "esp_timer.h"
 #include "sdmmc_cmd.h"
 
 // NimBLE
 #include "nimble/nimble_port.h"
-#include "nimble/nimble_port_freertos.h"
 #include "host/ble_hs.h"
 #include "host/util/util.h"
 #include "services/gap/ble_svc_gap.h"
 #include "host/ble_hs_id.h"
 
+#include "nimble/nimble_npl.h"
+
 // OLED
 #include "driver/i2c_master.h"
+#include "driver/gpio.h"
 #include "ssd1306.h"
 
+// Formatting & parsing
+#include "fixed_fmt.h"
+#include "sensor_payload.h"
+#include "scan_filter.h"
+#include "scan_sched.h"
+#include "node_mailbox.h"
+
 static const char *TAG = "CENTRAL_LOGGER";
 
 // --- Wi-Fi & SNTP Configuration ---
@@ -55,42 +67,186 @@ static const char *TAG = "CENTRAL_LOGGER";
 #define I2C_SCL_PIN          GPIO_NUM_4
 #define I2C_SDA_PIN          GPIO_NUM_5
 #define DISPLAY_CYCLE_TIME_S 3
+#define DISPLAY_FRAME_LOCK_MS 100
+#define DISPLAY_STATS_DUMP_CYCLES 20   // CONFIG_SSD1306_I2C_STATS 开启时每 20 个周期输出一次总线统计
 #define NODE_TIMEOUT_S       30
 
+// --- Display Capture Configuration ---
+#define DISPLAY_CAPTURE_ENABLED   1
+#define DISPLAY_CAPTURE_STREAM    0            // 1: 每个变化的帧按差分记录
+#define DISPLAY_CAPTURE_PIN       GPIO_NUM_0   // BOOT 键按下截图
+#define DISPLAY_CAPTURE_SLOTS     2
+#define DISPLAY_FRAME_BYTES       (SSD1306_PAGE_128x64_SIZE * SSD1306_PAGE_SEGMENT_SIZE)
+#define DISPLAY_CAPTURE_STREAM_FILE SD_CARD_MOUNT_POINT "/frames.cap"
+#define DISPLAY_CAPTURE_MAGIC     "OLEDCAP1"
+#define DISPLAY_CAPTURE_REPORT_S  10           // 丢帧数变化时最多每 10 秒报告一次
+
 // --- BLE Configuration ---
-#define CUSTOM_MANU_ID       0x02E5
 #define MAX_SENSOR_NODES     36
+#define SEQ_REORDER_WINDOW   31      // 序号回退不超过此值 (接收位图宽度 - 1) 视为乱序，否则视为节点重启
+#define NODE_STATS_REPORT_S  300
+#define PENDING_LOG_MAX      256     // 时间同步或 SD 就绪前缓存的读数，满后丢弃最旧
+#define STORAGE_QUEUE_LEN    128     // ingest → storage 记录队列，满时丢弃并在 CSV 中标记缺口
+#define STAGE_STATS_REPORT_S 60
+#define SCAN_ACCEPT_LIST_MAX CONFIG_BT_NIMBLE_WHITELIST_SIZE  // 控制器过滤列表容量，每次扫描按预期节点重建
+#define SCAN_SCHEDULED_MS    30000   // 按预测开窗的调度阶段
+#define SCAN_DISCOVERY_MS    5000    // 连续扫描的发现阶段，用于发现新节点
+#define SCAN_ITVL            0x0060  // 60 ms (0.625 ms 单位)
+#define SCAN_WINDOW          0x0030  // 30 ms, 连续扫描时为 Wi-Fi 共存留出一半时间
+#define SCAN_RETRY_MS        100     // 启动扫描失败后经 callout 重试
+
+// --- Overload Policy ---
+// 扫描回调按节点令牌桶准入，超出速率的数值变化被拒绝; 准入后按策略投递给 ingest_task
+// 投递与消费在 node_mailbox.c (node_mailbox_deliver/node_mailbox_receive)，数值同 node_mailbox_policy_t
+#define OVERLOAD_COALESCE       0    // 每节点只保留最新未读数值 (邮箱合并)，队列每节点至多一项
+#define OVERLOAD_DROP_NEWEST    1    // FIFO 传递负载副本，队列满时丢弃新到数值
+#define OVERLOAD_DROP_OLDEST    2    // FIFO 传递负载副本，队列满时淘汰最旧数值
+#define OVERLOAD_POLICY         OVERLOAD_COALESCE
+#define INGEST_QUEUE_LEN        MAX_SENSOR_NODES
+#define NODE_ADMIT_RATE_PER_MIN 120  // 每节点令牌补充速率 (数值变化/分钟)，0 表示不限速
+#define NODE_ADMIT_BURST        8    // 令牌桶容量
+
+#if OVERLOAD_POLICY == OVERLOAD_COALESCE && INGEST_QUEUE_LEN < MAX_SENSOR_NODES
+#error "OVERLOAD_COALESCE needs one ingest queue entry per node"
+#endif
+#if MAX_SENSOR_NODES != NODE_MAILBOX_MAX_NODES
+#error "node mailbox slots must match MAX_SENSOR_NODES"
+#endif
+_Static_assert(OVERLOAD_COALESCE == NODE_MAILBOX_COALESCE && OVERLOAD_DROP_NEWEST == NODE_MAILBOX_DROP_NEWEST &&
+               OVERLOAD_DROP_OLDEST == NODE_MAILBOX_DROP_OLDEST, "OVERLOAD_POLICY values must match node_mailbox_policy_t");
+#if MAX_SENSOR_NODES != SCAN_FILTER_MAX_NODES
+#error "scan filter address table must match MAX_SENSOR_NODES"
+#endif
+#if SCAN_ACCEPT_LIST_MAX > SCAN_FILTER_LIST_MAX
+#error "CONFIG_BT_NIMBLE_WHITELIST_SIZE exceeds SCAN_FILTER_LIST_MAX"
+#endif
+
+// --- Task Placement (ESP32-S3) ---
+// core 0: BT 控制器、NimBLE host、Wi-Fi/lwIP; core 1: 解码、SD 写入、OLED 刷新、截图编码，
+// 避免 SD/I2C 阻塞与扫描回调争用同一核心。host 任务的核心与栈大小取自 sdkconfig
+#define BLE_HOST_TASK_CORE   CONFIG_BT_NIMBLE_PINNED_TO_CORE
+#define BLE_HOST_TASK_STACK  CONFIG_BT_NIMBLE_HOST_TASK_STACK_SIZE
+#define BLE_HOST_TASK_PRIO   (configMAX_PRIORITIES - 4)   // 同 nimble_port_freertos_init
+#define INGEST_TASK_CORE     1
+#define INGEST_TASK_PRIO     6       // 只做解码与状态更新，抢占 SD 写入，保证显示数据新鲜
+#define INGEST_TASK_STACK    4096
+#define STORAGE_TASK_CORE    1
+#define STORAGE_TASK_PRIO    4
+#define STORAGE_TASK_STACK   4096
+#define DISPLAY_TASK_CORE    1
+#define DISPLAY_TASK_PRIO    5
+#define DISPLAY_TASK_STACK   4096
+#define CAPTURE_TASK_CORE    1
+#define CAPTURE_TASK_PRIO    2
+#define CAPTURE_TASK_STACK   4096
+
+// --- Pipeline Benchmark ---
+// 1: 在 host 任务内注入合成 v2 广播 (不经过射频)，统计丢弃率与从接收到写入完成的延迟
+#define PIPELINE_BENCH_ENABLED    0
+#define PIPELINE_BENCH_NODES      16
+#define PIPELINE_BENCH_NODE_BASE  0xC0    // 合成节点 ID 起点，真实节点 ID 须小于此值
+#define PIPELINE_BENCH_RATE       2000    // 每秒注入的广播数
+#define PIPELINE_BENCH_PERIOD_MS  10
+#define PIPELINE_BENCH_REPORT_S   10
 
 // --- Data Structures ---
-#pragma pack(push, 1)
+// 广播负载格式见 sensor_payload.h
+#if ADV_PAYLOAD_MAX > NODE_MAILBOX_PAYLOAD_MAX
+#error "node mailbox payload is shorter than ADV_PAYLOAD_MAX"
+#endif
+
+// 解码后的读数，各版本共用
 typedef struct {
-    uint16_t manu_id;
     uint8_t  node_id;
+    uint8_t  version;       // 1, ADV_PAYLOAD_VERSION_2 或 ADV_PAYLOAD_VERSION_3
+    uint16_t seq;           // v2 起有效
     int16_t  temperature;
     uint16_t humidity;
     uint16_t illuminance;
-} adv_sensor_data_t;
-#pragma pack(pop)
+} sensor_reading_t;
+
+// 一个负载解码出的读数，按时间由旧到新
+typedef struct {
+    uint8_t          count;
+    sensor_reading_t samples[ADV_BATCH_MAX];
+    int64_t          sample_us[ADV_BATCH_MAX];  // 采样时刻 (esp_timer)
+} sensor_batch_t;
 
 #define TEMP_ERROR_VAL      INT16_MAX
 #define HUMI_ERROR_VAL      UINT16_MAX
 #define LUX_ERROR_VAL       UINT16_MAX
 
+// sensor_node_status_t.valid 位
+#define NODE_VALID_TEMP     (1u << 0)
+#define NODE_VALID_HUMI     (1u << 1)
+#define NODE_VALID_LUX      (1u << 2)
+
+// 节点状态保存广播中的原始定点值 (0.01 单位)，有效性由 valid 位标记
 typedef struct {
     uint8_t  node_id;
-    float    temperature;
-    float    humidity;
-    uint16_t illuminance;
+    uint8_t  valid;         // NODE_VALID_* 位
+    int16_t  temperature;   // 0.01 °C
+    uint16_t humidity;      // 0.01 %RH
+    uint16_t illuminance;   // lux
     time_t   last_seen;
 } sensor_node_status_t;
 
+// 每节点序号统计 (v2 起)，每个读数 O(1) 更新
+typedef struct {
+    bool     has_seq;
+    uint16_t last_seq;
+    uint32_t window;        // 接收位图: bit i 表示 last_seq - i 已收到
+    uint32_t received;
+    uint32_t lost;
+    uint32_t duplicates;    // 同一序号被重复记录
+    uint32_t reordered;
+    uint32_t gaps;
+    uint32_t restarts;
+} node_seq_stats_t;
+
+// 待写记录: 经 g_storage_queue 由 ingest_task 传给 storage_task，未就绪时缓存;
+// 时间戳为单调时钟，写入时再换算为墙钟时间
+typedef struct {
+    sensor_reading_t reading;
+    int64_t          sample_us;  // esp_timer
+    int16_t          lost;       // 此读数之前丢失的读数个数
+} log_record_t;
+
+// 流水线阶段统计，仅由该阶段的任务更新; 积压与耗时按报告周期清零
+typedef struct {
+    uint32_t processed;
+    uint32_t dropped;       // 下游队列满被丢弃的读数
+    uint32_t backlog_max;   // 输入队列最大深度
+    int64_t  busy_us;
+    int64_t  busy_max_us;   // 单次处理最长耗时
+} stage_stats_t;
+
+// 启动里程碑 (esp_timer，自上电起的 µs)，0 表示尚未发生
+typedef struct {
+    int64_t ble_sync_us;
+    int64_t first_sample_us;     // 首个有效传感器广播
+    int64_t wifi_us;
+    int64_t time_sync_us;
+    int64_t first_logged_us;     // 首条记录写入 SD 卡
+} startup_marks_t;
+
 // --- Global Variables & Flags for startup synchronization ---
 static sensor_node_status_t g_sensor_nodes[MAX_SENSOR_NODES];
+static node_seq_stats_t g_node_seq_stats[MAX_SENSOR_NODES];  // 与 g_sensor_nodes 同索引
+static log_record_t g_pending_log[PENDING_LOG_MAX];           // 环形缓冲，仅 storage_task 访问
+static uint16_t g_pending_head = 0;
+static uint16_t g_pending_count = 0;
+static uint32_t g_pending_dropped = 0;
+static startup_marks_t g_startup;
 static int g_active_node_count = 0;
 static bool g_sntp_initialized = false;
 static bool g_sd_card_mounted = false;
 static esp_err_t g_sd_card_err = ESP_OK; // *** 新增：存储SD卡错误码 ***
-static QueueHandle_t g_logging_queue;
+static QueueHandle_t g_ingest_queue;   // 槽位索引或 node_mailbox_msg_t，取决于 OVERLOAD_POLICY (host → ingest_task)
+static QueueHandle_t g_storage_queue;  // log_record_t (ingest_task → storage_task)
+static stage_stats_t g_ingest_stats;
+static stage_stats_t g_storage_stats;
+static uint16_t g_storage_lost[MAX_SENSOR_NODES];  // 与 g_sensor_nodes 同索引，入队失败的读数，并入下一条记录的缺口
 
 static i2c_master_bus_handle_t g_i2c_bus_handle = NULL;
 static ssd1306_handle_t g_oled_handle = NULL;
@@ -98,13 +254,66 @@ static ssd1306_handle_t g_oled_handle = NULL;
 static bool g_wifi_connected = false;
 static bool g_ble_synced = false;
 
+// 扫描过滤列表，仅在 NimBLE host 任务中访问
+static scan_filter_t g_scan_filter;
+static scan_sched_t g_scan_sched;           // 按节点广播周期预测扫描窗口
+static struct ble_npl_callout g_scan_callout;
+static int64_t g_scan_radio_start_us = 0;
+
+// 每个扫描阶段的统计
+static uint32_t g_scan_phase_events = 0;
+static uint32_t g_scan_phase_windows = 0;
+static uint32_t g_scan_phase_filtered = 0;   // 使用控制器过滤列表的扫描次数
+static int64_t g_scan_phase_cb_us = 0;
+static int64_t g_scan_phase_radio_us = 0;
+static int64_t g_scan_phase_start_us = 0;
+
+static node_mailbox_table_t g_mailbox;     // 仅由 NimBLE host 任务写入
+static node_mailbox_channel_t g_ingest_channel;   // g_mailbox 经 g_ingest_queue 到 ingest_task
+
+#if DISPLAY_CAPTURE_ENABLED
+typedef struct {
+    uint8_t  pages[DISPLAY_FRAME_BYTES];
+    uint32_t time_ms;
+    bool     snapshot;
+} display_capture_frame_t;
+
+static display_capture_frame_t g_capture_frames[DISPLAY_CAPTURE_SLOTS];
+static QueueHandle_t g_capture_free_queue;   // 空闲帧槽
+static QueueHandle_t g_capture_ready_queue;  // 待编码帧槽
+static volatile bool g_capture_requested = false;
+static uint32_t g_capture_dropped = 0;       // display_task 写入，capture_task 读取并报告
+#endif
+
 
 // --- Function Prototypes ---
 static void ble_central_scan(void);
+#if PIPELINE_BENCH_ENABLED
+static void pipeline_bench_start(void);
+#endif
+
+// --- Startup Instrumentation ---
+static void startup_mark(int64_t *mark) {
+    if (*mark == 0) *mark = esp_timer_get_time();
+}
+
+static void startup_report(void) {
+    ESP_LOGI(TAG, "Startup (ms since boot): BLE sync %" PRId64 ", first sample %" PRId64 ", Wi-Fi %" PRId64 ", time sync %" PRId64 ", first logged sample %" PRId64,
+             g_startup.ble_sync_us / 1000, g_startup.first_sample_us / 1000, g_startup.wifi_us / 1000,
+             g_startup.time_sync_us / 1000, g_startup.first_logged_us / 1000);
+}
 
 // --- Time Sync ---
+// 墙钟时间与 esp_timer 单调时钟之差，同步前记录的读数据此回填真实时间
+static int64_t wall_clock_offset_us(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec - esp_timer_get_time();
+}
+
 void time_sync_notification_cb(struct timeval *tv) {
-    ESP_LOGI(TAG, "Time synchronized");
+    startup_mark(&g_startup.time_sync_us);
+    ESP_LOGI(TAG, "Time synchronized (wall clock offset %" PRId64 " us)", wall_clock_offset_us());
     g_sntp_initialized = true;
 }
 
@@ -122,11 +331,9 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base, int32_t e
         esp_wifi_connect();
     } else if (event_id == WIFI_EVENT_STA_CONNECTED) {
         ESP_LOGI(TAG, "Connected to Wi-Fi. Initializing SNTP...");
+        startup_mark(&g_startup.wifi_us);
         g_wifi_connected = true;
         initialize_sntp();
-        if (g_ble_synced) {
-            ble_central_scan();
-        }
     } else if (event_id == WIFI_EVENT_STA_DISCONNECTED) {
         ESP_LOGI(TAG, "Disconnected from Wi-Fi. Retrying...");
         g_wifi_connected = false;
@@ -208,34 +415,445 @@ static void oled_init(void) {
     };
     ESP_ERROR_CHECK(i2c_new_master_bus(&i2c_bus_config, &g_i2c_bus_handle));
     ssd1306_config_t dev_cfg = I2C_SSD1306_128x64_CONFIG_DEFAULT;
+    dev_cfg.frame_lock_enabled = true; // other tasks may draw overlays between display_task frames
+    dev_cfg.clock_negotiation_enabled = true; // 从 100kHz 向上探测 400kHz/1MHz，出错时自动降速
     ESP_ERROR_CHECK(ssd1306_init(g_i2c_bus_handle, &dev_cfg, &g_oled_handle));
     ESP_LOGI(TAG, "OLED Initialized");
 }
 
+#if DISPLAY_CAPTURE_ENABLED
+// --- Display Capture ---
+// display_task 只把帧缓冲复制到空闲槽位，由 capture_task 编码并写出，
+// SD 卡或串口较慢时不会拖慢显示
+static void IRAM_ATTR capture_button_isr(void *arg) {
+    g_capture_requested = true;
+}
+
+static void capture_init(void) {
+    g_capture_free_queue = xQueueCreate(DISPLAY_CAPTURE_SLOTS, sizeof(uint8_t));
+    g_capture_ready_queue = xQueueCreate(DISPLAY_CAPTURE_SLOTS, sizeof(uint8_t));
+    for (uint8_t slot = 0; slot < DISPLAY_CAPTURE_SLOTS; slot++) {
+        xQueueSend(g_capture_free_queue, &slot, 0);
+    }
+
+    gpio_config_t io_conf = {
+        .pin_bit_mask = 1ULL << DISPLAY_CAPTURE_PIN,
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .intr_type = GPIO_INTR_NEGEDGE,
+    };
+    ESP_ERROR_CHECK(gpio_config(&io_conf));
+    ESP_ERROR_CHECK(gpio_install_isr_service(0));
+    ESP_ERROR_CHECK(gpio_isr_handler_add(DISPLAY_CAPTURE_PIN, capture_button_isr, NULL));
+}
+
+// 由 display_task 在持有帧锁期间调用
+static void capture_display_frame(void) {
+    bool snapshot = g_capture_requested;
+    uint8_t slot;
+
+    if (!snapshot && !DISPLAY_CAPTURE_STREAM) return;
+
+    if (xQueueReceive(g_capture_free_queue, &slot, 0) != pdTRUE) {
+        __atomic_fetch_add(&g_capture_dropped, 1, __ATOMIC_RELAXED); // 编码器忙，丢弃本帧
+        return;
+    }
+
+    display_capture_frame_t *frame = &g_capture_frames[slot];
+    ssd1306_get_pages(g_oled_handle, frame->pages);
+    frame->time_ms = (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+    frame->snapshot = snapshot;
+    g_capture_requested = false;
+
+    xQueueSend(g_capture_ready_queue, &slot, 0);
+}
+
+static inline bool capture_pixel(const uint8_t *pages, int x, int y) {
+    return (pages[(y / 8) * SSD1306_PAGE_SEGMENT_SIZE + x] >> (y % 8)) & 0x01;
+}
+
+// 写出 PBM 截图，点亮的像素与屏幕上一样为白色 (0)
+static void capture_write_pbm(const display_capture_frame_t *frame) {
+    static uint16_t shot_index = 0;
+    const int width = SSD1306_PANEL_128x64_WIDTH;
+    const int height = SSD1306_PANEL_128x64_HEIGHT;
+
+    if (g_sd_card_mounted) {
+        char filepath[32];
+        snprintf(filepath, sizeof(filepath), SD_CARD_MOUNT_POINT "/scr%05u.pbm", shot_index++);
+        FILE *f = fopen(filepath, "wb");
+        if (f == NULL) {
+            ESP_LOGE(TAG, "Failed to open file for writing: %s", filepath);
+            return;
+        }
+        fprintf(f, "P4\n%d %d\n", width, height);
+        for (int y = 0; y < height; y++) {
+            uint8_t row[SSD1306_PANEL_128x64_WIDTH / 8] = {0};
+            for (int x = 0; x < width; x++) {
+                if (!capture_pixel(frame->pages, x, y)) row[x / 8] |= 0x80 >> (x % 8);
+            }
+            fwrite(row, 1, sizeof(row), f);
+        }
+        fclose(f);
+        ESP_LOGI(TAG, "Screenshot saved: %s", filepath);
+    } else {
+        // SD 卡不可用时通过串口输出 ASCII PBM
+        printf("-----BEGIN PBM %" PRIu32 "-----\nP1\n%d %d\n", frame->time_ms, width, height);
+        for (int y = 0; y < height; y++) {
+            char line[SSD1306_PANEL_128x64_WIDTH + 1];
+            for (int x = 0; x < width; x++) {
+                line[x] = capture_pixel(frame->pages, x, y) ? '0' : '1';
+            }
+            line[width] = '\0';
+            printf("%s\n", line);
+        }
+        printf("-----END PBM-----\n");
+    }
+}
+
+// 与 ssd1306_set_rle_image 相同的字面/重复游程，返回编码后的长度
+static size_t capture_rle_encode(const uint8_t *data, size_t len, uint8_t *out) {
+    size_t i = 0, o = 0, lit_start = 0, lit_len = 0;
+
+    while (i < len) {
+        size_t run = 1;
+        while (i + run < len && data[i + run] == data[i] && run < SSD1306_RLE_COUNT_MASK + 1) run++;
+        if (run >= 3 || lit_len == SSD1306_RLE_COUNT_MASK + 1) {
+            if (lit_len > 0) {
+                out[o++] = (uint8_t)(lit_len - 1);
+                memcpy(&out[o], &data[lit_start], lit_len);
+                o += lit_len;
+                lit_len = 0;
+            }
+            if (run < 3) continue;
+            out[o++] = SSD1306_RLE_REPEAT | (uint8_t)(run - 1);
+            out[o++] = data[i];
+            i += run;
+        } else {
+            if (lit_len == 0) lit_start = i;
+            lit_len++;
+            i++;
+        }
+    }
+    if (lit_len > 0) {
+        out[o++] = (uint8_t)(lit_len - 1);
+        memcpy(&out[o], &data[lit_start], lit_len);
+        o += lit_len;
+    }
+
+    return o;
+}
+
+// 追加一条帧记录: [u32 时间 ms][u8 标志][u16 长度][本帧与上一帧异或后的 RLE]。
+// 标志位 0 表示关键帧，相对全灭的帧编码
+static void capture_write_delta(const display_capture_frame_t *frame) {
+    static uint8_t prev[DISPLAY_FRAME_BYTES];
+    static uint8_t delta[DISPLAY_FRAME_BYTES];
+    static uint8_t record[7 + DISPLAY_FRAME_BYTES + (DISPLAY_FRAME_BYTES / 128) + 1];
+    static bool key_frame = true;
+    bool changed = key_frame;
+
+    for (size_t i = 0; i < DISPLAY_FRAME_BYTES; i++) {
+        delta[i] = frame->pages[i] ^ prev[i];
+        changed |= (delta[i] != 0);
+    }
+    if (!changed) return; // 画面未变化，不记录
+
+    size_t len = capture_rle_encode(delta, DISPLAY_FRAME_BYTES, &record[7]);
+    memcpy(&record[0], &frame->time_ms, sizeof(uint32_t));
+    record[4] = key_frame ? 0x01 : 0x00;
+    record[5] = (uint8_t)(len & 0xFF);
+    record[6] = (uint8_t)(len >> 8);
+    len += 7;
+
+    if (g_sd_card_mounted) {
+        struct stat st;
+        bool file_exists = (stat(DISPLAY_CAPTURE_STREAM_FILE, &st) == 0);
+        FILE *f = fopen(DISPLAY_CAPTURE_STREAM_FILE, "ab");
+        if (f == NULL) {
+            ESP_LOGE(TAG, "Failed to open file for writing: %s", DISPLAY_CAPTURE_STREAM_FILE);
+            return;
+        }
+        if (!file_exists) {
+            const uint8_t size[2] = { SSD1306_PANEL_128x64_WIDTH, SSD1306_PANEL_128x64_HEIGHT };
+            fwrite(DISPLAY_CAPTURE_MAGIC, 1, strlen(DISPLAY_CAPTURE_MAGIC), f);
+            fwrite(size, 1, sizeof(size), f);
+        }
+        fwrite(record, 1, len, f);
+        fclose(f);
+    } else {
+        printf("CAP:");
+        for (size_t i = 0; i < len; i++) printf("%02x", record[i]);
+        printf("\n");
+    }
+
+    memcpy(prev, frame->pages, DISPLAY_FRAME_BYTES);
+    key_frame = false;
+}
+
+static void capture_task(void *pvParameters) {
+    uint8_t slot;
+    uint32_t reported_dropped = 0;
+    int64_t next_report_us = 0;
+
+    while (1) {
+        if (xQueueReceive(g_capture_ready_queue, &slot, pdMS_TO_TICKS(DISPLAY_CAPTURE_REPORT_S * 1000))) {
+            display_capture_frame_t *frame = &g_capture_frames[slot];
+            if (frame->snapshot) capture_write_pbm(frame);
+            if (DISPLAY_CAPTURE_STREAM) capture_write_delta(frame);
+            xQueueSend(g_capture_free_queue, &slot, 0);
+        }
+
+        // 丢帧说明编码/写出跟不上显示，差分流里缺少这些帧
+        uint32_t dropped = __atomic_load_n(&g_capture_dropped, __ATOMIC_RELAXED);
+        if (dropped != reported_dropped && esp_timer_get_time() >= next_report_us) {
+            ESP_LOGW(TAG, "Capture dropped %" PRIu32 " frames (%" PRIu32 " total), encoder busy", dropped - reported_dropped, dropped);
+            reported_dropped = dropped;
+            next_report_us = esp_timer_get_time() + (int64_t)DISPLAY_CAPTURE_REPORT_S * 1000000;
+        }
+    }
+}
+#endif
+
+// --- Node Mailbox ---
+_Static_assert(NODE_MAILBOX_RSSI_UNAVAIL == BLE_HS_ADV_RSSI_UNAVAIL, "node mailbox must skip the same unavailable RSSI");
+
+// v3 节点重发同一批读数时只有发送时间字段变化，比较时跳过
+static bool mailbox_same_payload(const uint8_t *stored, const uint8_t *payload, uint8_t len) {
+    if (len >= ADV_BATCH_HEADER_SIZE && payload[2] == ADV_PAYLOAD_VERSION_3) {
+        return memcmp(stored, payload, ADV_BATCH_AGE_OFFSET) == 0 &&
+               memcmp(&stored[ADV_BATCH_AGE_OFFSET + 2], &payload[ADV_BATCH_AGE_OFFSET + 2],
+                      len - ADV_BATCH_AGE_OFFSET - 2) == 0;
+    }
+    return memcmp(stored, payload, len) == 0;
+}
+
+static bool ingest_queue_send(void *queue, const void *item) {
+    return xQueueSend((QueueHandle_t)queue, item, 0) == pdTRUE;
+}
+
+static bool ingest_queue_receive(void *queue, void *item, uint32_t timeout_ms) {
+    return xQueueReceive((QueueHandle_t)queue, item, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+}
+
+// 仅由 NimBLE host 任务调用 (唯一写者)
+static void mailbox_post(uint8_t node_id, const uint8_t *payload, uint8_t len, int64_t rx_us,
+                         const ble_addr_t *addr, int8_t rssi) {
+    uint8_t slot;
+    if (node_mailbox_post(&g_mailbox, node_id, payload, len, rx_us, addr->val, rssi, &slot) == NODE_MAILBOX_NEW &&
+        g_ingest_queue != NULL) {
+        // 按 OVERLOAD_POLICY 交给 ingest_task
+        node_mailbox_deliver(&g_ingest_channel, slot);
+    }
+}
+
 // --- BLE Logic ---
+static inline uint16_t get_le16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+// 批量读数字段: 相对最新读数的 int8 差值，或转义后的 2 字节绝对值
+static bool decode_batch_field(const uint8_t *mfg, uint8_t len, uint8_t *pos, uint16_t newest, uint16_t *value) {
+    if (*pos >= len) return false;
+    int8_t delta = (int8_t)mfg[(*pos)++];
+    if (delta != ADV_BATCH_ESCAPE) {
+        *value = (uint16_t)(newest + delta);
+        return true;
+    }
+    if (*pos + 2 > len) return false;
+    *value = get_le16(&mfg[*pos]);
+    *pos += 2;
+    return true;
+}
+
+static bool decode_sensor_payload(const uint8_t *mfg, uint8_t len, int64_t rx_us, sensor_batch_t *batch) {
+    sensor_reading_t *reading = &batch->samples[0];
+    batch->count = 1;
+    batch->sample_us[0] = rx_us;
+
+    if (len == sizeof(adv_sensor_data_t)) {
+        adv_sensor_data_t v1;
+        memcpy(&v1, mfg, sizeof(v1));
+        reading->node_id = v1.node_id;
+        reading->version = 1;
+        reading->seq = 0;
+        reading->temperature = v1.temperature;
+        reading->humidity = v1.humidity;
+        reading->illuminance = v1.illuminance;
+        return true;
+    }
+    if (len == sizeof(adv_sensor_data_v2_t)) {
+        adv_sensor_data_v2_t v2;
+        memcpy(&v2, mfg, sizeof(v2));
+        if (v2.version != ADV_PAYLOAD_VERSION_2) return false;
+        reading->node_id = v2.node_id;
+        reading->version = v2.version;
+        reading->seq = v2.seq;
+        reading->temperature = v2.temperature;
+        reading->humidity = v2.humidity;
+        reading->illuminance = v2.illuminance;
+        return true;
+    }
+    if (len < ADV_BATCH_HEADER_SIZE || mfg[2] != ADV_PAYLOAD_VERSION_3) return false;
+
+    uint8_t count = mfg[6];
+    if (count == 0 || count > ADV_BATCH_MAX) return false;
+
+    sensor_reading_t newest = {
+        .node_id = mfg[3],
+        .version = ADV_PAYLOAD_VERSION_3,
+        .seq = get_le16(&mfg[4]),
+        .temperature = (int16_t)get_le16(&mfg[9]),
+        .humidity = get_le16(&mfg[11]),
+        .illuminance = get_le16(&mfg[13]),
+    };
+    int64_t newest_us = rx_us - (int64_t)get_le16(&mfg[ADV_BATCH_AGE_OFFSET]) * 100000;
+    batch->count = count;
+    batch->samples[count - 1] = newest;
+    batch->sample_us[count - 1] = newest_us;
+
+    uint8_t pos = ADV_BATCH_HEADER_SIZE;
+    for (uint8_t i = 1; i < count; i++) {
+        if (pos + 2 > len) return false;
+        int64_t offset_us = (int64_t)get_le16(&mfg[pos]) * 100000;
+        pos += 2;
+
+        uint16_t temperature, humidity, illuminance;
+        if (!decode_batch_field(mfg, len, &pos, (uint16_t)newest.temperature, &temperature) ||
+            !decode_batch_field(mfg, len, &pos, newest.humidity, &humidity) ||
+            !decode_batch_field(mfg, len, &pos, newest.illuminance, &illuminance)) {
+            return false;
+        }
+        sensor_reading_t *sample = &batch->samples[count - 1 - i];
+        *sample = newest;
+        sample->seq = (uint16_t)(newest.seq - i);
+        sample->temperature = (int16_t)temperature;
+        sample->humidity = humidity;
+        sample->illuminance = illuminance;
+        batch->sample_us[count - 1 - i] = newest_us - offset_us;
+    }
+    return pos == len;
+}
+
+static void scan_phase_report(scan_sched_phase_t phase) {
+    int64_t elapsed_us = esp_timer_get_time() - g_scan_phase_start_us;
+    if (elapsed_us <= 0) return;
+    ESP_LOGI(TAG, "Scan phase (%s): %" PRIu32 " adverts, %" PRIu32 "/s, %" PRIu32 " windows (%" PRIu32 " filtered), radio %" PRId64 "%%, callback CPU %" PRId64 " us (%" PRId64 ".%02" PRId64 "%%)",
+             phase == SCAN_SCHED_PHASE_SCHEDULED ? "scheduled" : "discovery", g_scan_phase_events,
+             (uint32_t)((int64_t)g_scan_phase_events * 1000000 / elapsed_us), g_scan_phase_windows, g_scan_phase_filtered,
+             g_scan_phase_radio_us * 100 / elapsed_us,
+             g_scan_phase_cb_us, g_scan_phase_cb_us * 100 / elapsed_us, g_scan_phase_cb_us * 10000 / elapsed_us % 100);
+    ESP_LOGI(TAG, "Mailbox: %" PRIu32 " duplicate adverts coalesced, %" PRIu32 " dropped (node table full); "
+             "accept list: %d addresses known, %" PRIu32 " scheduled scans unfiltered",
+             g_mailbox.duplicates, g_mailbox.overflow, g_scan_filter.count, g_scan_filter.unfiltered);
+}
+
+static void ble_central_on_advert(const ble_addr_t *addr, int8_t rssi, const uint8_t *data, uint8_t length) {
+    int64_t cb_start_us = esp_timer_get_time();
+    g_scan_phase_events++;
+    uint8_t mfg_len = 0;
+    uint8_t node_id;
+    const uint8_t *mfg = sensor_payload_find(data, length, &mfg_len, &node_id);
+    if (mfg != NULL) {
+        if (scan_filter_learn(&g_scan_filter, node_id, addr->type, addr->val)) {
+            ESP_LOGD(TAG, "Node %u at %02x:%02x:%02x:%02x:%02x:%02x", node_id,
+                     addr->val[5], addr->val[4], addr->val[3], addr->val[2], addr->val[1], addr->val[0]);
+        }
+        scan_sched_observe(&g_scan_sched, node_id, cb_start_us);
+        startup_mark(&g_startup.first_sample_us);
+        mailbox_post(node_id, mfg, mfg_len, cb_start_us, addr, rssi);
+    }
+    g_scan_phase_cb_us += esp_timer_get_time() - cb_start_us;
+}
+
 static int ble_central_gap_event(struct ble_gap_event *event, void *arg) {
-    if (event->type == BLE_GAP_EVENT_DISC) {
-        struct ble_hs_adv_fields fields;
-        if (ble_hs_adv_parse_fields(&fields, event->disc.data, event->disc.length_data) == 0) {
-            if (fields.mfg_data != NULL && fields.mfg_data_len == sizeof(adv_sensor_data_t)) {
-                adv_sensor_data_t *data = (adv_sensor_data_t *)fields.mfg_data;
-                if (data->manu_id == CUSTOM_MANU_ID) {
-                    if (g_logging_queue != NULL) {
-                        xQueueSend(g_logging_queue, data, 0);
-                    }
-                }
-            }
+    if (event->type == BLE_GAP_EVENT_DISC_COMPLETE) {
+        g_scan_phase_radio_us += esp_timer_get_time() - g_scan_radio_start_us;
+        ble_central_scan();
+    } else if (event->type == BLE_GAP_EVENT_DISC) {
+        ble_central_on_advert(&event->disc.addr, event->disc.rssi, event->disc.data, event->disc.length_data);
+#if CONFIG_BT_NIMBLE_EXT_ADV
+    } else if (event->type == BLE_GAP_EVENT_EXT_DISC) {
+        // 启用扩展广播后所有广播都经此事件上报; 分片未收齐的数据不处理
+        if (event->ext_disc.data_status == BLE_GAP_EXT_ADV_DATA_STATUS_COMPLETE) {
+            ble_central_on_advert(&event->ext_disc.addr, event->ext_disc.rssi, event->ext_disc.data, event->ext_disc.length_data);
         }
+#endif
     }
     return 0;
 }
 
-static void ble_central_scan(void) {
-    ESP_LOGI(TAG, "Starting BLE scan (Observer Mode)...");
+static void ble_central_scan_start(bool filtered, bool full_duty, int64_t duration_ms) {
     struct ble_gap_disc_params disc_params = {0};
     disc_params.passive = 1;
     disc_params.filter_duplicates = 0;
-    ble_gap_disc(BLE_OWN_ADDR_PUBLIC, BLE_HS_FOREVER, &disc_params, ble_central_gap_event, NULL);
+    disc_params.filter_policy = filtered ? BLE_HCI_SCAN_FILT_USE_WL : BLE_HCI_SCAN_FILT_NO_WL;
+    disc_params.itvl = SCAN_ITVL;
+    disc_params.window = full_duty ? SCAN_ITVL : SCAN_WINDOW;
+
+    int rc = ble_gap_disc(BLE_OWN_ADDR_PUBLIC, (int32_t)duration_ms, &disc_params, ble_central_gap_event, NULL);
+    if (rc != 0) {
+        // 不会再有 DISC_COMPLETE 事件，由 callout 重新进入 ble_central_scan，否则扫描永久停止
+        ESP_LOGE(TAG, "Failed to start scan; rc=%d, retrying in %d ms", rc, SCAN_RETRY_MS);
+        ble_npl_callout_reset(&g_scan_callout, ble_npl_time_ms_to_ticks32(SCAN_RETRY_MS));
+        return;
+    }
+    g_scan_radio_start_us = esp_timer_get_time();
+    g_scan_phase_windows++;
+    if (filtered) g_scan_phase_filtered++;
+}
+
+static void ble_central_scan_callout(struct ble_npl_event *ev) {
+    ble_central_scan();
+}
+
+// 调度阶段与发现阶段交替 (scan_sched_step): 调度阶段按预测的广播时间开窗，发现阶段连续扫描以学习新节点。
+// 调度阶段每次扫描前把预期节点写入控制器过滤列表; 放不下、地址未知或设置失败时不过滤，开窗照常进行
+static void ble_central_scan(void) {
+    if (ble_gap_disc_active() || ble_npl_callout_is_active(&g_scan_callout)) return;
+
+    int64_t now_us = esp_timer_get_time();
+    scan_sched_phase_t last_phase = g_scan_sched.phase;
+    scan_sched_step_t step;
+    if (scan_sched_step(&g_scan_sched, now_us, &step)) {
+        if (g_scan_phase_start_us != 0) scan_phase_report(last_phase);
+        ESP_LOGI(TAG, "Starting BLE scan (Observer Mode, %s)...",
+                 g_scan_sched.phase == SCAN_SCHED_PHASE_SCHEDULED ? "scheduled" : "discovery");
+        g_scan_phase_events = 0;
+        g_scan_phase_windows = 0;
+        g_scan_phase_filtered = 0;
+        g_scan_phase_cb_us = 0;
+        g_scan_phase_radio_us = 0;
+        g_scan_phase_start_us = now_us;
+    }
+
+    if (!step.scan) {
+        uint32_t delay_ms = (uint32_t)((step.end_us - now_us) / 1000);
+        ble_npl_callout_reset(&g_scan_callout, ble_npl_time_ms_to_ticks32(delay_ms ? delay_ms : 1));
+        return;
+    }
+
+    // 过滤列表只能在扫描停止时设置
+    bool filtered = false;
+    bool changed;
+    if (g_scan_sched.phase == SCAN_SCHED_PHASE_SCHEDULED &&
+        scan_filter_build(&g_scan_filter, step.node_ids, step.node_count, &changed)) {
+        filtered = true;
+        if (changed) {
+            ble_addr_t list[SCAN_ACCEPT_LIST_MAX];
+            for (int i = 0; i < g_scan_filter.list_count; i++) {
+                list[i].type = g_scan_filter.list[i].type;
+                memcpy(list[i].val, g_scan_filter.list[i].val, sizeof(list[i].val));
+            }
+            int rc = ble_gap_wl_set(list, g_scan_filter.list_count);
+            if (rc != 0) {
+                ESP_LOGE(TAG, "Failed to set accept list; rc=%d", rc);
+                g_scan_filter.list_count = 0;   // 下次重新写入
+                filtered = false;
+            }
+        }
+    }
+    ble_central_scan_start(filtered, step.full_duty, (step.end_us - now_us + 999) / 1000);
 }
 
 static void ble_central_on_sync(void) {
@@ -245,21 +863,39 @@ static void ble_central_on_sync(void) {
         ESP_LOGE(TAG, "Error inferring address; rc=%d", rc);
         return;
     }
+    scan_sched_init(&g_scan_sched, (int64_t)SCAN_SCHEDULED_MS * 1000, (int64_t)SCAN_DISCOVERY_MS * 1000, SCAN_ACCEPT_LIST_MAX);
+    scan_filter_init(&g_scan_filter, SCAN_ACCEPT_LIST_MAX);
+    ble_npl_callout_init(&g_scan_callout, nimble_port_get_dflt_eventq(), ble_central_scan_callout, NULL);
+    startup_mark(&g_startup.ble_sync_us);
     g_ble_synced = true;
-    if (g_wifi_connected) {
-        ble_central_scan();
-    }
+    // 不等待 Wi-Fi/SNTP: 读数以单调时钟记录并缓存，时间同步后回填
+    ble_central_scan();
+#if PIPELINE_BENCH_ENABLED
+    pipeline_bench_start();
+#endif
 }
 
+// 自行创建 host 任务 (代替 nimble_port_freertos_init)，以便按 Task Placement 配置优先级
 void ble_host_task(void *param) {
     nimble_port_run();
-    nimble_port_freertos_deinit();
+    vTaskDelete(NULL);
 }
 
 // --- Tasks ---
+// 每帧一次把脏页发出去，失败的页保持脏状态下一帧重发
+static void display_flush(void) {
+    esp_err_t err = ssd1306_flush(g_oled_handle);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Display flush failed: %s", esp_err_to_name(err));
+    }
+}
+
 static void display_task(void *pvParameters) {
     int current_node_index = 0;
     bool all_systems_go = false;
+#if CONFIG_SSD1306_I2C_STATS
+    int stats_cycles = 0;
+#endif
 
     while (1) {
         if (g_oled_handle == NULL) {
@@ -267,40 +903,50 @@ static void display_task(void *pvParameters) {
             continue;
         }
 
+#if CONFIG_SSD1306_I2C_STATS
+        if (++stats_cycles >= DISPLAY_STATS_DUMP_CYCLES) {
+            stats_cycles = 0;
+            ssd1306_dump_i2c_stats(g_oled_handle);
+            ssd1306_reset_i2c_stats(g_oled_handle);
+        }
+#endif
+
         all_systems_go = g_sd_card_mounted && g_sntp_initialized && g_wifi_connected;
 
-        ssd1306_clear_display(g_oled_handle, false);
+        // 节点数据只取决于 g_active_node_count，不等待 SD/Wi-Fi/时间;
+        // 序号等于节点数时显示状态屏: 无节点时一直显示，有节点但子系统未就绪时每轮节点之后插入一屏
+        int node_count = g_active_node_count;
+        if (current_node_index > node_count || (current_node_index == node_count && node_count > 0 && all_systems_go)) {
+            current_node_index = 0;
+        }
+        bool show_status = current_node_index == node_count;
+
+        if (ssd1306_begin_frame(g_oled_handle, DISPLAY_FRAME_LOCK_MS) != ESP_OK) {
+            continue;
+        }
 
-        if (!all_systems_go) {
+        // 整帧先画进页缓冲区，结束前 ssd1306_flush 只发送变化的页段
+        ssd1306_clear_pages(g_oled_handle, false);
+
+        if (show_status) {
             // 显示系统自检状态
-            ssd1306_display_text(g_oled_handle, 0, "System Status:", false);
+            ssd1306_set_text(g_oled_handle, 0, node_count == 0 ? "Scanning..." : "System Status:", false);
             
             char status_buf[32];
             // *** 核心修改：显示具体的错误码 ***
             if (g_sd_card_mounted) {
                 snprintf(status_buf, sizeof(status_buf), "SD Card: OK");
             } else {
-                snprintf(status_buf, sizeof(status_buf), "SD Card: FAIL(%d)", g_sd_card_err);
+                snprintf(status_buf, sizeof(status_buf), "SD Card: E%d", g_sd_card_err);   // 一行最多 16 个字符
             }
-            ssd1306_display_text(g_oled_handle, 2, status_buf, false);
+            ssd1306_set_text(g_oled_handle, 2, status_buf, false);
 
             snprintf(status_buf, sizeof(status_buf), "Wi-Fi:   %s", g_wifi_connected ? "OK" : "...");
-            ssd1306_display_text(g_oled_handle, 4, status_buf, false);
+            ssd1306_set_text(g_oled_handle, 4, status_buf, false);
 
             snprintf(status_buf, sizeof(status_buf), "Time:    %s", g_sntp_initialized ? "OK" : "...");
-            ssd1306_display_text(g_oled_handle, 6, status_buf, false);
-            
-            vTaskDelay(pdMS_TO_TICKS(1000));
-            continue;
-        }
-
-        // --- 所有系统就绪，显示节点数据 ---
-        if (g_active_node_count == 0) {
-            ssd1306_display_text(g_oled_handle, 0, "Scanning...", false);
-            ssd1306_display_text(g_oled_handle, 2, "No nodes found.", false);
+            ssd1306_set_text(g_oled_handle, 6, status_buf, false);
         } else {
-            if (current_node_index >= g_active_node_count) current_node_index = 0;
-            
             sensor_node_status_t *node = &g_sensor_nodes[current_node_index];
             char line_buf[32];
             
@@ -308,100 +954,481 @@ static void display_task(void *pvParameters) {
 
             if (is_offline) {
                 snprintf(line_buf, sizeof(line_buf), "#%d/%d ID:%-3d OFF", current_node_index + 1, g_active_node_count, node->node_id);
-                ssd1306_display_text(g_oled_handle, 0, line_buf, false);
-                ssd1306_display_text(g_oled_handle, 2, "                ", false);
-                ssd1306_display_text(g_oled_handle, 4, "    OFFLINE     ", false);
-                ssd1306_display_text(g_oled_handle, 6, "                ", false);
+                ssd1306_set_text(g_oled_handle, 0, line_buf, false);
+                ssd1306_set_text(g_oled_handle, 2, "                ", false);
+                ssd1306_set_text(g_oled_handle, 4, "    OFFLINE     ", false);
+                ssd1306_set_text(g_oled_handle, 6, "                ", false);
             } else {
                 snprintf(line_buf, sizeof(line_buf), "#%d/%d ID:%-3d ON ", current_node_index + 1, g_active_node_count, node->node_id);
-                ssd1306_display_text(g_oled_handle, 0, line_buf, false);
+                ssd1306_set_text(g_oled_handle, 0, line_buf, false);
                 
-                if (isnan(node->temperature)) snprintf(line_buf, sizeof(line_buf), "Temp: error     ");
-                else snprintf(line_buf, sizeof(line_buf), "Temp: %.2f C   ", node->temperature);
-                ssd1306_display_text(g_oled_handle, 2, line_buf, false);
+                fixed_fmt_t fmt;
+                fixed_fmt_begin(&fmt, line_buf, sizeof(line_buf));
+                if (!(node->valid & NODE_VALID_TEMP)) fixed_fmt_str(&fmt, "Temp: error     ");
+                else {
+                    fixed_fmt_str(&fmt, "Temp: ");
+                    fixed_fmt_centi(&fmt, node->temperature, 0);
+                    fixed_fmt_str(&fmt, " °C  ");
+                }
+                ssd1306_set_text(g_oled_handle, 2, line_buf, false);
 
-                if (isnan(node->humidity)) snprintf(line_buf, sizeof(line_buf), "Humi: error     ");
-                else snprintf(line_buf, sizeof(line_buf), "Humi: %.2f %%   ", node->humidity);
-                ssd1306_display_text(g_oled_handle, 4, line_buf, false);
+                fixed_fmt_begin(&fmt, line_buf, sizeof(line_buf));
+                if (!(node->valid & NODE_VALID_HUMI)) fixed_fmt_str(&fmt, "Humi: error     ");
+                else {
+                    fixed_fmt_str(&fmt, "Humi: ");
+                    fixed_fmt_centi(&fmt, node->humidity, 0);
+                    fixed_fmt_str(&fmt, " %   ");
+                }
+                ssd1306_set_text(g_oled_handle, 4, line_buf, false);
 
-                if (node->illuminance == LUX_ERROR_VAL) snprintf(line_buf, sizeof(line_buf), "Lux:  error     ");
-                else snprintf(line_buf, sizeof(line_buf), "Lux:  %u      ", node->illuminance);
-                ssd1306_display_text(g_oled_handle, 6, line_buf, false);
+                fixed_fmt_begin(&fmt, line_buf, sizeof(line_buf));
+                if (!(node->valid & NODE_VALID_LUX)) fixed_fmt_str(&fmt, "Lux:  error     ");
+                else {
+                    fixed_fmt_str(&fmt, "Lux:  ");
+                    fixed_fmt_uint(&fmt, node->illuminance, 0);
+                    fixed_fmt_fill(&fmt, ' ', 6);
+                }
+                ssd1306_set_text(g_oled_handle, 6, line_buf, false);
             }
-            current_node_index++;
         }
+        current_node_index++;
+        display_flush();
+#if DISPLAY_CAPTURE_ENABLED
+        capture_display_frame();
+#endif
+        ssd1306_end_frame(g_oled_handle);
         
-        vTaskDelay(pdMS_TO_TICKS(DISPLAY_CYCLE_TIME_S * 1000));
+        // 尚无节点时每秒刷新状态，以便尽快切到节点视图
+        vTaskDelay(pdMS_TO_TICKS(node_count == 0 ? 1000 : DISPLAY_CYCLE_TIME_S * 1000));
+    }
+}
+
+static int sensor_node_index(uint8_t node_id, bool create) {
+    for (int i = 0; i < g_active_node_count; i++) {
+        if (g_sensor_nodes[i].node_id == node_id) return i;
     }
+    if (!create || g_active_node_count >= MAX_SENSOR_NODES) return -1;
+    g_sensor_nodes[g_active_node_count].node_id = node_id;
+    return g_active_node_count++;
 }
 
-static void logging_task(void *pvParameters) {
-    adv_sensor_data_t received_data;
+// 重复广播不入队，由邮箱的接收时间刷新节点在线状态
+static void refresh_last_seen(void) {
+    uint8_t count = node_mailbox_count(&g_mailbox);
+    int64_t now_us = esp_timer_get_time();
+    time_t now = time(NULL);
 
-    while (1) {
-        if (xQueueReceive(g_logging_queue, &received_data, portMAX_DELAY)) {
-            // Update the global state for OLED display
-            uint8_t node_id = received_data.node_id;
-            int node_index = -1;
-            for (int i = 0; i < g_active_node_count; i++) {
-                if (g_sensor_nodes[i].node_id == node_id) {
-                    node_index = i;
-                    break;
-                }
-            }
-            if (node_index == -1 && g_active_node_count < MAX_SENSOR_NODES) {
-                node_index = g_active_node_count;
-                g_sensor_nodes[node_index].node_id = node_id;
-                g_active_node_count++;
-            }
-            if (node_index != -1) {
-                if (received_data.temperature == TEMP_ERROR_VAL) g_sensor_nodes[node_index].temperature = NAN;
-                else g_sensor_nodes[node_index].temperature = (float)received_data.temperature / 100.0f;
+    for (uint8_t slot = 0; slot < count; slot++) {
+        uint8_t node_id = g_mailbox.box[slot].node_id;  // 槽位发布后不再改变
+        int64_t rx_us = node_mailbox_rx_us(&g_mailbox, slot);
+        int node_index = sensor_node_index(node_id, false);
+        if (node_index != -1) g_sensor_nodes[node_index].last_seen = now - (time_t)((now_us - rx_us) / 1000000);
+    }
+}
 
-                if (received_data.humidity == HUMI_ERROR_VAL) g_sensor_nodes[node_index].humidity = NAN;
-                else g_sensor_nodes[node_index].humidity = (float)received_data.humidity / 100.0f;
-                
-                g_sensor_nodes[node_index].illuminance = received_data.illuminance;
-                g_sensor_nodes[node_index].last_seen = time(NULL);
+// 返回此读数之前丢失的读数个数，-1 表示已记录过 (不再记录)
+// batched 为 true 时重发的批量读数是预期行为，不计入重复
+static int seq_track(node_seq_stats_t *st, uint16_t seq, bool batched) {
+    if (!st->has_seq) {
+        st->has_seq = true;
+        st->last_seq = seq;
+        st->window = 1;
+        st->received++;
+        return 0;
+    }
+    uint16_t ahead = (uint16_t)(seq - st->last_seq);
+    if (ahead > 0 && ahead < 0x8000) {
+        st->window = (ahead < 32) ? ((st->window << ahead) | 1) : 1;
+        st->last_seq = seq;
+        st->received++;
+        if (ahead == 1) return 0;
+        st->gaps++;
+        st->lost += ahead - 1;
+        return ahead - 1;
+    }
+    uint16_t behind = (uint16_t)(st->last_seq - seq);
+    if (behind <= SEQ_REORDER_WINDOW) {
+        if (st->window & (1u << behind)) {
+            if (!batched) st->duplicates++;
+            return -1;
+        }
+        // 迟到的读数此前已计为丢失
+        st->window |= 1u << behind;
+        st->received++;
+        st->reordered++;
+        if (st->lost > 0) st->lost--;
+        return 0;
+    }
+    st->restarts++;
+    st->received++;
+    st->last_seq = seq;
+    st->window = 1;
+    return 0;
+}
+
+// 百分比保留两位小数 (整数运算)
+static void format_rate(char *buf, size_t size, uint32_t part, uint32_t total) {
+    fixed_fmt_t fmt;
+    fixed_fmt_begin(&fmt, buf, size);
+    fixed_fmt_centi(&fmt, total ? (int32_t)((uint64_t)part * 10000 / total) : 0, 0);
+    fixed_fmt_str(&fmt, "%");
+}
+
+static void node_stats_report(void) {
+    static node_mailbox_t box;   // 含原始负载，放在静态区以节省任务栈
+    for (int i = 0; i < g_active_node_count; i++) {
+        int slot = node_mailbox_find(&g_mailbox, g_sensor_nodes[i].node_id);
+        if (slot != -1) {
+            node_mailbox_read(&g_mailbox, (uint8_t)slot, &box);
+            if (box.rssi_count > 0) {
+                ESP_LOGI(TAG, "Node %d link: %02x:%02x:%02x:%02x:%02x:%02x RSSI min %d / avg %" PRId64 " / max %d dBm over %" PRIu32 " adverts",
+                         box.node_id, box.addr[5], box.addr[4], box.addr[3], box.addr[2], box.addr[1], box.addr[0],
+                         box.rssi_min, box.rssi_sum / (int64_t)box.rssi_count, box.rssi_max, box.rssi_count);
             }
+            ESP_LOGI(TAG, "Node %d admission: %" PRIu32 " accepted, %" PRIu32 " rate-limited, %" PRIu32 " coalesced, %" PRIu32 " queue full, %" PRIu32 " evicted",
+                     box.node_id, box.changes, box.drops[ADMIT_DROP_RATE], box.drops[ADMIT_DROP_COALESCED],
+                     box.drops[ADMIT_DROP_QUEUE_FULL], box.drops[ADMIT_DROP_EVICTED]);
+        }
 
-            // --- Perform SD Card Logging ---
-            if (!g_sd_card_mounted || !g_sntp_initialized) {
-                ESP_LOGW(TAG, "Skipping log write: SD mounted: %d, Time synced: %d", g_sd_card_mounted, g_sntp_initialized);
-                continue;
+        const node_seq_stats_t *st = &g_node_seq_stats[i];
+        if (!st->has_seq) continue;
+        char loss[16], dup[16];
+        format_rate(loss, sizeof(loss), st->lost, st->received + st->lost);
+        format_rate(dup, sizeof(dup), st->duplicates, st->received + st->duplicates);
+        ESP_LOGI(TAG, "Node %d seq: %" PRIu32 " received, %" PRIu32 " lost (%s), %" PRIu32 " duplicate (%s), %" PRIu32 " reordered, %" PRIu32 " gaps, %" PRIu32 " restarts",
+                 g_sensor_nodes[i].node_id, st->received, st->lost, loss, st->duplicates, dup, st->reordered, st->gaps, st->restarts);
+    }
+}
+
+static void write_reading_row(FILE *f, const sensor_reading_t *reading, int64_t sample_us, int lost) {
+    // 按接收/采样时刻换算墙钟时间 (毫秒)，不受队列积压影响; 批量读数保留各自的历史时间
+    int64_t sample_wall_us = sample_us + wall_clock_offset_us();
+    time_t sample_time = (time_t)(sample_wall_us / 1000000);
+    struct tm timeinfo = {0};
+    localtime_r(&sample_time, &timeinfo);
+    char time_buf[64];
+    strftime(time_buf, sizeof(time_buf), "%Y-%m-%d %H:%M:%S", &timeinfo);
+
+    // 整数格式化整行，避免浮点 printf
+    char record[96];
+    fixed_fmt_t fmt;
+    if (lost > 0) {
+        // 缺口标记行，以 '#' 开头便于 CSV 工具按注释跳过
+        fixed_fmt_begin(&fmt, record, sizeof(record));
+        fixed_fmt_str(&fmt, "# gap: ");
+        fixed_fmt_uint(&fmt, (uint32_t)lost, 0);
+        fixed_fmt_str(&fmt, " readings lost before seq ");
+        fixed_fmt_uint(&fmt, reading->seq, 0);
+        fixed_fmt_str(&fmt, "\n");
+        fputs(record, f);
+    }
+    fixed_fmt_begin(&fmt, record, sizeof(record));
+    fixed_fmt_str(&fmt, time_buf);
+    fixed_fmt_str(&fmt, ".");
+    fixed_fmt_uint_zero(&fmt, (uint32_t)((sample_wall_us / 1000) % 1000), 3);
+    fixed_fmt_str(&fmt, ",");
+    if (reading->temperature == TEMP_ERROR_VAL) fixed_fmt_str(&fmt, "nan");
+    else fixed_fmt_centi(&fmt, reading->temperature, 0);
+    fixed_fmt_str(&fmt, ",");
+    if (reading->humidity == HUMI_ERROR_VAL) fixed_fmt_str(&fmt, "nan");
+    else fixed_fmt_centi(&fmt, reading->humidity, 0);
+    fixed_fmt_str(&fmt, ",");
+    fixed_fmt_uint(&fmt, reading->illuminance == LUX_ERROR_VAL ? 0 : reading->illuminance, 0);
+    fixed_fmt_str(&fmt, "\n");
+    fputs(record, f);
+
+    if (g_startup.first_logged_us == 0) {
+        startup_mark(&g_startup.first_logged_us);
+        startup_report();
+    }
+}
+
+static FILE *open_node_log(uint8_t node_id) {
+    char filepath[32];
+    snprintf(filepath, sizeof(filepath), SD_CARD_MOUNT_POINT "/node_%d.csv", node_id);
+
+    struct stat st;
+    bool file_exists = (stat(filepath, &st) == 0);
+
+    FILE *f = fopen(filepath, "a");
+    if (f == NULL) {
+        ESP_LOGE(TAG, "Failed to open file for writing: %s", filepath);
+        return NULL;
+    }
+
+    if (!file_exists) {
+        fprintf(f, "Timestamp,Temperature,Humidity,Illuminance\n");
+        ESP_LOGI(TAG, "Created new log file and wrote header: %s", filepath);
+    }
+    return f;
+}
+
+static void pending_log_push(const log_record_t *record) {
+    if (g_pending_count == PENDING_LOG_MAX) {
+        if (g_pending_dropped++ == 0) ESP_LOGW(TAG, "Pending log buffer full, dropping oldest readings");
+        g_pending_head = (g_pending_head + 1) % PENDING_LOG_MAX;
+        g_pending_count--;
+    }
+    g_pending_log[(g_pending_head + g_pending_count) % PENDING_LOG_MAX] = *record;
+    g_pending_count++;
+}
+
+// 时间同步且 SD 就绪后按节点写出缓存的读数，每个节点文件只打开一次并保持时间顺序
+static void pending_log_flush(void) {
+    static bool written[PENDING_LOG_MAX];
+    ESP_LOGI(TAG, "Back-filling %u buffered readings (%" PRIu32 " dropped)", g_pending_count, g_pending_dropped);
+    memset(written, 0, sizeof(written));
+
+    for (uint16_t i = 0; i < g_pending_count; i++) {
+        if (written[i]) continue;
+        uint8_t node_id = g_pending_log[(g_pending_head + i) % PENDING_LOG_MAX].reading.node_id;
+        FILE *f = open_node_log(node_id);
+        for (uint16_t j = i; j < g_pending_count; j++) {
+            const log_record_t *rec = &g_pending_log[(g_pending_head + j) % PENDING_LOG_MAX];
+            if (written[j] || rec->reading.node_id != node_id) continue;
+            written[j] = true;
+            if (f != NULL) write_reading_row(f, &rec->reading, rec->sample_us, rec->lost);
+        }
+        if (f != NULL) fclose(f);
+    }
+    g_pending_head = 0;
+    g_pending_count = 0;
+    g_pending_dropped = 0;
+}
+
+// --- Pipeline Stages ---
+static void stage_stats_backlog(stage_stats_t *st, QueueHandle_t queue) {
+    uint32_t depth = uxQueueMessagesWaiting(queue) + 1;   // 含刚取出的一条
+    if (depth > st->backlog_max) st->backlog_max = depth;
+}
+
+static void stage_stats_busy(stage_stats_t *st, uint32_t count, int64_t busy_us) {
+    st->processed += count;
+    st->busy_us += busy_us;
+    if (busy_us > st->busy_max_us) st->busy_max_us = busy_us;
+}
+
+static void stage_stats_report(const char *name, stage_stats_t *st, QueueHandle_t queue, uint32_t capacity) {
+    ESP_LOGI(TAG, "Stage %s: %" PRIu32 " processed, %" PRIu32 " dropped, backlog %u now / %" PRIu32 " max of %" PRIu32 ", busy %" PRId64 " ms (longest %" PRId64 " us)",
+             name, st->processed, st->dropped, (unsigned)uxQueueMessagesWaiting(queue), st->backlog_max, capacity,
+             st->busy_us / 1000, st->busy_max_us);
+    st->backlog_max = 0;
+    st->busy_us = 0;
+    st->busy_max_us = 0;
+}
+
+// 更新显示用的节点状态与序号统计，读数转交 storage_task; 不做任何 SD 操作
+static void ingest_sensor_batch(const sensor_batch_t *batch, int64_t rx_us) {
+    const sensor_reading_t *newest = &batch->samples[batch->count - 1];
+
+    // Update the global state for OLED display
+    int node_index = sensor_node_index(newest->node_id, true);
+    if (node_index != -1) {
+        uint8_t valid = 0;
+        if (newest->temperature != TEMP_ERROR_VAL) valid |= NODE_VALID_TEMP;
+        if (newest->humidity != HUMI_ERROR_VAL) valid |= NODE_VALID_HUMI;
+        if (newest->illuminance != LUX_ERROR_VAL) valid |= NODE_VALID_LUX;
+
+        g_sensor_nodes[node_index].valid = valid;
+        g_sensor_nodes[node_index].temperature = newest->temperature;
+        g_sensor_nodes[node_index].humidity = newest->humidity;
+        g_sensor_nodes[node_index].illuminance = newest->illuminance;
+        g_sensor_nodes[node_index].last_seen = time(NULL) - (time_t)((esp_timer_get_time() - rx_us) / 1000000);
+    }
+
+    for (uint8_t i = 0; i < batch->count; i++) {
+        log_record_t record = { .reading = batch->samples[i], .sample_us = batch->sample_us[i] };
+        int lost = 0;
+        if (node_index != -1 && record.reading.version >= ADV_PAYLOAD_VERSION_2) {
+            lost = seq_track(&g_node_seq_stats[node_index], record.reading.seq, record.reading.version == ADV_PAYLOAD_VERSION_3);
+            if (lost < 0) continue;
+            if (lost > 0) {
+                ESP_LOGW(TAG, "Node %d: gap of %d readings before seq %u", record.reading.node_id, lost, record.reading.seq);
             }
+        }
+        if (node_index != -1) lost += g_storage_lost[node_index];
+        record.lost = (int16_t)(lost > INT16_MAX ? INT16_MAX : lost);
+        if (xQueueSend(g_storage_queue, &record, 0) != pdTRUE) {
+            if (g_ingest_stats.dropped++ == 0) ESP_LOGW(TAG, "Storage queue full, dropping readings");
+            if (node_index != -1 && g_storage_lost[node_index] < UINT16_MAX) g_storage_lost[node_index]++;
+            continue;
+        }
+        if (node_index != -1) g_storage_lost[node_index] = 0;
+    }
+}
+
+#if PIPELINE_BENCH_ENABLED
+// --- Pipeline Benchmark ---
+// host 任务按 PIPELINE_BENCH_RATE 向邮箱注入合成读数，storage_task 统计送达数与延迟;
+// 被邮箱合并而未送达的读数计为丢弃 (真实射频路径上的丢失见各节点序号统计)
+#define PIPELINE_BENCH_LATENCY_BUCKETS 16   // 第 k 桶: [2^(k-1), 2^k) ms，第 0 桶 < 1 ms
+
+static struct ble_npl_callout g_bench_callout;
+static uint16_t g_bench_seq[PIPELINE_BENCH_NODES];
+static uint32_t g_bench_injected = 0;    // 仅 host 任务写
+static uint32_t g_bench_delivered = 0;   // 以下仅 storage_task 访问
+static uint32_t g_bench_reported_injected = 0;
+static uint32_t g_bench_reported_delivered = 0;
+static uint32_t g_bench_latency_hist[PIPELINE_BENCH_LATENCY_BUCKETS];
+static int64_t g_bench_latency_sum_us = 0;
+static int64_t g_bench_latency_max_us = 0;
+
+static void pipeline_bench_callout(struct ble_npl_event *ev) {
+    ble_addr_t addr = { .type = BLE_ADDR_RANDOM, .val = { 0, 0, 0, 0, 0, 0xC0 } };
+    for (int i = 0; i < PIPELINE_BENCH_RATE * PIPELINE_BENCH_PERIOD_MS / 1000; i++) {
+        uint8_t node = (uint8_t)(g_bench_injected % PIPELINE_BENCH_NODES);
+        adv_sensor_data_v2_t adv = {
+            .manu_id = CUSTOM_MANU_ID,
+            .version = ADV_PAYLOAD_VERSION_2,
+            .node_id = (uint8_t)(PIPELINE_BENCH_NODE_BASE + node),
+            .seq = ++g_bench_seq[node],
+            .temperature = 2000 + node,
+            .humidity = 5000,
+            .illuminance = (uint16_t)g_bench_injected,
+        };
+        addr.val[0] = adv.node_id;
+        mailbox_post(adv.node_id, (const uint8_t *)&adv, sizeof(adv), esp_timer_get_time(), &addr, -40);
+        g_bench_injected++;
+    }
+    ble_npl_callout_reset(&g_bench_callout, ble_npl_time_ms_to_ticks32(PIPELINE_BENCH_PERIOD_MS));
+}
+
+static void pipeline_bench_start(void) {
+    ESP_LOGW(TAG, "Pipeline benchmark: injecting %d adverts/s across %d synthetic nodes", PIPELINE_BENCH_RATE, PIPELINE_BENCH_NODES);
+    ble_npl_callout_init(&g_bench_callout, nimble_port_get_dflt_eventq(), pipeline_bench_callout, NULL);
+    ble_npl_callout_reset(&g_bench_callout, ble_npl_time_ms_to_ticks32(PIPELINE_BENCH_PERIOD_MS));
+}
+
+// 在读数写入 (或进入待写缓存) 后调用; 合成读数的采样时刻即接收时刻
+static void pipeline_bench_record(const log_record_t *record) {
+    int64_t latency_us = esp_timer_get_time() - record->sample_us;
+    uint32_t latency_ms = (uint32_t)(latency_us / 1000);
+    int bucket = latency_ms ? 32 - __builtin_clz(latency_ms) : 0;
+    if (bucket >= PIPELINE_BENCH_LATENCY_BUCKETS) bucket = PIPELINE_BENCH_LATENCY_BUCKETS - 1;
+    g_bench_latency_hist[bucket]++;
+    g_bench_latency_sum_us += latency_us;
+    if (latency_us > g_bench_latency_max_us) g_bench_latency_max_us = latency_us;
+    g_bench_delivered++;
+}
+
+// 返回包含第 permille 千分位的分桶上限 (ms)
+static uint32_t pipeline_bench_percentile_ms(uint32_t total, uint32_t permille) {
+    uint32_t target = (uint32_t)(((uint64_t)total * permille + 999) / 1000);
+    uint32_t seen = 0;
+    for (int k = 0; k < PIPELINE_BENCH_LATENCY_BUCKETS; k++) {
+        seen += g_bench_latency_hist[k];
+        if (seen >= target) return 1u << k;
+    }
+    return 1u << (PIPELINE_BENCH_LATENCY_BUCKETS - 1);
+}
+
+static void pipeline_bench_report(void) {
+    uint32_t injected = __atomic_load_n(&g_bench_injected, __ATOMIC_RELAXED);
+    uint32_t window_injected = injected - g_bench_reported_injected;
+    uint32_t window_delivered = g_bench_delivered - g_bench_reported_delivered;
+    // 窗口边界处仍在邮箱中的读数会在下一窗口送达，差值可能为负
+    uint32_t window_dropped = window_injected > window_delivered ? window_injected - window_delivered : 0;
+    uint32_t samples = 0;
+    for (int k = 0; k < PIPELINE_BENCH_LATENCY_BUCKETS; k++) samples += g_bench_latency_hist[k];
+
+    char drop[16];
+    format_rate(drop, sizeof(drop), window_dropped, window_injected);
+    ESP_LOGI(TAG, "Bench: %" PRIu32 " injected, %" PRIu32 " delivered, %" PRIu32 " dropped (%s); latency avg %" PRId64 " us, p50 < %" PRIu32 " ms, p99 < %" PRIu32 " ms, max %" PRId64 " us",
+             window_injected, window_delivered, window_dropped, drop,
+             samples ? g_bench_latency_sum_us / samples : 0,
+             pipeline_bench_percentile_ms(samples, 500), pipeline_bench_percentile_ms(samples, 990),
+             g_bench_latency_max_us);
 
-            char filepath[32];
-            snprintf(filepath, sizeof(filepath), SD_CARD_MOUNT_POINT "/node_%d.csv", received_data.node_id);
+    g_bench_reported_injected = injected;
+    g_bench_reported_delivered = g_bench_delivered;
+    memset(g_bench_latency_hist, 0, sizeof(g_bench_latency_hist));
+    g_bench_latency_sum_us = 0;
+    g_bench_latency_max_us = 0;
+}
+#endif
 
-            struct stat st;
-            bool file_exists = (stat(filepath, &st) == 0);
+static void ingest_task(void *pvParameters) {
+    static node_mailbox_msg_t msg;
+    sensor_batch_t batch;
+    int64_t next_report_us = esp_timer_get_time() + (int64_t)NODE_STATS_REPORT_S * 1000000;
+    int64_t next_stats_us = esp_timer_get_time() + (int64_t)STAGE_STATS_REPORT_S * 1000000;
 
-            FILE *f = fopen(filepath, "a");
-            if (f == NULL) {
-                ESP_LOGE(TAG, "Failed to open file for writing: %s", filepath);
+    while (1) {
+        refresh_last_seen();
+        if (esp_timer_get_time() >= next_report_us) {
+            next_report_us += (int64_t)NODE_STATS_REPORT_S * 1000000;
+            node_stats_report();
+        }
+        if (esp_timer_get_time() >= next_stats_us) {
+            next_stats_us += (int64_t)STAGE_STATS_REPORT_S * 1000000;
+            stage_stats_report("ingest", &g_ingest_stats, g_ingest_queue, INGEST_QUEUE_LEN);
+        }
+        // OVERLOAD_COALESCE 时队列只传槽位，从邮箱读出最新数值
+        if (node_mailbox_receive(&g_ingest_channel, &msg, 1000)) {
+            int64_t start_us = esp_timer_get_time();
+            stage_stats_backlog(&g_ingest_stats, g_ingest_queue);
+            if (!decode_sensor_payload(msg.payload, msg.len, msg.data_rx_us, &batch)) {
+                ESP_LOGW(TAG, "Node %d: malformed payload (%d bytes)", g_mailbox.box[msg.slot].node_id, msg.len);
                 continue;
             }
+            ingest_sensor_batch(&batch, msg.rx_us);
+            stage_stats_busy(&g_ingest_stats, 1, esp_timer_get_time() - start_us);
+        }
+    }
+}
 
-            if (!file_exists) {
-                fprintf(f, "Timestamp,Temperature,Humidity,Illuminance\n");
-                ESP_LOGI(TAG, "Created new log file and wrote header: %s", filepath);
-            }
+static void storage_task(void *pvParameters) {
+    log_record_t record;
+    int64_t next_stats_us = esp_timer_get_time() + (int64_t)STAGE_STATS_REPORT_S * 1000000;
+#if PIPELINE_BENCH_ENABLED
+    int64_t next_bench_us = esp_timer_get_time() + (int64_t)PIPELINE_BENCH_REPORT_S * 1000000;
+#endif
 
-            time_t now = time(NULL);
-            struct tm timeinfo = {0};
-            localtime_r(&now, &timeinfo);
-            char time_buf[64];
-            strftime(time_buf, sizeof(time_buf), "%Y-%m-%d %H:%M:%S", &timeinfo);
-
-            fprintf(f, "%s,%.2f,%.2f,%u\n",
-                    time_buf,
-                    g_sensor_nodes[node_index].temperature,
-                    g_sensor_nodes[node_index].humidity,
-                    g_sensor_nodes[node_index].illuminance == LUX_ERROR_VAL ? 0 : g_sensor_nodes[node_index].illuminance);
-            
-            fclose(f);
+    while (1) {
+        if (esp_timer_get_time() >= next_stats_us) {
+            next_stats_us += (int64_t)STAGE_STATS_REPORT_S * 1000000;
+            stage_stats_report("storage", &g_storage_stats, g_storage_queue, STORAGE_QUEUE_LEN);
+            if (g_pending_count > 0) ESP_LOGI(TAG, "Stage storage: %u readings waiting for SD card / time sync", g_pending_count);
         }
+#if PIPELINE_BENCH_ENABLED
+        if (esp_timer_get_time() >= next_bench_us) {
+            next_bench_us += (int64_t)PIPELINE_BENCH_REPORT_S * 1000000;
+            pipeline_bench_report();
+        }
+#endif
+        // SD 未就绪或尚未对时则缓存，之后按单调时钟回填墙钟时间
+        bool can_log = g_sd_card_mounted && g_sntp_initialized;
+        if (can_log && g_pending_count > 0) pending_log_flush();
+        if (!xQueueReceive(g_storage_queue, &record, pdMS_TO_TICKS(1000))) continue;
+
+        // 一次取空当前积压 (至多一个队列长度)，同一节点的连续记录共用一次文件打开
+        int64_t start_us = esp_timer_get_time();
+        stage_stats_backlog(&g_storage_stats, g_storage_queue);
+        FILE *f = NULL;
+        uint8_t f_node_id = 0;
+        uint32_t count = 0;
+        do {
+            count++;
+            if (!can_log) {
+                pending_log_push(&record);
+            } else {
+                if (f != NULL && f_node_id != record.reading.node_id) {
+                    fclose(f);
+                    f = NULL;
+                }
+                if (f == NULL) {
+                    f = open_node_log(record.reading.node_id);
+                    f_node_id = record.reading.node_id;
+                }
+                if (f != NULL) write_reading_row(f, &record.reading, record.sample_us, record.lost);
+                else g_storage_stats.dropped++;
+            }
+#if PIPELINE_BENCH_ENABLED
+            if (record.reading.node_id >= PIPELINE_BENCH_NODE_BASE) pipeline_bench_record(&record);
+#endif
+        } while (count < STORAGE_QUEUE_LEN && xQueueReceive(g_storage_queue, &record, 0));
+        if (f != NULL) fclose(f);
+        stage_stats_busy(&g_storage_stats, count, esp_timer_get_time() - start_us);
     }
 }
 
@@ -410,16 +1437,34 @@ static void logging_task(void *pvParameters) {
 void app_main(void) {
     ESP_ERROR_CHECK(nvs_flash_init());
     
-    g_logging_queue = xQueueCreate(10, sizeof(adv_sensor_data_t));
+    node_mailbox_init(&g_mailbox, NODE_ADMIT_RATE_PER_MIN, NODE_ADMIT_BURST, mailbox_same_payload);
+    g_ingest_queue = xQueueCreate(INGEST_QUEUE_LEN, node_mailbox_item_size(OVERLOAD_POLICY));
+    const node_mailbox_queue_t ingest_queue = { g_ingest_queue, ingest_queue_send, ingest_queue_receive };
+    node_mailbox_channel_init(&g_ingest_channel, &g_mailbox, OVERLOAD_POLICY, &ingest_queue);
+    g_storage_queue = xQueueCreate(STORAGE_QUEUE_LEN, sizeof(log_record_t));
 
     oled_init();
+#if DISPLAY_CAPTURE_ENABLED
+    capture_init();
+#endif
     sd_card_init();
     wifi_init();
 
     nimble_port_init();
     ble_hs_cfg.sync_cb = ble_central_on_sync;
-    nimble_port_freertos_init(ble_host_task);
+    xTaskCreatePinnedToCore(ble_host_task, "nimble_host", BLE_HOST_TASK_STACK, NULL, BLE_HOST_TASK_PRIO, NULL, BLE_HOST_TASK_CORE);
 
-    xTaskCreate(display_task, "display_task", 4096, NULL, 5, NULL);
-    xTaskCreate(logging_task, "logging_task", 4096, NULL, 4, NULL);
+    xTaskCreatePinnedToCore(display_task, "display_task", DISPLAY_TASK_STACK, NULL, DISPLAY_TASK_PRIO, NULL, DISPLAY_TASK_CORE);
+    xTaskCreatePinnedToCore(ingest_task, "ingest_task", INGEST_TASK_STACK, NULL, INGEST_TASK_PRIO, NULL, INGEST_TASK_CORE);
+    xTaskCreatePinnedToCore(storage_task, "storage_task", STORAGE_TASK_STACK, NULL, STORAGE_TASK_PRIO, NULL, STORAGE_TASK_CORE);
+#if DISPLAY_CAPTURE_ENABLED
+    xTaskCreatePinnedToCore(capture_task, "capture_task", CAPTURE_TASK_STACK, NULL, CAPTURE_TASK_PRIO, NULL, CAPTURE_TASK_CORE);
+#endif
+    ESP_LOGI(TAG, "Tasks: host core %d prio %d, ingest core %d prio %d, storage core %d prio %d, display core %d prio %d; "
+             "NimBLE msys %dx%d + %dx%d, HCI events %d (+%d discardable)",
+             BLE_HOST_TASK_CORE, BLE_HOST_TASK_PRIO, INGEST_TASK_CORE, INGEST_TASK_PRIO, STORAGE_TASK_CORE, STORAGE_TASK_PRIO,
+             DISPLAY_TASK_CORE, DISPLAY_TASK_PRIO,
+             CONFIG_BT_NIMBLE_MSYS_1_BLOCK_COUNT, CONFIG_BT_NIMBLE_MSYS_1_BLOCK_SIZE,
+             CONFIG_BT_NIMBLE_MSYS_2_BLOCK_COUNT, CONFIG_BT_NIMBLE_MSYS_2_BLOCK_SIZE,
+             CONFIG_BT_NIMBLE_TRANSPORT_EVT_COUNT, CONFIG_BT_NIMBLE_TRANSPORT_EVT_DISCARD_COUNT);
 }
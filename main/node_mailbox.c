@@ -0,0 +1,200 @@
+/**
+ * @file node_mailbox.c
+ * @brief Latest-value mailbox per sensor node with per-node admission.
+ */
+#include "node_mailbox.h"
+
+#include <string.h>
+
+static bool node_mailbox_same_payload(const node_mailbox_table_t *table, const node_mailbox_t *box,
+                                      const uint8_t *payload, uint8_t len) {
+    if (box->len != len) return false;
+    if (table->same) return table->same(box->payload, payload, len);
+    return memcmp(box->payload, payload, len) == 0;
+}
+
+// 令牌按经过的毫秒数 × 速率补充，避免除法; 新节点以满桶开始
+static bool node_mailbox_admit(const node_mailbox_table_t *table, node_mailbox_t *box, int64_t now_us) {
+    const uint32_t full = (uint32_t)table->burst * NODE_MAILBOX_TOKEN;
+    if (table->rate_per_min == 0) return true;
+    int64_t elapsed_ms = (now_us - box->bucket_us) / 1000;
+    if (elapsed_ms > 0) {
+        box->bucket_us += elapsed_ms * 1000;
+        int64_t tokens = box->tokens + elapsed_ms * table->rate_per_min;
+        box->tokens = tokens > (int64_t)full ? full : (uint32_t)tokens;
+    }
+    if (box->tokens < NODE_MAILBOX_TOKEN) return false;
+    box->tokens -= NODE_MAILBOX_TOKEN;
+    return true;
+}
+
+void node_mailbox_init(node_mailbox_table_t *table, uint32_t rate_per_min, uint8_t burst, node_mailbox_same_fn_t same) {
+    memset(table, 0, sizeof(*table));
+    table->rate_per_min = rate_per_min;
+    table->burst = burst;
+    table->same = same;
+}
+
+node_mailbox_result_t node_mailbox_post(node_mailbox_table_t *table, uint8_t node_id, const uint8_t *payload, uint8_t len,
+                                        int64_t rx_us, const uint8_t addr[6], int8_t rssi, uint8_t *slot) {
+    int found = -1;
+    for (int i = 0; i < table->count; i++) {
+        if (table->box[i].node_id == node_id) {
+            found = i;
+            break;
+        }
+    }
+    bool changed = true;
+    if (found == -1) {
+        if (table->count >= NODE_MAILBOX_MAX_NODES) {
+            table->overflow++;
+            return NODE_MAILBOX_OVERFLOW;
+        }
+        found = table->count;
+        node_mailbox_t *fresh = &table->box[found];
+        memset(fresh, 0, sizeof(*fresh));
+        fresh->node_id = node_id;
+        fresh->rssi_min = INT8_MAX;
+        fresh->rssi_max = INT8_MIN;
+        fresh->tokens = (uint32_t)table->burst * NODE_MAILBOX_TOKEN;
+        fresh->bucket_us = rx_us;
+    } else {
+        changed = !node_mailbox_same_payload(table, &table->box[found], payload, len);
+    }
+    // 拒绝的数值不写入邮箱，节点重发时再次尝试准入
+    node_mailbox_t *box = &table->box[found];
+    bool rejected = changed && !node_mailbox_admit(table, box, rx_us);
+    if (rejected) changed = false;
+
+    __atomic_store_n(&box->seq, box->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    box->rx_us = rx_us;
+    memcpy(box->addr, addr, sizeof(box->addr));
+    box->rssi = rssi;
+    if (rssi != NODE_MAILBOX_RSSI_UNAVAIL) {
+        if (rssi < box->rssi_min) box->rssi_min = rssi;
+        if (rssi > box->rssi_max) box->rssi_max = rssi;
+        box->rssi_sum += rssi;
+        box->rssi_count++;
+    }
+    if (changed) {
+        memcpy(box->payload, payload, len);
+        box->len = len;
+        box->data_rx_us = rx_us;
+        box->changes++;
+    }
+    __atomic_store_n(&box->seq, box->seq + 1, __ATOMIC_RELEASE);
+
+    if (found == table->count) __atomic_store_n(&table->count, (uint8_t)(found + 1), __ATOMIC_RELEASE);
+
+    *slot = (uint8_t)found;
+    if (rejected) {
+        box->drops[ADMIT_DROP_RATE]++;
+        return NODE_MAILBOX_RATE_LIMITED;
+    }
+    if (!changed) {
+        table->duplicates++;
+        return NODE_MAILBOX_DUPLICATE;
+    }
+    return NODE_MAILBOX_NEW;
+}
+
+uint8_t node_mailbox_count(const node_mailbox_table_t *table) {
+    return __atomic_load_n(&table->count, __ATOMIC_ACQUIRE);
+}
+
+int node_mailbox_find(const node_mailbox_table_t *table, uint8_t node_id) {
+    uint8_t count = node_mailbox_count(table);
+    for (uint8_t slot = 0; slot < count; slot++) {
+        if (table->box[slot].node_id == node_id) return slot;   // 槽位发布后不再改变
+    }
+    return -1;
+}
+
+// 读者遇到写入中或前后序号不一致即重试
+void node_mailbox_read(const node_mailbox_table_t *table, uint8_t slot, node_mailbox_t *copy) {
+    const node_mailbox_t *box = &table->box[slot];
+    uint32_t begin, end;
+    do {
+        begin = __atomic_load_n(&box->seq, __ATOMIC_ACQUIRE);
+        *copy = *box;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        end = __atomic_load_n(&box->seq, __ATOMIC_RELAXED);
+    } while ((begin & 1) || begin != end);
+}
+
+int64_t node_mailbox_rx_us(const node_mailbox_table_t *table, uint8_t slot) {
+    const node_mailbox_t *box = &table->box[slot];
+    uint32_t begin, end;
+    int64_t rx_us;
+    do {
+        begin = __atomic_load_n(&box->seq, __ATOMIC_ACQUIRE);
+        rx_us = box->rx_us;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        end = __atomic_load_n(&box->seq, __ATOMIC_RELAXED);
+    } while ((begin & 1) || begin != end);
+    return rx_us;
+}
+
+size_t node_mailbox_item_size(node_mailbox_policy_t policy) {
+    return policy == NODE_MAILBOX_COALESCE ? sizeof(uint8_t) : sizeof(node_mailbox_msg_t);
+}
+
+void node_mailbox_channel_init(node_mailbox_channel_t *channel, node_mailbox_table_t *table,
+                               node_mailbox_policy_t policy, const node_mailbox_queue_t *queue) {
+    memset(channel, 0, sizeof(*channel));
+    channel->table = table;
+    channel->policy = policy;
+    channel->queue = *queue;
+}
+
+static void node_mailbox_msg_fill(node_mailbox_msg_t *msg, uint8_t slot, const node_mailbox_t *box) {
+    msg->slot = slot;
+    msg->len = box->len;
+    msg->rx_us = box->rx_us;
+    msg->data_rx_us = box->data_rx_us;
+    memcpy(msg->payload, box->payload, box->len);
+}
+
+void node_mailbox_deliver(node_mailbox_channel_t *channel, uint8_t slot) {
+    node_mailbox_t *box = &channel->table->box[slot];
+    const node_mailbox_queue_t *queue = &channel->queue;
+
+    if (channel->policy == NODE_MAILBOX_COALESCE) {
+        // 槽位已在队列中: 消费者取出时读到的就是最新数值
+        if (__atomic_exchange_n(&box->pending, true, __ATOMIC_ACQ_REL)) {
+            box->drops[ADMIT_DROP_COALESCED]++;
+            return;
+        }
+        queue->send(queue->queue, &slot);
+        return;
+    }
+
+    node_mailbox_msg_fill(&channel->send_msg, slot, box);
+    if (queue->send(queue->queue, &channel->send_msg)) return;
+    if (channel->policy == NODE_MAILBOX_DROP_OLDEST && queue->receive(queue->queue, &channel->evicted, 0)) {
+        channel->table->box[channel->evicted.slot].drops[ADMIT_DROP_EVICTED]++;
+        if (queue->send(queue->queue, &channel->send_msg)) return;
+    }
+    box->drops[ADMIT_DROP_QUEUE_FULL]++;
+}
+
+bool node_mailbox_receive(node_mailbox_channel_t *channel, node_mailbox_msg_t *msg, uint32_t timeout_ms) {
+    const node_mailbox_queue_t *queue = &channel->queue;
+
+    if (channel->policy != NODE_MAILBOX_COALESCE) return queue->receive(queue->queue, msg, timeout_ms);
+
+    uint8_t slot;
+    while (queue->receive(queue->queue, &slot, timeout_ms)) {
+        timeout_ms = 0;
+        // 先清除 pending，之后的新数值会重新投递
+        __atomic_store_n(&channel->table->box[slot].pending, false, __ATOMIC_RELEASE);
+        node_mailbox_read(channel->table, slot, &channel->read_box);
+        // 清除 pending 与读取之间到达的数值已在本次读出，其重新投递的槽位不再重复处理
+        if (channel->read_box.changes == channel->consumed[slot]) continue;
+        channel->consumed[slot] = channel->read_box.changes;
+        node_mailbox_msg_fill(msg, slot, &channel->read_box);
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file node_mailbox.h
+ * @brief Latest-value mailbox per sensor node with per-node admission.
+ *
+ * The scan callback posts every advert payload of a node into that node's
+ * mailbox.  A repeated payload only refreshes the receive time and link
+ * statistics; a changed payload must take a token from the node's bucket
+ * before it is stored, so a chatty node uses up only its own budget.  The
+ * mailbox has a single writer and is read through a sequence lock from
+ * another core.  Time is passed in by the caller (microseconds), so the
+ * admission logic runs unchanged against a virtual clock.
+ *
+ * Admitted values reach the consumer through a channel over a queue the
+ * caller provides (a FreeRTOS queue on the target, a ring buffer on the
+ * host).  The overload policy decides whether the queue carries slot indices
+ * of coalesced mailboxes or payload copies.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NODE_MAILBOX_MAX_NODES      36
+#define NODE_MAILBOX_PAYLOAD_MAX    92          // v3 批量负载上限 (ADV_PAYLOAD_MAX)
+#define NODE_MAILBOX_RSSI_UNAVAIL   INT8_MAX    // 同 BLE_HS_ADV_RSSI_UNAVAIL，不计入 RSSI 统计
+#define NODE_MAILBOX_TOKEN          60000       // 一个令牌 = 60000 单位，按毫秒 × 每分钟速率补充
+
+// 准入被拒或已准入数值未被处理的原因
+typedef enum {
+    ADMIT_DROP_RATE = 0,        // 超出节点令牌桶
+    ADMIT_DROP_COALESCED,       // 未读数值被同节点新数值覆盖 (OVERLOAD_COALESCE)
+    ADMIT_DROP_QUEUE_FULL,      // 队列满丢弃新数值
+    ADMIT_DROP_EVICTED,         // 队列满时被淘汰的最旧数值 (OVERLOAD_DROP_OLDEST)
+    ADMIT_DROP_REASON_COUNT,
+} admit_drop_reason_t;
+
+// 一次投递的结果
+typedef enum {
+    NODE_MAILBOX_NEW = 0,       // 数值变化且通过准入，应交给消费者
+    NODE_MAILBOX_DUPLICATE,     // 与邮箱中数值相同，只刷新接收时间
+    NODE_MAILBOX_RATE_LIMITED,  // 数值变化但令牌不足，未写入邮箱
+    NODE_MAILBOX_OVERFLOW,      // 节点数已满，广播被丢弃
+} node_mailbox_result_t;
+
+// 每个节点一个最新值邮箱: 扫描回调覆盖写入，重复广播只刷新接收时间;
+// 数值变化且通过准入时才投递，重复广播不会填满队列
+typedef struct {
+    uint32_t seq;                       // 顺序锁计数，奇数表示正在写入
+    uint32_t changes;                   // 准入的数值变化次数
+    uint8_t  node_id;
+    uint8_t  len;
+    uint8_t  payload[NODE_MAILBOX_PAYLOAD_MAX]; // 原始厂商数据，由消费者解码
+    int64_t  data_rx_us;                // 当前负载首次收到的时间
+    int64_t  rx_us;                     // 最近一次接收时间 (含重复广播)
+    uint8_t  addr[6];                   // 广播者地址，低字节在前
+    int8_t   rssi;                      // 最近一次接收的 RSSI (dBm)
+    int8_t   rssi_min;
+    int8_t   rssi_max;
+    int64_t  rssi_sum;                  // 所有接收 (含重复广播) 的 RSSI 累计，用于平均值
+    uint32_t rssi_count;
+    bool     pending;                   // 槽位索引已入队，尚未被消费 (由投递方维护)
+    uint32_t tokens;                    // 令牌桶，单位 1/NODE_MAILBOX_TOKEN 令牌
+    int64_t  bucket_us;                 // 上次补充令牌的时间
+    uint32_t drops[ADMIT_DROP_REASON_COUNT];
+} node_mailbox_t;
+
+/**
+ * Compares a stored payload with a new one of the same length @p len, true
+ * when they carry the same value.  Lets the caller ignore fields that change
+ * on every transmission.
+ */
+typedef bool (*node_mailbox_same_fn_t)(const uint8_t *stored, const uint8_t *payload, uint8_t len);
+
+typedef struct {
+    node_mailbox_t box[NODE_MAILBOX_MAX_NODES];
+    uint8_t  count;                     // 已发布的槽位数，仅由写者增加
+    uint32_t duplicates;                // 被合并的重复广播
+    uint32_t overflow;                  // 节点数超出 NODE_MAILBOX_MAX_NODES 被丢弃的广播
+    uint32_t rate_per_min;              // 每节点令牌补充速率 (数值变化/分钟)，0 表示不限速
+    uint8_t  burst;                     // 令牌桶容量，新节点以满桶开始
+    node_mailbox_same_fn_t same;        // NULL: 逐字节比较
+} node_mailbox_table_t;
+
+/** Empties the table and sets the admission budget of every node. */
+void node_mailbox_init(node_mailbox_table_t *table, uint32_t rate_per_min, uint8_t burst, node_mailbox_same_fn_t same);
+
+/**
+ * Posts a payload of @p node_id received at @p rx_us; single writer only.
+ * @p len must not exceed NODE_MAILBOX_PAYLOAD_MAX.
+ *
+ * Returns NODE_MAILBOX_NEW when the value changed and was admitted, in which
+ * case @p slot holds the node's slot for delivery to the consumer.  @p slot is
+ * set for every result except NODE_MAILBOX_OVERFLOW.
+ */
+node_mailbox_result_t node_mailbox_post(node_mailbox_table_t *table, uint8_t node_id, const uint8_t *payload, uint8_t len,
+                                        int64_t rx_us, const uint8_t addr[6], int8_t rssi, uint8_t *slot);
+
+/** Number of published slots, safe to call from any core. */
+uint8_t node_mailbox_count(const node_mailbox_table_t *table);
+
+/** Slot of @p node_id, or -1 when the node has not been seen. */
+int node_mailbox_find(const node_mailbox_table_t *table, uint8_t node_id);
+
+/** Copies a consistent snapshot of @p slot, retrying while the writer is active. */
+void node_mailbox_read(const node_mailbox_table_t *table, uint8_t slot, node_mailbox_t *copy);
+
+/** Reads only the latest receive time of @p slot. */
+int64_t node_mailbox_rx_us(const node_mailbox_table_t *table, uint8_t slot);
+
+// --- Delivery channel ---
+// 准入数值交给消费者的方式，对应 main.c 的 OVERLOAD_POLICY
+typedef enum {
+    NODE_MAILBOX_COALESCE = 0,  // 每节点只保留最新未读数值，队列传槽位，每节点至多一项
+    NODE_MAILBOX_DROP_NEWEST,   // 队列传负载副本，满时丢弃新到数值
+    NODE_MAILBOX_DROP_OLDEST,   // 队列传负载副本，满时淘汰最旧数值
+} node_mailbox_policy_t;
+
+// 交给消费者的数值
+typedef struct {
+    uint8_t  slot;
+    uint8_t  len;
+    int64_t  rx_us;
+    int64_t  data_rx_us;
+    uint8_t  payload[NODE_MAILBOX_PAYLOAD_MAX];
+} node_mailbox_msg_t;
+
+// 调用方提供的队列，元素大小为 node_mailbox_item_size(policy)
+typedef struct {
+    void *queue;
+    bool (*send)(void *queue, const void *item);                        // 不等待，队列满返回 false
+    bool (*receive)(void *queue, void *item, uint32_t timeout_ms);      // 超时返回 false
+} node_mailbox_queue_t;
+
+typedef struct {
+    node_mailbox_table_t *table;
+    node_mailbox_policy_t policy;
+    node_mailbox_queue_t  queue;
+    node_mailbox_msg_t    send_msg;     // 以下两项仅投递方使用，放在此处以节省任务栈
+    node_mailbox_msg_t    evicted;
+    node_mailbox_t        read_box;     // 以下两项仅消费者使用
+    uint32_t              consumed[NODE_MAILBOX_MAX_NODES];   // 每个槽位最后处理的 changes
+} node_mailbox_channel_t;
+
+/** Size of one queue element under @p policy: a slot index or a node_mailbox_msg_t. */
+size_t node_mailbox_item_size(node_mailbox_policy_t policy);
+
+/** Connects @p table to a consumer through @p queue under @p policy. */
+void node_mailbox_channel_init(node_mailbox_channel_t *channel, node_mailbox_table_t *table,
+                               node_mailbox_policy_t policy, const node_mailbox_queue_t *queue);
+
+/**
+ * Hands the value just admitted to @p slot (NODE_MAILBOX_NEW) to the
+ * consumer; called by the single writer.  Values lost to the policy are
+ * counted in the slot's drops.
+ */
+void node_mailbox_deliver(node_mailbox_channel_t *channel, uint8_t slot);
+
+/**
+ * Takes the next value for the consumer, waiting up to @p timeout_ms for the
+ * first queue element.  A coalesced slot whose value was already taken is
+ * skipped without waiting again.  Returns false when nothing new arrived.
+ */
+bool node_mailbox_receive(node_mailbox_channel_t *channel, node_mailbox_msg_t *msg, uint32_t timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
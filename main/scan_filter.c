@@ -0,0 +1,52 @@
+/**
+ * @file scan_filter.c
+ * @brief Controller accept list built for each scan from the nodes it expects.
+ */
+#include "scan_filter.h"
+
+#include <string.h>
+
+void scan_filter_init(scan_filter_t *filter, uint8_t capacity) {
+    memset(filter, 0, sizeof(*filter));
+    filter->capacity = capacity < SCAN_FILTER_LIST_MAX ? capacity : SCAN_FILTER_LIST_MAX;
+}
+
+bool scan_filter_learn(scan_filter_t *filter, uint8_t node_id, uint8_t addr_type, const uint8_t addr[6]) {
+    int i = 0;
+    while (i < filter->count && filter->node_ids[i] != node_id) i++;
+    if (i == filter->count) {
+        if (filter->count >= SCAN_FILTER_MAX_NODES) return false;
+        filter->count++;
+        filter->node_ids[i] = node_id;
+    } else if (filter->addrs[i].type == addr_type && memcmp(filter->addrs[i].val, addr, 6) == 0) {
+        return false;
+    }
+    filter->addrs[i].type = addr_type;
+    memcpy(filter->addrs[i].val, addr, 6);
+    return true;
+}
+
+bool scan_filter_build(scan_filter_t *filter, const uint8_t *node_ids, uint8_t count, bool *changed) {
+    scan_filter_addr_t list[SCAN_FILTER_LIST_MAX];
+
+    *changed = false;
+    if (count == 0 || count > filter->capacity) {
+        filter->unfiltered++;
+        return false;
+    }
+    for (int n = 0; n < count; n++) {
+        int i = 0;
+        while (i < filter->count && filter->node_ids[i] != node_ids[n]) i++;
+        if (i == filter->count) {
+            filter->unfiltered++;
+            return false;
+        }
+        list[n] = filter->addrs[i];
+    }
+
+    // 顺序相同的列表不重复写入控制器
+    *changed = count != filter->list_count || memcmp(list, filter->list, count * sizeof(list[0])) != 0;
+    memcpy(filter->list, list, count * sizeof(list[0]));
+    filter->list_count = count;
+    return true;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file scan_filter.h
+ * @brief Controller accept list built for each scan from the nodes it expects.
+ *
+ * The controller's accept list is much shorter than the fleet, so the list is
+ * rebuilt for every scan from the nodes the scan window scheduler expects in
+ * it (see scan_sched_step_t).  Node addresses are learned from accepted
+ * adverts.  A scan whose nodes do not fit in the list, or whose addresses are
+ * not all known, runs unfiltered.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SCAN_FILTER_MAX_NODES       36          // 同 SCAN_SCHED_MAX_NODES
+#define SCAN_FILTER_LIST_MAX        15          // CONFIG_BT_NIMBLE_WHITELIST_SIZE 上限
+
+// 与 ble_addr_t 布局相同
+typedef struct {
+    uint8_t type;
+    uint8_t val[6];
+} scan_filter_addr_t;
+
+typedef struct {
+    uint8_t            node_ids[SCAN_FILTER_MAX_NODES];
+    scan_filter_addr_t addrs[SCAN_FILTER_MAX_NODES];
+    uint8_t            count;
+    uint8_t            capacity;                    // 控制器列表容量
+    scan_filter_addr_t list[SCAN_FILTER_LIST_MAX];  // 当前写入控制器的列表
+    uint8_t            list_count;
+    uint32_t           unfiltered;                  // 因列表放不下或地址未知而不过滤的扫描次数
+} scan_filter_t;
+
+/** Forgets all addresses; @p capacity is the controller's list size, at most SCAN_FILTER_LIST_MAX. */
+void scan_filter_init(scan_filter_t *filter, uint8_t capacity);
+
+/** Records the address of @p node_id; returns true when it is new or changed. */
+bool scan_filter_learn(scan_filter_t *filter, uint8_t node_id, uint8_t addr_type, const uint8_t addr[6]);
+
+/**
+ * Builds filter->list from the addresses of @p node_ids.  Returns false and
+ * counts an unfiltered scan when the nodes do not fit or an address is
+ * unknown.  @p changed tells whether the list differs from the one built
+ * before, so the controller is only updated when needed.
+ */
+bool scan_filter_build(scan_filter_t *filter, const uint8_t *node_ids, uint8_t count, bool *changed);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,209 @@
+/**
+ * @file scan_sched.c
+ * @brief Scan window scheduler driven by the learned advertising cadence of each node.
+ */
+#include "scan_sched.h"
+
+#include <string.h>
+
+// 预测 k 个周期后的到达时间所需的保护时间
+static int64_t scan_sched_guard(const scan_sched_node_t *node, int64_t k) {
+    return SCAN_SCHED_GUARD_US + k * (node->period_us >> SCAN_SCHED_DRIFT_SHIFT);
+}
+
+void scan_sched_init(scan_sched_t *sched, int64_t scheduled_us, int64_t discovery_us, uint8_t window_max) {
+    memset(sched, 0, sizeof(*sched));
+    sched->phase = SCAN_SCHED_PHASE_SCHEDULED;   // 第一步切换到发现阶段
+    sched->scheduled_us = scheduled_us;
+    sched->discovery_us = discovery_us;
+    sched->window_max = window_max;
+}
+
+void scan_sched_observe(scan_sched_t *sched, uint8_t node_id, int64_t now_us) {
+    scan_sched_node_t *node = NULL;
+    for (int i = 0; i < sched->count; i++) {
+        if (sched->nodes[i].node_id == node_id) {
+            node = &sched->nodes[i];
+            break;
+        }
+    }
+    if (node == NULL) {
+        if (sched->count >= SCAN_SCHED_MAX_NODES) return;
+        node = &sched->nodes[sched->count++];
+        memset(node, 0, sizeof(*node));
+        node->node_id = node_id;
+        node->last_us = now_us;
+        return;
+    }
+
+    int64_t delta = now_us - node->last_us;
+    if (delta <= 0) return;
+    node->last_us = now_us;
+
+    if (node->period_us == 0) {
+        node->period_us = (uint32_t)delta;
+        node->confidence = 0;
+        return;
+    }
+
+    // 间隔可能跨越若干个错过的广播
+    int64_t k = (delta + node->period_us / 2) / node->period_us;
+    if (k == 0) {
+        // 比估计周期更短: 重新学习
+        node->period_us = (uint32_t)delta;
+        node->confidence = 0;
+        return;
+    }
+
+    int64_t err = delta - k * node->period_us;
+    int64_t tol = scan_sched_guard(node, k);
+    if (err <= tol && err >= -tol) {
+        node->period_us = (uint32_t)(node->period_us + err / (k * 4));  // 1/4 权重平滑
+        if (node->confidence < UINT8_MAX) node->confidence++;
+    } else {
+        node->period_us = (uint32_t)delta;
+        node->confidence = 0;
+    }
+}
+
+// 已锁定节点的下一个合并窗口; *learning 表示仍有节点在学习周期。
+// step 不为 NULL 时填入窗口内的节点与学习中的节点
+static bool scan_sched_window(const scan_sched_t *sched, int64_t now_us, int64_t *start_us, uint32_t *duration_us,
+                              bool *learning, scan_sched_step_t *step) {
+    int64_t win_start[SCAN_SCHED_MAX_NODES];
+    int64_t win_end[SCAN_SCHED_MAX_NODES];
+    uint8_t win_node[SCAN_SCHED_MAX_NODES];
+    int wins = 0;
+
+    if (step != NULL) step->node_count = 0;
+
+    *learning = false;
+    for (int i = 0; i < sched->count; i++) {
+        const scan_sched_node_t *node = &sched->nodes[i];
+        int64_t since = now_us - node->last_us;
+
+        if (node->period_us == 0 || node->confidence < SCAN_SCHED_LOCK_COUNT) {
+            if (since < SCAN_SCHED_LEARN_US) {
+                *learning = true;
+                if (step != NULL) step->node_ids[step->node_count++] = node->node_id;
+            }
+            continue;
+        }
+        int64_t k = since / node->period_us;
+        if (k > SCAN_SCHED_MAX_MISSES) continue;
+        if (k < 1) k = 1;
+        while (node->last_us + k * node->period_us + scan_sched_guard(node, k) <= now_us) k++;
+
+        int64_t predicted = node->last_us + k * node->period_us;
+        int64_t guard = scan_sched_guard(node, k);
+        win_start[wins] = predicted - guard;
+        win_end[wins] = predicted + guard;
+        win_node[wins] = node->node_id;
+        wins++;
+    }
+    if (wins == 0) return false;
+
+    // 取最早的窗口，并合并与之重叠的窗口
+    int64_t start = win_start[0], end = win_end[0];
+    for (int i = 1; i < wins; i++) {
+        if (win_start[i] < start) {
+            start = win_start[i];
+            end = win_end[i];
+        }
+    }
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (int i = 0; i < wins; i++) {
+            if (win_start[i] <= end && win_end[i] > end) {
+                end = win_end[i];
+                merged = true;
+            }
+        }
+    }
+
+    if (step != NULL) {
+        // 窗口按开始时间 (已开始的按结束时间) 加入; 超出 window_max 时，在下一个未加入窗口开始前结束，
+        // 它已开始则在最先结束的已加入窗口结束时结束，剩余节点留给下一次扫描
+        int room = sched->window_max ? sched->window_max - step->node_count : wins;
+        if (room < 1) room = 1;
+        int64_t taken_first_end = INT64_MAX, taken_last_end = start;
+        for (int added = 0; added < wins; added++) {
+            int next = -1;
+            for (int i = 0; i < wins; i++) {
+                if (win_start[i] > end) continue;
+                if (next < 0) {
+                    next = i;
+                    continue;
+                }
+                int64_t si = win_start[i] > now_us ? win_start[i] : now_us;
+                int64_t sn = win_start[next] > now_us ? win_start[next] : now_us;
+                if (si < sn || (si == sn && win_end[i] < win_end[next])) next = i;
+            }
+            if (next < 0) break;
+            if (added == room) {
+                if (win_start[next] > now_us) end = win_start[next] < taken_last_end ? win_start[next] : taken_last_end;
+                else end = taken_first_end;
+                break;
+            }
+            step->node_ids[step->node_count++] = win_node[next];
+            if (win_end[next] < taken_first_end) taken_first_end = win_end[next];
+            if (win_end[next] > taken_last_end) taken_last_end = win_end[next];
+            win_start[next] = INT64_MAX;    // 已加入
+        }
+    }
+
+    if (start < now_us) start = now_us;
+    *start_us = start;
+    *duration_us = (uint32_t)(end - start);
+    return true;
+}
+
+bool scan_sched_next(const scan_sched_t *sched, int64_t now_us, int64_t *start_us, uint32_t *duration_us) {
+    bool learning;
+    return scan_sched_window(sched, now_us, start_us, duration_us, &learning, NULL) && !learning;
+}
+
+bool scan_sched_step(scan_sched_t *sched, int64_t now_us, scan_sched_step_t *step) {
+    bool new_phase = now_us >= sched->phase_end_us;
+    if (new_phase) {
+        if (sched->phase == SCAN_SCHED_PHASE_SCHEDULED) {
+            sched->phase = SCAN_SCHED_PHASE_DISCOVERY;
+            sched->phase_end_us = now_us + sched->discovery_us;
+        } else {
+            sched->phase = SCAN_SCHED_PHASE_SCHEDULED;
+            sched->phase_end_us = now_us + sched->scheduled_us;
+        }
+    }
+
+    int64_t start_us;
+    uint32_t duration_us;
+    bool learning;
+    bool found = scan_sched_window(sched, now_us, &start_us, &duration_us, &learning, step);
+    step->scan = true;
+    step->full_duty = false;
+    step->end_us = sched->phase_end_us;
+    if (sched->phase == SCAN_SCHED_PHASE_SCHEDULED) {
+        if (found && !learning && start_us > now_us) {
+            // 全部节点已锁定: 到下一个预测窗口前关闭射频
+            step->scan = false;
+            step->node_count = 0;
+            if (start_us < step->end_us) step->end_us = start_us;
+            return new_phase;
+        }
+        // 仍有节点在学习周期或没有可预测的节点: 连续扫描，每个发现阶段长度后重新评估
+        if (now_us + sched->discovery_us < step->end_us) step->end_us = now_us + sched->discovery_us;
+    }
+
+    if (found && start_us < now_us + SCAN_SCHED_MIN_SCAN_US) {
+        // 预测窗口很短，使用 100% 占空比; 连续扫描中也为已锁定节点切换到预测窗口
+        step->full_duty = true;
+        if (start_us + duration_us < step->end_us) step->end_us = start_us + duration_us;
+    } else {
+        if (found && start_us < step->end_us) step->end_us = start_us;
+        step->node_count = sched->count;
+        for (int i = 0; i < sched->count; i++) step->node_ids[i] = sched->nodes[i].node_id;
+    }
+    if (step->end_us < now_us + SCAN_SCHED_MIN_SCAN_US) step->end_us = now_us + SCAN_SCHED_MIN_SCAN_US;
+    return new_phase;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file scan_sched.h
+ * @brief Scan window scheduler driven by the learned advertising cadence of each node.
+ *
+ * Every accepted advert is reported with its arrival time.  Once a node's period
+ * is confirmed by a few consecutive arrivals, the scheduler predicts its next
+ * advert and opens a scan window around it; overlapping windows of different
+ * nodes are merged.  While any recently seen node is still being learned the
+ * scheduler asks for continuous scanning.  Scheduled phases alternate with
+ * discovery phases of continuous scanning, in which new nodes are found.  Time
+ * is passed in by the caller (microseconds), so the logic runs unchanged
+ * against a virtual clock.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SCAN_SCHED_MAX_NODES        36
+#define SCAN_SCHED_LOCK_COUNT       3           // 连续符合预测的间隔数达到后才按预测调度
+#define SCAN_SCHED_GUARD_US         12000       // 预测到达时间前后的保护时间 (含 advDelay 0~10 ms)
+#define SCAN_SCHED_DRIFT_SHIFT      7           // 每个周期额外放宽 period/128
+#define SCAN_SCHED_MAX_MISSES       8           // 连续错过的周期数超过后不再为其调度
+#define SCAN_SCHED_LEARN_US         60000000LL  // 未锁定节点在此时间内出现过才要求连续扫描
+#define SCAN_SCHED_MIN_SCAN_US      10000       // 单次扫描的最短时间
+
+typedef struct {
+    uint8_t  node_id;
+    uint8_t  confidence;    // 连续符合预测的间隔数
+    uint32_t period_us;     // 0: 未知
+    int64_t  last_us;       // 最近一次到达时间
+} scan_sched_node_t;
+
+// 发现阶段连续扫描以发现新节点; 调度阶段按预测开窗，有节点在学习时连续扫描
+typedef enum {
+    SCAN_SCHED_PHASE_DISCOVERY = 0,
+    SCAN_SCHED_PHASE_SCHEDULED,
+} scan_sched_phase_t;
+
+typedef struct {
+    scan_sched_node_t nodes[SCAN_SCHED_MAX_NODES];
+    uint8_t count;
+    scan_sched_phase_t phase;
+    int64_t phase_end_us;
+    int64_t scheduled_us;   // 调度阶段长度
+    int64_t discovery_us;   // 发现阶段长度，也是调度阶段内连续扫描的最长一段
+    uint8_t window_max;     // 一个预测窗口最多预期的节点数 (控制器过滤列表容量)，0 为不限
+} scan_sched_t;
+
+// 下一步射频动作
+typedef struct {
+    bool    scan;           // false: 射频关闭到 end_us
+    bool    full_duty;      // true: 预测窗口，扫描窗口等于扫描间隔; false: 连续扫描，按常规占空比
+    int64_t end_us;         // 本次扫描结束或下次唤醒的时间
+    uint8_t node_count;     // 本次扫描预期出现的节点，供控制器过滤列表使用
+    uint8_t node_ids[SCAN_SCHED_MAX_NODES];
+} scan_sched_step_t;
+
+/**
+ * Forgets all learned nodes.  Scanning starts with a discovery phase of
+ * @p discovery_us, then scheduled phases of @p scheduled_us and discovery
+ * phases alternate.  A predicted window expects at most @p window_max nodes
+ * (0: no limit); a longer run of merged windows is split into several scans.
+ */
+void scan_sched_init(scan_sched_t *sched, int64_t scheduled_us, int64_t discovery_us, uint8_t window_max);
+
+/** Records an advert of @p node_id received at @p now_us. */
+void scan_sched_observe(scan_sched_t *sched, uint8_t node_id, int64_t now_us);
+
+/**
+ * Computes the next scan window at or after @p now_us.
+ *
+ * Returns false when the radio should scan continuously (a node is still being
+ * learned or no node is locked).  Otherwise @p start_us (>= @p now_us) and
+ * @p duration_us describe the next merged window.
+ */
+bool scan_sched_next(const scan_sched_t *sched, int64_t now_us, int64_t *start_us, uint32_t *duration_us);
+
+/**
+ * Decides what the radio does from @p now_us: a continuous scan, a predicted
+ * window at full duty or an idle gap, each ending at or before the end of the
+ * current phase (scans last at least SCAN_SCHED_MIN_SCAN_US).  Continuous
+ * scans are cut short at the next predicted window of a locked node, so
+ * discovery and learning do not cost locked nodes their adverts.  Called again
+ * when the scan ends or the idle gap is over.
+ *
+ * step->node_ids lists the nodes a scan expects: the nodes of a predicted
+ * window plus the nodes still being learned, or every known node for a
+ * continuous scan.
+ *
+ * Returns true when a new phase starts with this step; sched->phase tells
+ * which one.
+ */
+bool scan_sched_step(scan_sched_t *sched, int64_t now_us, scan_sched_step_t *step);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,26 @@
+/**
+ * @file sensor_payload.c
+ * @brief Advert payload formats of the sensor nodes and the scan callback's fast path.
+ */
+#include "sensor_payload.h"
+#include "adv_parse.h"
+
+bool sensor_payload_node_id(const uint8_t *mfg, uint8_t len, uint8_t *node_id) {
+    if (len == sizeof(adv_sensor_data_t)) {
+        *node_id = mfg[offsetof(adv_sensor_data_t, node_id)];
+        return true;
+    }
+    if ((len == sizeof(adv_sensor_data_v2_t) && mfg[2] == ADV_PAYLOAD_VERSION_2) ||
+        (len >= ADV_BATCH_HEADER_SIZE && mfg[2] == ADV_PAYLOAD_VERSION_3)) {
+        *node_id = mfg[3];
+        return true;
+    }
+    return false;
+}
+
+const uint8_t *sensor_payload_find(const uint8_t *data, size_t len, uint8_t *mfg_len, uint8_t *node_id) {
+    // 只查找 0xFF 厂商数据，长度或厂商 ID 不符即丢弃
+    const uint8_t *mfg = adv_find_mfg_data(data, len, CUSTOM_MANU_ID, sizeof(adv_sensor_data_t), ADV_PAYLOAD_MAX, mfg_len);
+    if (mfg == NULL || !sensor_payload_node_id(mfg, *mfg_len, node_id)) return NULL;
+    return mfg;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file sensor_payload.h
+ * @brief Advert payload formats of the sensor nodes and the scan callback's fast path.
+ *
+ * Nodes send their readings as manufacturer-specific data under
+ * CUSTOM_MANU_ID.  v1 and v2 are fixed-size legacy payloads told apart by
+ * length; v3 is a batched extended payload.  The fast path only finds the
+ * payload and its node ID, decoding is left to the ingest task.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CUSTOM_MANU_ID       0x02E5
+
+#pragma pack(push, 1)
+typedef struct {
+    uint16_t manu_id;
+    uint8_t  node_id;
+    int16_t  temperature;
+    uint16_t humidity;
+    uint16_t illuminance;
+} adv_sensor_data_t;
+
+// v2: 在 v1 字段基础上增加版本号和每节点序号，按长度与 v1 区分
+#define ADV_PAYLOAD_VERSION_2   2
+typedef struct {
+    uint16_t manu_id;
+    uint8_t  version;       // ADV_PAYLOAD_VERSION_2
+    uint8_t  node_id;
+    uint16_t seq;           // 每个新读数加 1
+    int16_t  temperature;
+    uint16_t humidity;
+    uint16_t illuminance;
+} adv_sensor_data_v2_t;
+#pragma pack(pop)
+
+// v3: 扩展广播批量负载，携带最近 N 个读数 (小端):
+//   [0-1] manu_id  [2] version=3  [3] node_id  [4-5] 最新读数序号  [6] 读数个数 N
+//   [7-8] 最新读数距发送时刻的时间 (0.1 s)  [9-14] 最新读数 temperature/humidity/illuminance
+//   之后 N-1 个较旧读数 (由新到旧，序号依次减 1): [2] 距最新读数的时间 (0.1 s)，
+//   随后三个字段各为相对最新读数的 int8 差值; 差值为 ADV_BATCH_ESCAPE 时后跟 2 字节绝对值
+#define ADV_PAYLOAD_VERSION_3   3
+#define ADV_BATCH_MAX           8
+#define ADV_BATCH_ESCAPE        ((int8_t)-128)
+#define ADV_BATCH_HEADER_SIZE   15
+#define ADV_BATCH_AGE_OFFSET    7
+#define ADV_BATCH_SAMPLE_MAX    11      // 时间偏移 + 三个字段均为绝对值
+#define ADV_PAYLOAD_MAX         (ADV_BATCH_HEADER_SIZE + (ADV_BATCH_MAX - 1) * ADV_BATCH_SAMPLE_MAX)
+
+/** Node ID of a v1, v2 or v3 payload of @p len bytes, false for anything else. */
+bool sensor_payload_node_id(const uint8_t *mfg, uint8_t len, uint8_t *node_id);
+
+/**
+ * Finds a sensor payload in the advertising data and reads its node ID.
+ * Returns the payload (company identifier first, not aligned) and stores its
+ * length in @p mfg_len, or returns NULL when the advert is not from a node.
+ */
+const uint8_t *sensor_payload_find(const uint8_t *data, size_t len, uint8_t *mfg_len, uint8_t *node_id);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""
+Turns OLED captures from the central node into images.
+
+  frames.cap from the SD card, or a serial log holding `CAP:` lines
+      -> animated GIF (requires Pillow)
+  serial log holding `-----BEGIN PBM-----` blocks
+      -> one PBM file per screenshot
+
+Frame stream records: [u32 time ms][u8 flags][u16 length][rle payload], little endian.
+The payload is the page-major frame xor the previous frame, in the same
+literal/repeat runs as ssd1306_set_rle_image.  Flag bit 0 marks a key frame,
+encoded against an all-off frame.
+
+Usage:
+  oled_capture.py frames.cap -o capture.gif [--scale 4]
+  oled_capture.py monitor.log -o capture.gif
+  oled_capture.py monitor.log --pbm shots/
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+MAGIC = b'OLEDCAP1'
+WIDTH, HEIGHT = 128, 64
+
+
+def rle_decode(data, size):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        c = data[i]
+        i += 1
+        count = (c & 0x7F) + 1
+        if c & 0x80:
+            out += bytes([data[i]]) * count
+            i += 1
+        else:
+            out += data[i:i + count]
+            i += count
+    if len(out) != size:
+        raise ValueError('frame decodes to %d bytes, expected %d' % (len(out), size))
+    return out
+
+
+def read_records(path):
+    """Yields raw frame records from a capture file or a serial log."""
+    with open(path, 'rb') as f:
+        raw = f.read()
+    global WIDTH, HEIGHT
+    if raw.startswith(MAGIC):
+        WIDTH, HEIGHT = raw[len(MAGIC)], raw[len(MAGIC) + 1]
+        pos = len(MAGIC) + 2
+        while pos + 7 <= len(raw):
+            length = struct.unpack_from('<H', raw, pos + 5)[0]
+            yield raw[pos:pos + 7 + length]
+            pos += 7 + length
+    else:
+        for m in re.finditer(rb'CAP:([0-9a-f]+)', raw):
+            yield bytes.fromhex(m.group(1).decode())
+
+
+def decode_frames(path):
+    """Yields (time ms, page-major frame) for every recorded frame."""
+    prev = bytearray(WIDTH * HEIGHT // 8)
+    for rec in read_records(path):
+        time_ms, flags, length = struct.unpack_from('<IBH', rec, 0)
+        size = WIDTH * HEIGHT // 8
+        if flags & 0x01:
+            prev = bytearray(size)
+        delta = rle_decode(rec[7:7 + length], size)
+        prev = bytearray(a ^ b for a, b in zip(prev, delta))
+        yield time_ms, bytes(prev)
+
+
+def to_image(pages, scale):
+    from PIL import Image
+    img = Image.new('1', (WIDTH, HEIGHT))
+    px = img.load()
+    for y in range(HEIGHT):
+        for x in range(WIDTH):
+            px[x, y] = 255 if (pages[(y // 8) * WIDTH + x] >> (y % 8)) & 1 else 0
+    if scale > 1:
+        img = img.resize((WIDTH * scale, HEIGHT * scale), Image.NEAREST)
+    return img.convert('P')
+
+
+def write_gif(path, out, scale):
+    frames = list(decode_frames(path))
+    if not frames:
+        raise SystemExit('no frames in %s' % path)
+    images = [to_image(pages, scale) for _, pages in frames]
+    # each frame is shown until the next one was captured, the last for one second
+    durations = [max(20, b[0] - a[0]) for a, b in zip(frames, frames[1:])] + [1000]
+    images[0].save(out, save_all=True, append_images=images[1:], duration=durations, loop=0)
+    print('%s: %d frames' % (out, len(images)))
+
+
+def write_pbms(path, out_dir):
+    with open(path, 'r', errors='replace') as f:
+        text = f.read()
+    os.makedirs(out_dir, exist_ok=True)
+    shots = re.findall(r'-----BEGIN PBM (\d+)-----\n(.*?)-----END PBM-----', text, flags=re.S)
+    for time_ms, body in shots:
+        name = os.path.join(out_dir, 'scr_%s.pbm' % time_ms)
+        with open(name, 'w') as f:
+            f.write(body)
+        print(name)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert OLED captures into GIF or PBM images.')
+    parser.add_argument('input', help='frames.cap or serial log')
+    parser.add_argument('-o', '--output', help='output GIF')
+    parser.add_argument('--scale', type=int, default=4, help='GIF pixel scale')
+    parser.add_argument('--pbm', metavar='DIR', help='extract console screenshots as PBM files into DIR')
+    args = parser.parse_args()
+
+    if args.pbm:
+        write_pbms(args.input, args.pbm)
+    if args.output:
+        write_gif(args.input, args.output, args.scale)
+    if not args.pbm and not args.output:
+        parser.error('give -o and/or --pbm')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())